@@ -1,15 +1,67 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 #include <stdarg.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Streaming (movntdqa) loads for write-combined VRAM reads. Built with a
+// per-function target so the rest of the code doesn't require SSE4.1.
+#if defined(__x86_64__) && !defined(PLATFORM_BAREMETAL)
+#include <smmintrin.h>
+#define HAVE_STREAM_LOAD 1
+#endif
+
 #include "../platform/platform.h"
 
 #include "ati.h"
 #include "cce.h"
 #include "r128.h"
+#include "r128_mc.h"
 #include "r100.h"
+#include "r100_mc.h"
+#include "snapshot.h"
+#include "surface.h"
+#include "trace.h"
+#include "wait.h"
 #include "../tests/test.h"
 
 #define NUM_BARS 8
+#define IO_BAR 1
+// Registers the I/O BAR decodes directly; the rest go through MM_INDEX/DATA
+#define IO_DIRECT_SIZE 0x100
+#define SHADOW_WORDS (REG_APERTURE_SIZE / 4 / 32)
+#define CHUNK_SIZE (64 * 1024)
+
+// Write-only GUI registers whose last host write is kept (see
+// ati_gui_wo_invalidate). Same offsets on the R128, where they're unused.
+enum {
+    GUI_WO_GMC,
+    GUI_WO_DST_PITCH_OFFSET,
+    GUI_WO_SRC_PITCH_OFFSET,
+    GUI_WO_COUNT,
+};
+
+typedef enum {
+    GUI_WO_UNSET,   // Not written since the device was opened
+    GUI_WO_KNOWN,   // gui_wo holds what the register holds
+    GUI_WO_UNKNOWN, // Packets may have written it since
+} gui_wo_state_t;
+
+static const uint32_t gui_wo_regs[GUI_WO_COUNT] = {
+    R100_DP_GUI_MASTER_CNTL,
+    R100_DST_PITCH_OFFSET,
+    R100_SRC_PITCH_OFFSET,
+};
+
+// Widest bulk VRAM transfer the build can emit
+#if defined(__SSE2__)
+#define VRAM_WIDEST ATI_VRAM_SSE
+#elif UINTPTR_MAX > UINT32_MAX
+#define VRAM_WIDEST ATI_VRAM_QWORD
+#else
+#define VRAM_WIDEST ATI_VRAM_DWORD
+#endif
 
 // ============================================================================
 // Chip Detection
@@ -51,275 +103,2161 @@ static const struct {
     { 0, CHIP_UNKNOWN, NULL }
 };
 
-static ati_chip_family_t
-detect_chip_family(uint16_t device_id)
-{
-    for (int i = 0; chip_id_table[i].name != NULL; i++) {
-        if (chip_id_table[i].device_id == device_id) {
-            return chip_id_table[i].family;
+static ati_chip_family_t
+detect_chip_family(uint16_t device_id)
+{
+    for (int i = 0; chip_id_table[i].name != NULL; i++) {
+        if (chip_id_table[i].device_id == device_id) {
+            return chip_id_table[i].family;
+        }
+    }
+    return CHIP_UNKNOWN;
+}
+
+static const char *
+get_chip_name(uint16_t device_id)
+{
+    for (int i = 0; chip_id_table[i].name != NULL; i++) {
+        if (chip_id_table[i].device_id == device_id) {
+            return chip_id_table[i].name;
+        }
+    }
+    return "Unknown ATI Device";
+}
+
+const char *
+ati_chip_family_name(ati_chip_family_t family)
+{
+    switch (family) {
+    case CHIP_R128:
+        return "R128";
+    case CHIP_R100:
+        return "R100";
+    default:
+        return "Unknown";
+    }
+}
+
+// ============================================================================
+// Device Structure
+// ============================================================================
+
+struct ati_device {
+    ati_reg_fast_t regs; // Must come first, see ati_reg_read
+    platform_pci_device_t *pci_dev;
+    ati_chip_family_t family;
+    uint16_t device_id;
+    int index;         // Order of initialisation, from 0
+    char name[256];
+    char location[32]; // PCI bus location
+    const ati_display_mode_t *mode; // Current scanout mode
+    ati_device_props_t props;
+    void *bar[NUM_BARS];
+    bool vram_wc;     // bar[0] is mapped write-combined
+    ati_vram_width_t vram_width; // Widest transfer bulk copies may use
+    // How registers are reached. MM_INDEX is cached while an indexed
+    // backend is in use so polling one register doesn't rewrite it.
+    ati_reg_backend_t reg_backend;
+    bool io_ok; // I/O BAR opened
+    bool mm_index_valid;
+    uint32_t mm_index;
+    // Opt-in shadow cache for FLAG_SHADOW registers. Bitmaps are indexed by
+    // dword offset.
+    bool shadow_enabled;
+    bool shadow_suspended; // CCE running; packets may write the registers
+    uint32_t shadow_ok[SHADOW_WORDS];       // Register has FLAG_SHADOW
+    uint32_t shadow_rd_valid[SHADOW_WORDS]; // shadow_rd holds the HW value
+    uint32_t shadow_wr_valid[SHADOW_WORDS]; // shadow_wr holds the last write
+    uint32_t shadow_rd[REG_APERTURE_SIZE / 4];
+    uint32_t shadow_wr[REG_APERTURE_SIZE / 4];
+    ati_shadow_stats_t shadow_stats;
+    // Staging buffer for VRAM search and framebuffer comparison. Per device
+    // so cards can be tested from separate threads.
+    uint8_t chunk[CHUNK_SIZE] __attribute__((aligned(16)));
+    bool fifo_credits_suspended;
+    // State every test starts from, and the snapshot register writes are
+    // being recorded into (while ati_capture_test_state replays the setup)
+    ati_snapshot_t baseline;
+    ati_snapshot_t *recording;
+    ati_vram_heap_t heap; // Offscreen VRAM past the visible framebuffer
+    ati_cce_pio_stats_t pio_stats;
+    ati_microcode_state_t microcode;
+    uint32_t gui_wo[GUI_WO_COUNT];
+    gui_wo_state_t gui_wo_state[GUI_WO_COUNT];
+};
+
+ati_chip_family_t
+ati_get_chip_family(const ati_device_t *dev)
+{
+    return dev->family;
+}
+
+// ============================================================================
+// Display Modes
+// ============================================================================
+
+// Rows are packed (pitch is width * bpp / 8), which every mode here keeps
+// 64-byte aligned as the engine requires
+// clang-format off
+#define MODE(w, h, bpp, clk, ht, hss, hsw, vt, vss, vsw, hneg, vneg)          \
+    {#w "x" #h "x" #bpp, w, h, bpp, (w) * (bpp) / 8, clk, ht, hss, hsw,      \
+     vt, vss, vsw, hneg, vneg}
+
+const ati_display_mode_t ati_display_modes[] = {
+    MODE(640,  480,  32, 25175,  800,  656,  96,  525,  490,  2, true,  true),
+    MODE(640,  480,  24, 25175,  800,  656,  96,  525,  490,  2, true,  true),
+    MODE(640,  480,  16, 25175,  800,  656,  96,  525,  490,  2, true,  true),
+    MODE(640,  480,   8, 25175,  800,  656,  96,  525,  490,  2, true,  true),
+    MODE(1024, 768,  32, 65000,  1344, 1048, 136, 806,  771,  6, true,  true),
+    MODE(1024, 768,  24, 65000,  1344, 1048, 136, 806,  771,  6, true,  true),
+    MODE(1024, 768,  16, 65000,  1344, 1048, 136, 806,  771,  6, true,  true),
+    MODE(1024, 768,   8, 65000,  1344, 1048, 136, 806,  771,  6, true,  true),
+    MODE(1280, 1024, 32, 108000, 1688, 1328, 112, 1066, 1025, 3, false, false),
+    MODE(1280, 1024, 24, 108000, 1688, 1328, 112, 1066, 1025, 3, false, false),
+    MODE(1280, 1024, 16, 108000, 1688, 1328, 112, 1066, 1025, 3, false, false),
+    MODE(1280, 1024,  8, 108000, 1688, 1328, 112, 1066, 1025, 3, false, false),
+    {NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, false},
+};
+// clang-format on
+
+#undef MODE
+
+const ati_display_mode_t *
+ati_find_display_mode(const char *name)
+{
+    for (int i = 0; ati_display_modes[i].name != NULL; i++) {
+        if (strcmp(name, ati_display_modes[i].name) == 0)
+            return &ati_display_modes[i];
+    }
+    return NULL;
+}
+
+const ati_display_mode_t *
+ati_get_display_mode(const ati_device_t *dev)
+{
+    return dev->mode;
+}
+
+ati_surface_t
+ati_screen_surface(const ati_device_t *dev)
+{
+    const ati_display_mode_t *mode = dev->mode;
+    return (ati_surface_t) {0, mode->pitch, mode->width, mode->height,
+                            mode->bpp};
+}
+
+// ============================================================================
+// Shadow Register Cache
+// ============================================================================
+// Registers flagged `shadow` in the YAML only change when the host writes
+// them. With the cache enabled, reads of those registers are served from the
+// last value read back, and writes that repeat the last written value are
+// dropped. A write invalidates the read copy rather than replacing it, since
+// the hardware may mask bits. Engine resets and CCE mode changes invalidate
+// everything, and the cache is bypassed while the CCE runs.
+
+static inline bool
+shadow_test(const uint32_t *bits, uint32_t offset)
+{
+    return bits[offset / 128] & (1u << ((offset / 4) & 31));
+}
+
+static inline void
+shadow_set(uint32_t *bits, uint32_t offset)
+{
+    bits[offset / 128] |= 1u << ((offset / 4) & 31);
+}
+
+static inline void
+shadow_clear(uint32_t *bits, uint32_t offset)
+{
+    bits[offset / 128] &= ~(1u << ((offset / 4) & 31));
+}
+
+static inline bool
+shadow_active(const ati_device_t *dev, uint32_t offset)
+{
+    return dev->shadow_enabled && !dev->shadow_suspended &&
+           offset < REG_APERTURE_SIZE && shadow_test(dev->shadow_ok, offset);
+}
+
+static void
+shadow_build_map(ati_device_t *dev)
+{
+    memset(dev->shadow_ok, 0, sizeof(dev->shadow_ok));
+#define X(func_name, const_name, offset, flags, fields, aliases)               \
+    if (((flags) & FLAG_SHADOW) && (offset) < REG_APERTURE_SIZE)               \
+        shadow_set(dev->shadow_ok, offset);
+    COMMON_REGISTERS
+    if (dev->family == CHIP_R128) {
+        R128_REGISTERS
+    } else if (dev->family == CHIP_R100) {
+        R100_REGISTERS
+    }
+#undef X
+}
+
+// Whether ati_reg_read/ati_reg_write can stay inline (see ati_reg_fast_t).
+// Called whenever the backend, the shadow cache or recording changes.
+static void
+reg_fast_update(ati_device_t *dev)
+{
+    dev->regs.fast = dev->reg_backend == ATI_REG_MMIO &&
+                     !(dev->shadow_enabled && !dev->shadow_suspended) &&
+                     !dev->recording;
+}
+
+// Writes that ati_reg_write_slow has to see even on the fast path
+static void
+reg_slow_writes_build(ati_device_t *dev)
+{
+    uint32_t *bits = dev->regs.slow_writes;
+
+    memset(dev->regs.slow_writes, 0, sizeof(dev->regs.slow_writes));
+    shadow_set(bits, MM_INDEX);
+    shadow_set(bits, MM_DATA);
+    // Shared with CP_ME_RAM_DATAH/L
+    shadow_set(bits, R128_PM4_MICROCODE_DATAH);
+    shadow_set(bits, R128_PM4_MICROCODE_DATAL);
+    for (uint32_t offset = R100_SRC_PITCH_OFFSET;
+         offset <= R100_DP_GUI_MASTER_CNTL; offset += 4)
+        shadow_set(bits, offset);
+}
+
+void
+ati_shadow_invalidate(ati_device_t *dev)
+{
+    memset(dev->shadow_rd_valid, 0, sizeof(dev->shadow_rd_valid));
+    memset(dev->shadow_wr_valid, 0, sizeof(dev->shadow_wr_valid));
+}
+
+// A write through MM_DATA lands on whatever MM_INDEX points at, behind the
+// cache's back. Forget that register, or everything if the index is unknown.
+static void
+shadow_forget_indexed(ati_device_t *dev)
+{
+    if (!dev->mm_index_valid) {
+        ati_shadow_invalidate(dev);
+        return;
+    }
+    uint32_t offset = dev->mm_index & ~3u;
+    if (offset < REG_APERTURE_SIZE) {
+        shadow_clear(dev->shadow_rd_valid, offset);
+        shadow_clear(dev->shadow_wr_valid, offset);
+    }
+}
+
+void
+ati_shadow_enable(ati_device_t *dev, bool enable)
+{
+    ati_shadow_invalidate(dev);
+    dev->shadow_enabled = enable;
+    reg_fast_update(dev);
+}
+
+bool
+ati_shadow_is_enabled(const ati_device_t *dev)
+{
+    return dev->shadow_enabled;
+}
+
+void
+ati_shadow_suspend(ati_device_t *dev, bool suspend)
+{
+    ati_shadow_invalidate(dev);
+    dev->shadow_suspended = suspend;
+    reg_fast_update(dev);
+}
+
+void
+ati_shadow_get_stats(const ati_device_t *dev, ati_shadow_stats_t *out)
+{
+    *out = dev->shadow_stats;
+}
+
+void
+ati_shadow_reset_stats(ati_device_t *dev)
+{
+    memset(&dev->shadow_stats, 0, sizeof(dev->shadow_stats));
+}
+
+// ============================================================================
+// Device Lifecycle
+// ============================================================================
+
+// Devices live in a static pool so baremetal builds need no allocator
+static ati_device_t ati_devs[PLATFORM_MAX_DEVICES];
+static int ati_dev_count;
+
+bool
+ati_device_supported(platform_pci_device_t *pci_dev)
+{
+    return detect_chip_family(platform_pci_get_device_id(pci_dev)) !=
+           CHIP_UNKNOWN;
+}
+
+int
+ati_device_count(void)
+{
+    return ati_dev_count;
+}
+
+int
+ati_device_index(const ati_device_t *dev)
+{
+    return dev->index;
+}
+
+const char *
+ati_device_location(const ati_device_t *dev)
+{
+    return dev->location;
+}
+
+const ati_device_props_t *
+ati_device_props(const ati_device_t *dev)
+{
+    return &dev->props;
+}
+
+ati_vram_heap_t *
+ati_device_heap(ati_device_t *dev)
+{
+    return &dev->heap;
+}
+
+ati_cce_pio_stats_t *
+ati_device_pio_stats(ati_device_t *dev)
+{
+    return &dev->pio_stats;
+}
+
+ati_microcode_state_t *
+ati_device_microcode(ati_device_t *dev)
+{
+    return &dev->microcode;
+}
+
+void
+ati_microcode_invalidate(ati_device_t *dev)
+{
+    dev->microcode.valid = false;
+}
+
+static void
+probe_props(ati_device_t *dev, ati_device_props_t *props)
+{
+    props->vram_aperture = platform_pci_get_bar_size(dev->pci_dev, 0);
+    props->mmio_size = platform_pci_get_bar_size(dev->pci_dev, 2);
+    props->vram_size = rd_config_memsize(dev);
+    if (dev->family == CHIP_R100) {
+        props->aper_size = rd_r100_config_aper_size(dev);
+        props->fb_location = rd_r100_mc_fb_location(dev);
+    } else {
+        props->aper_size = 0;
+        props->fb_location = 0;
+    }
+}
+
+bool
+ati_device_reprobe(ati_device_t *dev)
+{
+    ati_device_props_t old = dev->props;
+    ati_device_props_t *now = &dev->props;
+    bool changed = false;
+
+    probe_props(dev, now);
+
+#define PROP_CHANGED(field, fmt)                                               \
+    do {                                                                       \
+        if (old.field != now->field) {                                         \
+            printf("%-14s " fmt " -> " fmt "\n", #field, old.field,            \
+                   now->field);                                                \
+            changed = true;                                                    \
+        }                                                                      \
+    } while (0)
+
+    PROP_CHANGED(vram_aperture, "0x%zx");
+    PROP_CHANGED(mmio_size, "0x%zx");
+    PROP_CHANGED(vram_size, "0x%08x");
+    PROP_CHANGED(aper_size, "0x%08x");
+    PROP_CHANGED(fb_location, "0x%08x");
+#undef PROP_CHANGED
+
+    return changed;
+}
+
+ati_device_t *
+ati_device_init(platform_pci_device_t *pci_dev)
+{
+    if (ati_dev_count >= PLATFORM_MAX_DEVICES)
+        return NULL;
+
+    uint16_t device_id = platform_pci_get_device_id(pci_dev);
+    ati_chip_family_t family = detect_chip_family(device_id);
+#ifdef ATI_CHIP_FAMILY
+    // Accessors for the pinned family don't check the chip at runtime, so
+    // any other chip would be driven with the wrong registers
+    if (family != ATI_CHIP_FAMILY) {
+        printf("ERROR: %s [%04x] is not %s, which this firmware is built "
+               "for; rebuild without CHIP=\n",
+               get_chip_name(device_id), device_id,
+               ati_chip_family_name(ATI_CHIP_FAMILY));
+        return NULL;
+    }
+#endif
+
+    ati_device_t *ati = &ati_devs[ati_dev_count];
+    ati->index = ati_dev_count++;
+
+    ati->pci_dev = pci_dev;
+    ati->device_id = device_id;
+    ati->family = family;
+    ati->mode = ATI_DEFAULT_MODE;
+    // VRAM is mapped write-combined when the platform allows it. MMIO
+    // always stays uncached.
+    ati->bar[0] = platform_pci_map_bar_wc(ati->pci_dev, 0);
+    ati->vram_wc = ati->bar[0] != NULL;
+    if (!ati->vram_wc)
+        ati->bar[0] = platform_pci_map_bar(ati->pci_dev, 0);
+    ati->bar[2] = platform_pci_map_bar(ati->pci_dev, 2);
+    ati->regs.mmio = ati->bar[2];
+    ati->io_ok = platform_pci_open_io(ati->pci_dev, IO_BAR);
+    ati->vram_width = VRAM_WIDEST;
+    platform_pci_get_name(ati->pci_dev, ati->name, sizeof(ati->name));
+    platform_pci_get_location(ati->pci_dev, ati->location,
+                              sizeof(ati->location));
+    shadow_build_map(ati);
+    reg_slow_writes_build(ati);
+    reg_fast_update(ati);
+    probe_props(ati, &ati->props);
+    ati_vram_heap_reset(ati);
+
+    // Print device info
+    const char *color;
+    switch (ati->family) {
+    case CHIP_R128:
+        color = "\033[36m";  // cyan
+        break;
+    case CHIP_R100:
+        color = "\033[35m";  // magenta
+        break;
+    default:
+        color = "\033[31m";  // red
+        break;
+    }
+    printf("Detected: %s%s\033[0m [%04x] (%s%s\033[0m family) at %s\n",
+           color, get_chip_name(ati->device_id),
+           ati->device_id,
+           color, ati_chip_family_name(ati->family), ati->location);
+
+    if (ati->family == CHIP_UNKNOWN) {
+        printf("WARNING: Unknown chip family, behavior may be unpredictable\n");
+    }
+    return ati;
+}
+
+void
+ati_device_destroy(ati_device_t *dev)
+{
+    if (!dev)
+        return;
+    for (int i = 0; i < NUM_BARS; i++) {
+        if (dev->bar[i])
+            platform_pci_unmap_bar(dev->pci_dev, dev->bar[i], i);
+    }
+    platform_pci_destroy(dev->pci_dev);
+}
+
+// ============================================================================
+// Register and VRAM Access
+// ============================================================================
+
+static inline uint32_t
+reg_read(void *base, uint32_t offset)
+{
+    volatile uint32_t *reg = (volatile uint32_t *) ((char *) base + offset);
+    return *reg;
+}
+
+static inline void
+reg_write(void *base, uint32_t offset, uint32_t value)
+{
+    volatile uint32_t *reg = (volatile uint32_t *) ((char *) base + offset);
+    *reg = value;
+}
+
+// Register access through the selected backend. MM_INDEX and MM_DATA
+// themselves are always reached directly.
+static inline void
+mm_index_select(ati_device_t *dev, uint32_t offset)
+{
+    if (dev->mm_index_valid && dev->mm_index == offset)
+        return;
+    if (dev->reg_backend == ATI_REG_IO)
+        platform_pci_io_write32(dev->pci_dev, MM_INDEX, offset);
+    else
+        reg_write(dev->bar[2], MM_INDEX, offset);
+    dev->mm_index = offset;
+    dev->mm_index_valid = true;
+}
+
+static inline uint32_t
+backend_read(ati_device_t *dev, uint32_t offset)
+{
+    switch (dev->reg_backend) {
+    case ATI_REG_IO:
+        if (offset < IO_DIRECT_SIZE)
+            return platform_pci_io_read32(dev->pci_dev, offset);
+        mm_index_select(dev, offset);
+        return platform_pci_io_read32(dev->pci_dev, MM_DATA);
+    case ATI_REG_INDIRECT:
+        if (offset > MM_DATA) {
+            mm_index_select(dev, offset);
+            return reg_read(dev->bar[2], MM_DATA);
+        }
+        break;
+    case ATI_REG_MMIO:
+        break;
+    }
+    return reg_read(dev->bar[2], offset);
+}
+
+static inline void
+backend_write(ati_device_t *dev, uint32_t offset, uint32_t value)
+{
+    if (offset == MM_INDEX) {
+        dev->mm_index = value;
+        dev->mm_index_valid = true;
+    }
+
+    switch (dev->reg_backend) {
+    case ATI_REG_IO:
+        if (offset < IO_DIRECT_SIZE) {
+            platform_pci_io_write32(dev->pci_dev, offset, value);
+            return;
+        }
+        mm_index_select(dev, offset);
+        platform_pci_io_write32(dev->pci_dev, MM_DATA, value);
+        return;
+    case ATI_REG_INDIRECT:
+        if (offset > MM_DATA) {
+            mm_index_select(dev, offset);
+            reg_write(dev->bar[2], MM_DATA, value);
+            return;
+        }
+        break;
+    case ATI_REG_MMIO:
+        break;
+    }
+    reg_write(dev->bar[2], offset, value);
+}
+
+const char *
+ati_reg_backend_name(ati_reg_backend_t backend)
+{
+    switch (backend) {
+    case ATI_REG_MMIO:
+        return "mmio";
+    case ATI_REG_IO:
+        return "io";
+    case ATI_REG_INDIRECT:
+        return "indirect";
+    }
+    return "unknown";
+}
+
+ati_reg_backend_t
+ati_reg_get_backend(const ati_device_t *dev)
+{
+    return dev->reg_backend;
+}
+
+bool
+ati_reg_set_backend(ati_device_t *dev, ati_reg_backend_t backend)
+{
+    if (backend == ATI_REG_IO && !dev->io_ok)
+        return false;
+    dev->reg_backend = backend;
+    dev->mm_index_valid = false;
+    reg_fast_update(dev);
+    return true;
+}
+
+static inline void
+gui_wo_record(ati_device_t *dev, uint32_t offset, uint32_t value)
+{
+    for (int i = 0; i < GUI_WO_COUNT; i++) {
+        if (offset == gui_wo_regs[i]) {
+            dev->gui_wo[i] = value;
+            dev->gui_wo_state[i] = GUI_WO_KNOWN;
+        }
+    }
+}
+
+void
+ati_gui_wo_invalidate(ati_device_t *dev)
+{
+    for (int i = 0; i < GUI_WO_COUNT; i++) {
+        if (dev->gui_wo_state[i] == GUI_WO_KNOWN)
+            dev->gui_wo_state[i] = GUI_WO_UNKNOWN;
+    }
+}
+
+// Drain CPU write-combining buffers so VRAM writes land before anything
+// that might make the engine read them.
+static inline void
+vram_wc_flush(ati_device_t *dev)
+{
+    if (dev->regs.wc_pending) {
+        __sync_synchronize();
+        dev->regs.wc_pending = false;
+    }
+}
+
+uint32_t
+ati_reg_read_slow(ati_device_t *dev, uint32_t offset)
+{
+    bool shadow = shadow_active(dev, offset);
+    if (shadow && shadow_test(dev->shadow_rd_valid, offset)) {
+        dev->shadow_stats.read_hits++;
+        return dev->shadow_rd[offset / 4];
+    }
+
+    if (offset < REG_APERTURE_SIZE)
+        dev->regs.reads[offset / 4]++;
+    uint32_t value = backend_read(dev, offset);
+    ATI_TRACE(TRACE_REG_READ, offset, value);
+
+    if (shadow) {
+        dev->shadow_stats.read_misses++;
+        dev->shadow_rd[offset / 4] = value;
+        shadow_set(dev->shadow_rd_valid, offset);
+    }
+    return value;
+}
+
+void
+ati_reg_write_slow(ati_device_t *dev, uint32_t offset, uint32_t value)
+{
+    if (dev->recording)
+        ati_snapshot_record(dev->recording, offset, value);
+
+    if (shadow_active(dev, offset)) {
+        if (shadow_test(dev->shadow_wr_valid, offset) &&
+            dev->shadow_wr[offset / 4] == value) {
+            dev->shadow_stats.write_drops++;
+            return;
+        }
+        dev->shadow_stats.writes++;
+        dev->shadow_wr[offset / 4] = value;
+        shadow_set(dev->shadow_wr_valid, offset);
+        shadow_clear(dev->shadow_rd_valid, offset);
+    }
+    if (offset == MM_DATA && dev->shadow_enabled)
+        shadow_forget_indexed(dev);
+    // Any write to the instruction RAM leaves the resident image unknown.
+    // PM4_MICROCODE_DATAH/L and CP_ME_RAM_DATAH/L share offsets.
+    if (offset == R128_PM4_MICROCODE_DATAH ||
+        offset == R128_PM4_MICROCODE_DATAL)
+        dev->microcode.valid = false;
+    if (offset >= R100_SRC_PITCH_OFFSET && offset <= R100_DP_GUI_MASTER_CNTL)
+        gui_wo_record(dev, offset, value);
+
+    vram_wc_flush(dev);
+    if (dev->regs.fifo_credits)
+        dev->regs.fifo_credits--;
+    if (offset < REG_APERTURE_SIZE)
+        dev->regs.writes[offset / 4]++;
+    ATI_TRACE(TRACE_REG_WRITE, offset, value);
+    backend_write(dev, offset, value);
+}
+
+void
+ati_reg_stats_reset(ati_device_t *dev)
+{
+    memset(dev->regs.reads, 0, sizeof(dev->regs.reads));
+    memset(dev->regs.writes, 0, sizeof(dev->regs.writes));
+}
+
+void
+ati_reg_stats_get(const ati_device_t *dev, uint32_t offset, uint32_t *reads,
+                  uint32_t *writes)
+{
+    *reads = offset < REG_APERTURE_SIZE ? dev->regs.reads[offset / 4] : 0;
+    *writes = offset < REG_APERTURE_SIZE ? dev->regs.writes[offset / 4] : 0;
+}
+
+uint32_t
+ati_vram_read(ati_device_t *dev, uint32_t offset)
+{
+    // WC loads are weakly ordered; don't let one pass an earlier idle poll
+    if (dev->vram_wc)
+        __sync_synchronize();
+    uint32_t value = reg_read(dev->bar[0], offset);
+    ATI_TRACE(TRACE_VRAM_READ, offset, value);
+    return value;
+}
+
+void
+ati_vram_write(ati_device_t *dev, uint32_t offset, uint32_t value)
+{
+    ATI_TRACE(TRACE_VRAM_WRITE, offset, value);
+    reg_write(dev->bar[0], offset, value);
+    dev->regs.wc_pending = dev->vram_wc;
+}
+
+size_t
+ati_vram_aperture_size(ati_device_t *dev)
+{
+    return dev->props.vram_aperture;
+}
+
+bool
+ati_vram_is_write_combining(const ati_device_t *dev)
+{
+    return dev->vram_wc;
+}
+
+bool
+ati_vram_set_write_combining(ati_device_t *dev, bool enable)
+{
+    if (enable == dev->vram_wc)
+        return dev->vram_wc;
+
+    vram_wc_flush(dev);
+    platform_pci_unmap_bar(dev->pci_dev, dev->bar[0], 0);
+
+    void *bar = enable ? platform_pci_map_bar_wc(dev->pci_dev, 0) : NULL;
+    dev->vram_wc = bar != NULL;
+    dev->bar[0] = bar ? bar : platform_pci_map_bar(dev->pci_dev, 0);
+    return dev->vram_wc;
+}
+
+// ============================================================================
+// Bulk VRAM Copies
+// ============================================================================
+// Each mover aligns the VRAM side with dword accesses, runs its widest
+// transfer, and returns how many bytes it handled (always whole dwords).
+// The next narrower mover picks up from there. System RAM is accessed with
+// __builtin_memcpy or unaligned loads, so it needs no particular alignment.
+
+const char *
+ati_vram_width_name(ati_vram_width_t width)
+{
+    switch (width) {
+    case ATI_VRAM_DWORD:
+        return "dword";
+    case ATI_VRAM_QWORD:
+        return "qword";
+    case ATI_VRAM_SSE:
+        return "sse";
+    }
+    return "unknown";
+}
+
+ati_vram_width_t
+ati_vram_widest(void)
+{
+    return VRAM_WIDEST;
+}
+
+ati_vram_width_t
+ati_vram_set_copy_width(ati_device_t *dev, ati_vram_width_t width)
+{
+    dev->vram_width = width > VRAM_WIDEST ? VRAM_WIDEST : width;
+    return dev->vram_width;
+}
+
+// Bytes of dword stores/loads needed to bring a VRAM address up to align
+static inline size_t
+vram_lead(const volatile uint8_t *vram, size_t align, size_t size)
+{
+    size_t lead = (align - ((uintptr_t) vram & (align - 1))) & (align - 1);
+    return lead > size ? size & ~(size_t) 3 : lead;
+}
+
+static size_t
+upload_dword(volatile uint8_t *dst, const uint8_t *src, size_t size)
+{
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        uint32_t v;
+        __builtin_memcpy(&v, src + i, 4);
+        *(volatile uint32_t *) (dst + i) = v;
+    }
+    return i;
+}
+
+static size_t
+readback_dword(const volatile uint8_t *src, uint8_t *dst, size_t size)
+{
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        uint32_t v = *(const volatile uint32_t *) (src + i);
+        __builtin_memcpy(dst + i, &v, 4);
+    }
+    return i;
+}
+
+static size_t
+set_dword(volatile uint8_t *dst, uint32_t value, size_t size)
+{
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+        *(volatile uint32_t *) (dst + i) = value;
+    return i;
+}
+
+#if UINTPTR_MAX > UINT32_MAX
+static size_t
+upload_qword(volatile uint8_t *dst, const uint8_t *src, size_t size)
+{
+    size_t i = upload_dword(dst, src, vram_lead(dst, 8, size));
+    for (; i + 8 <= size; i += 8) {
+        uint64_t v;
+        __builtin_memcpy(&v, src + i, 8);
+        *(volatile uint64_t *) (dst + i) = v;
+    }
+    return i;
+}
+
+static size_t
+readback_qword(const volatile uint8_t *src, uint8_t *dst, size_t size)
+{
+    size_t i = readback_dword(src, dst, vram_lead(src, 8, size));
+    for (; i + 8 <= size; i += 8) {
+        uint64_t v = *(const volatile uint64_t *) (src + i);
+        __builtin_memcpy(dst + i, &v, 8);
+    }
+    return i;
+}
+
+static size_t
+set_qword(volatile uint8_t *dst, uint32_t value, size_t size)
+{
+    uint64_t v = value * 0x0000000100000001ull;
+    size_t i = set_dword(dst, value, vram_lead(dst, 8, size));
+    for (; i + 8 <= size; i += 8)
+        *(volatile uint64_t *) (dst + i) = v;
+    return i;
+}
+#endif
+
+#if defined(__SSE2__)
+static size_t
+upload_sse(volatile uint8_t *dst, const uint8_t *src, size_t size)
+{
+    size_t i = upload_dword(dst, src, vram_lead(dst, 16, size));
+    for (; i + 64 <= size; i += 64) {
+        const __m128i *s = (const __m128i *) (src + i);
+        __m128i a = _mm_loadu_si128(s);
+        __m128i b = _mm_loadu_si128(s + 1);
+        __m128i c = _mm_loadu_si128(s + 2);
+        __m128i d = _mm_loadu_si128(s + 3);
+        __m128i *o = (__m128i *) (uintptr_t) (dst + i);
+        _mm_store_si128(o, a);
+        _mm_store_si128(o + 1, b);
+        _mm_store_si128(o + 2, c);
+        _mm_store_si128(o + 3, d);
+    }
+    for (; i + 16 <= size; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *) (src + i));
+        _mm_store_si128((__m128i *) (uintptr_t) (dst + i), a);
+    }
+    return i;
+}
+
+static size_t
+readback_sse(const volatile uint8_t *src, uint8_t *dst, size_t size)
+{
+    size_t i = readback_dword(src, dst, vram_lead(src, 16, size));
+    for (; i + 64 <= size; i += 64) {
+        const __m128i *s = (const __m128i *) (uintptr_t) (src + i);
+        __m128i a = _mm_load_si128(s);
+        __m128i b = _mm_load_si128(s + 1);
+        __m128i c = _mm_load_si128(s + 2);
+        __m128i d = _mm_load_si128(s + 3);
+        __m128i *o = (__m128i *) (dst + i);
+        _mm_storeu_si128(o, a);
+        _mm_storeu_si128(o + 1, b);
+        _mm_storeu_si128(o + 2, c);
+        _mm_storeu_si128(o + 3, d);
+    }
+    for (; i + 16 <= size; i += 16) {
+        __m128i a = _mm_load_si128((const __m128i *) (uintptr_t) (src + i));
+        _mm_storeu_si128((__m128i *) (dst + i), a);
+    }
+    return i;
+}
+
+static size_t
+set_sse(volatile uint8_t *dst, uint32_t value, size_t size)
+{
+    __m128i v = _mm_set1_epi32((int) value);
+    size_t i = set_dword(dst, value, vram_lead(dst, 16, size));
+    for (; i + 64 <= size; i += 64) {
+        __m128i *o = (__m128i *) (uintptr_t) (dst + i);
+        _mm_store_si128(o, v);
+        _mm_store_si128(o + 1, v);
+        _mm_store_si128(o + 2, v);
+        _mm_store_si128(o + 3, v);
+    }
+    for (; i + 16 <= size; i += 16)
+        _mm_store_si128((__m128i *) (uintptr_t) (dst + i), v);
+    return i;
+}
+#endif
+
+#ifdef HAVE_STREAM_LOAD
+// Copy with movntdqa. On WC memory this pulls a full 64-byte line into a
+// streaming load buffer per access instead of issuing one uncached read per
+// load. Returns the number of bytes copied (a multiple of 64).
+__attribute__((target("sse4.1"))) static size_t
+vram_stream_load(const volatile uint8_t *src, uint8_t *out, size_t size)
+{
+    size_t i = 0;
+
+    if ((uintptr_t) src & 15)
+        return 0;
+
+    for (; i + 64 <= size; i += 64) {
+        __m128i *s = (__m128i *) (uintptr_t) (src + i);
+        __m128i a = _mm_stream_load_si128(s);
+        __m128i b = _mm_stream_load_si128(s + 1);
+        __m128i c = _mm_stream_load_si128(s + 2);
+        __m128i d = _mm_stream_load_si128(s + 3);
+        __m128i *o = (__m128i *) (out + i);
+        _mm_storeu_si128(o, a);
+        _mm_storeu_si128(o + 1, b);
+        _mm_storeu_si128(o + 2, c);
+        _mm_storeu_si128(o + 3, d);
+    }
+    return i;
+}
+#endif
+
+static void
+vram_upload(ati_device_t *dev, volatile uint8_t *dst, const uint8_t *src,
+            size_t size)
+{
+    size_t i = 0;
+
+    switch (dev->vram_width) {
+    case ATI_VRAM_SSE:
+#if defined(__SSE2__)
+        i = upload_sse(dst, src, size);
+#endif
+        // fall through
+    case ATI_VRAM_QWORD:
+#if UINTPTR_MAX > UINT32_MAX
+        i += upload_qword(dst + i, src + i, size - i);
+#endif
+        // fall through
+    case ATI_VRAM_DWORD:
+        i += upload_dword(dst + i, src + i, size - i);
+        break;
+    }
+
+    // Merge a ragged tail into the dword it lands in
+    if (i < size) {
+        uint32_t v = *(volatile uint32_t *) (dst + i);
+        __builtin_memcpy(&v, src + i, size - i);
+        *(volatile uint32_t *) (dst + i) = v;
+    }
+}
+
+static void
+vram_readback(ati_device_t *dev, const volatile uint8_t *src, uint8_t *dst,
+              size_t size)
+{
+    size_t i = 0;
+
+    switch (dev->vram_width) {
+    case ATI_VRAM_SSE:
+#ifdef HAVE_STREAM_LOAD
+        if (dev->vram_wc && __builtin_cpu_supports("sse4.1"))
+            i = vram_stream_load(src, dst, size);
+#endif
+#if defined(__SSE2__)
+        i += readback_sse(src + i, dst + i, size - i);
+#endif
+        // fall through
+    case ATI_VRAM_QWORD:
+#if UINTPTR_MAX > UINT32_MAX
+        i += readback_qword(src + i, dst + i, size - i);
+#endif
+        // fall through
+    case ATI_VRAM_DWORD:
+        i += readback_dword(src + i, dst + i, size - i);
+        break;
+    }
+
+    if (i < size) {
+        uint32_t v = *(const volatile uint32_t *) (src + i);
+        __builtin_memcpy(dst + i, &v, size - i);
+    }
+}
+
+static void
+vram_set(ati_device_t *dev, volatile uint8_t *dst, uint32_t value,
+         size_t size)
+{
+    size_t i = 0;
+
+    switch (dev->vram_width) {
+    case ATI_VRAM_SSE:
+#if defined(__SSE2__)
+        i = set_sse(dst, value, size);
+#endif
+        // fall through
+    case ATI_VRAM_QWORD:
+#if UINTPTR_MAX > UINT32_MAX
+        i += set_qword(dst + i, value, size - i);
+#endif
+        // fall through
+    case ATI_VRAM_DWORD:
+        set_dword(dst + i, value, size - i);
+        break;
+    }
+}
+
+void
+ati_vram_upload(ati_device_t *dev, uint32_t offset, const void *src,
+                size_t size)
+{
+    if (offset + size > dev->props.vram_aperture) {
+        printf("Upload of 0x%zx bytes at 0x%x overruns BAR0\n", size, offset);
+        return;
+    }
+
+    vram_upload(dev, (volatile uint8_t *) dev->bar[0] + offset, src, size);
+    dev->regs.wc_pending = dev->vram_wc;
+}
+
+void
+ati_vram_readback(ati_device_t *dev, uint32_t offset, void *dst, size_t size)
+{
+    // WC loads are weakly ordered; don't let them pass an earlier idle poll
+    if (dev->vram_wc)
+        __sync_synchronize();
+    vram_readback(dev, (const volatile uint8_t *) dev->bar[0] + offset, dst,
+                  size);
+}
+
+void
+ati_vram_set(ati_device_t *dev, uint32_t offset, uint32_t value, size_t size)
+{
+    vram_set(dev, (volatile uint8_t *) dev->bar[0] + offset, value, size);
+    dev->regs.wc_pending = dev->vram_wc;
+}
+
+void
+ati_vram_upload_rect(ati_device_t *dev, uint32_t offset, uint32_t pitch,
+                     const void *src, size_t src_pitch, size_t row_bytes,
+                     uint32_t height)
+{
+    volatile uint8_t *vram = (volatile uint8_t *) dev->bar[0] + offset;
+    const uint8_t *row = src;
+
+    for (uint32_t y = 0; y < height; y++)
+        vram_upload(dev, vram + (size_t) y * pitch, row + y * src_pitch,
+                    row_bytes);
+    dev->regs.wc_pending = dev->vram_wc;
+}
+
+void
+ati_vram_readback_rect(ati_device_t *dev, uint32_t offset, uint32_t pitch,
+                       void *dst, size_t dst_pitch, size_t row_bytes,
+                       uint32_t height)
+{
+    const volatile uint8_t *vram =
+        (const volatile uint8_t *) dev->bar[0] + offset;
+    uint8_t *row = dst;
+
+    if (dev->vram_wc)
+        __sync_synchronize();
+    for (uint32_t y = 0; y < height; y++)
+        vram_readback(dev, vram + (size_t) y * pitch, row + y * dst_pitch,
+                      row_bytes);
+}
+
+// ============================================================================
+// Batched Register Writes
+// ============================================================================
+
+// Refill credits in chunks: waiting for the whole FIFO to drain would stall
+// behind whatever the engine is drawing
+#define BATCH_FIFO_CHUNK (FIFO_MAX / 4)
+#define BATCH_PKT_DWORDS 64
+
+void
+ati_fifo_credits_reset(ati_device_t *dev)
+{
+    dev->regs.fifo_credits = 0;
+}
+
+void
+ati_fifo_credits_suspend(ati_device_t *dev, bool suspend)
+{
+    dev->regs.fifo_credits = 0;
+    dev->fifo_credits_suspended = suspend;
+}
+
+// Runs of consecutive offsets share one type-0 header
+static void
+batch_cce(ati_device_t *dev, const ati_reg_pair_t *pairs, size_t count)
+{
+    uint32_t buf[BATCH_PKT_DWORDS];
+    size_t n = 0;
+    size_t hdr = 0;
+    uint32_t run = 0; // Registers under buf[hdr]
+
+    for (size_t i = 0; i < count; i++) {
+        bool extend = run > 0 && pairs[i].offset == pairs[i - 1].offset + 4;
+        if (n + (extend ? 1 : 2) > BATCH_PKT_DWORDS) {
+            ati_send_packet(dev, buf, n);
+            n = 0;
+            extend = false;
+        }
+        if (!extend) {
+            hdr = n++;
+            run = 0;
+        }
+        buf[n++] = pairs[i].value;
+        run++;
+        buf[hdr] = CCE_PKT0(pairs[i + 1 - run].offset, run);
+    }
+    if (n)
+        ati_send_packet(dev, buf, n);
+    // They're host writes all the same
+    for (size_t i = 0; i < count; i++)
+        gui_wo_record(dev, pairs[i].offset, pairs[i].value);
+}
+
+static void
+batch_mmio(ati_device_t *dev, const ati_reg_pair_t *pairs, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (dev->regs.fifo_credits == 0) {
+            size_t left = count - i;
+            ati_wait_for_fifo(dev, left < BATCH_FIFO_CHUNK ? left
+                                                           : BATCH_FIFO_CHUNK);
+        }
+        ati_reg_write(dev, pairs[i].offset, pairs[i].value);
+    }
+}
+
+void
+ati_reg_write_batch(ati_device_t *dev, const ati_reg_pair_t *pairs,
+                    size_t count)
+{
+    if (count == 0)
+        return;
+    if (ati_cce_get_mode(dev) == CCE_MODE_PIO)
+        batch_cce(dev, pairs, count);
+    else
+        batch_mmio(dev, pairs, count);
+}
+
+// ============================================================================
+// VRAM Search
+// ============================================================================
+
+// VRAM is read into system RAM a chunk at a time and scanned there, so the
+// aperture only sees wide sequential loads.
+#define SEARCH_CHUNK_SIZE CHUNK_SIZE
+
+static bool
+search_match(uint32_t val, const ati_vram_needle_t *needles, size_t count)
+{
+    for (size_t n = 0; n < count; n++) {
+        if ((val & needles[n].mask) == needles[n].value)
+            return true;
+    }
+    return false;
+}
+
+// Scan a chunk, appending the VRAM offset of each matching dword to hits.
+// Returns the new hit count.
+static size_t
+search_block(const uint32_t *buf, size_t dwords, uint32_t base,
+             const ati_vram_needle_t *needles, size_t count, uint32_t *hits,
+             size_t nhits, size_t max_hits)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    __m128i value[VRAM_SEARCH_MAX_NEEDLES], mask[VRAM_SEARCH_MAX_NEEDLES];
+    for (size_t n = 0; n < count; n++) {
+        value[n] = _mm_set1_epi32(needles[n].value);
+        mask[n] = _mm_set1_epi32(needles[n].mask);
+    }
+
+    // Test 16 dwords per pass; only a pass with a hit is rescanned per dword
+    for (; i + 16 <= dwords && nhits < max_hits; i += 16) {
+        const __m128i *v = (const __m128i *) (buf + i);
+        __m128i a = _mm_load_si128(v), b = _mm_load_si128(v + 1);
+        __m128i c = _mm_load_si128(v + 2), d = _mm_load_si128(v + 3);
+        __m128i hit = _mm_setzero_si128();
+        for (size_t n = 0; n < count; n++) {
+            hit = _mm_or_si128(
+                hit, _mm_cmpeq_epi32(_mm_and_si128(a, mask[n]), value[n]));
+            hit = _mm_or_si128(
+                hit, _mm_cmpeq_epi32(_mm_and_si128(b, mask[n]), value[n]));
+            hit = _mm_or_si128(
+                hit, _mm_cmpeq_epi32(_mm_and_si128(c, mask[n]), value[n]));
+            hit = _mm_or_si128(
+                hit, _mm_cmpeq_epi32(_mm_and_si128(d, mask[n]), value[n]));
+        }
+        if (_mm_movemask_epi8(hit) == 0)
+            continue;
+        for (size_t j = i; j < i + 16 && nhits < max_hits; j++) {
+            if (search_match(buf[j], needles, count))
+                hits[nhits++] = base + j * 4;
+        }
+    }
+#endif
+    for (; i < dwords && nhits < max_hits; i++) {
+        if (search_match(buf[i], needles, count))
+            hits[nhits++] = base + i * 4;
+    }
+    return nhits;
+}
+
+// Find every dword in [start, end) that matches any of the needles, where a
+// needle matches when (dword & mask) == value. Offsets are rounded down to a
+// dword and end is clamped to the aperture. Stops once max_hits offsets have
+// been stored; returns the number stored, so a full buffer means the scan
+// can be resumed from the last hit + 4.
+size_t
+ati_vram_search_range(ati_device_t *dev, const ati_vram_needle_t *needles,
+                      size_t count, uint32_t start, uint32_t end,
+                      uint32_t *hits, size_t max_hits)
+{
+    size_t vram_size = dev->props.vram_aperture;
+    size_t nhits = 0;
+
+    if (count == 0 || count > VRAM_SEARCH_MAX_NEEDLES || max_hits == 0)
+        return 0;
+    if (end > vram_size)
+        end = vram_size;
+    start &= ~3u;
+    end &= ~3u;
+
+    // Masked-off value bits can never match; drop them up front
+    ati_vram_needle_t norm[VRAM_SEARCH_MAX_NEEDLES];
+    for (size_t n = 0; n < count; n++) {
+        norm[n].mask = needles[n].mask;
+        norm[n].value = needles[n].value & needles[n].mask;
+    }
+
+    for (uint32_t offset = start; offset < end && nhits < max_hits;
+         offset += SEARCH_CHUNK_SIZE) {
+        size_t len = end - offset;
+        if (len > SEARCH_CHUNK_SIZE)
+            len = SEARCH_CHUNK_SIZE;
+        ati_vram_readback(dev, offset, dev->chunk, len);
+        nhits = search_block((const uint32_t *) dev->chunk, len / 4, offset,
+                             norm, count, hits, nhits, max_hits);
+    }
+    return nhits;
+}
+
+uint64_t
+ati_vram_search(ati_device_t *dev, uint32_t needle)
+{
+    ati_vram_needle_t n = {needle, 0xffffffff};
+    uint32_t hit;
+
+    if (ati_vram_search_range(dev, &n, 1, 0, UINT32_MAX, &hit, 1) == 0)
+        return VRAM_NOT_FOUND;
+    return hit;
+}
+
+// ============================================================================
+// Framebuffer Comparison
+// ============================================================================
+
+// VRAM is pulled into system RAM in chunks of this size before comparing, so
+// each uncached aperture access moves as much data as possible.
+#define COMPARE_CHUNK_SIZE CHUNK_SIZE
+
+typedef struct {
+    // Surface geometry, for turning byte offsets into pixel coordinates
+    uint32_t width;
+    uint32_t bypp;
+    size_t mismatch_count;
+    size_t first_mismatch;
+    uint8_t first_expected;
+    uint8_t first_got;
+    // Bounding box of mismatched pixels (inclusive)
+    uint32_t min_x, min_y, max_x, max_y;
+} compare_result_t;
+
+static void
+compare_result_init(compare_result_t *res, const ati_surface_t *surf)
+{
+    res->width = surf->width;
+    res->bypp = surf->bpp / 8;
+    res->mismatch_count = 0;
+    res->first_mismatch = SIZE_MAX;
+    res->first_expected = 0;
+    res->first_got = 0;
+    res->min_x = UINT32_MAX;
+    res->min_y = UINT32_MAX;
+    res->max_x = 0;
+    res->max_y = 0;
+}
+
+static void
+compare_note_mismatch(compare_result_t *res, size_t offset, uint8_t expected,
+                      uint8_t got)
+{
+    if (res->mismatch_count == 0) {
+        res->first_mismatch = offset;
+        res->first_expected = expected;
+        res->first_got = got;
+    }
+    res->mismatch_count++;
+
+    uint32_t pixel = offset / res->bypp;
+    uint32_t x = pixel % res->width;
+    uint32_t y = pixel / res->width;
+    if (x < res->min_x)
+        res->min_x = x;
+    if (x > res->max_x)
+        res->max_x = x;
+    if (y < res->min_y)
+        res->min_y = y;
+    if (y > res->max_y)
+        res->max_y = y;
+}
+
+// Number of leading bytes that are identical in a and b
+static size_t
+match_prefix(const uint8_t *a, const uint8_t *b, size_t len)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 16 <= len; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i *) (a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *) (b + i));
+        unsigned eq = _mm_movemask_epi8(_mm_cmpeq_epi8(va, vb));
+        if (eq != 0xffff)
+            return i + __builtin_ctz(~eq);
+    }
+#endif
+    for (; i + sizeof(uintptr_t) <= len; i += sizeof(uintptr_t)) {
+        uintptr_t wa, wb;
+        __builtin_memcpy(&wa, a + i, sizeof(wa));
+        __builtin_memcpy(&wb, b + i, sizeof(wb));
+        if (wa != wb)
+            break;
+    }
+    while (i < len && a[i] == b[i])
+        i++;
+    return i;
+}
+
+// Diff a chunk of VRAM (already in system RAM) against the expected bytes
+static void
+compare_block(compare_result_t *res, size_t base, const uint8_t *got,
+              const uint8_t *expected, size_t len)
+{
+    size_t i = 0;
+    while (i < len) {
+        i += match_prefix(got + i, expected + i, len - i);
+        if (i >= len)
+            break;
+        compare_note_mismatch(res, base + i, expected[i], got[i]);
+        i++;
+    }
+}
+
+// Number of leading bytes of a that are equal to value
+static size_t
+match_fill_prefix(const uint8_t *a, uint8_t value, size_t len)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    __m128i vv = _mm_set1_epi8((char) value);
+    for (; i + 16 <= len; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i *) (a + i));
+        unsigned eq = _mm_movemask_epi8(_mm_cmpeq_epi8(va, vv));
+        if (eq != 0xffff)
+            return i + __builtin_ctz(~eq);
+    }
+#endif
+    uintptr_t pattern = (UINTPTR_MAX / 0xff) * value;
+    for (; i + sizeof(uintptr_t) <= len; i += sizeof(uintptr_t)) {
+        uintptr_t wa;
+        __builtin_memcpy(&wa, a + i, sizeof(wa));
+        if (wa != pattern)
+            break;
+    }
+    while (i < len && a[i] == value)
+        i++;
+    return i;
+}
+
+// Diff a chunk of VRAM (already in system RAM) against a run of one byte
+static void
+compare_fill(compare_result_t *res, size_t base, const uint8_t *got,
+             uint8_t value, size_t len)
+{
+    size_t i = 0;
+    while (i < len) {
+        i += match_fill_prefix(got + i, value, len - i);
+        if (i >= len)
+            break;
+        compare_note_mismatch(res, base + i, value, got[i]);
+        i++;
+    }
+}
+
+// Walks a fixture as a sequence of spans without decoding it. Each span is
+// either literal bytes pointing into the fixture or a run of a single byte.
+// RLE tokens are 0xFF <count> <byte>; any other byte is a literal.
+typedef struct {
+    const uint8_t *src;
+    const uint8_t *end;
+    fixture_encoding_t encoding;
+    const uint8_t *literal;  // NULL for a run
+    uint8_t value;
+    size_t remaining;
+} fixture_stream_t;
+
+static void
+fixture_stream_init(fixture_stream_t *fs, const uint8_t *data, size_t size,
+                    fixture_encoding_t encoding)
+{
+    fs->src = data;
+    fs->end = data + size;
+    fs->encoding = encoding;
+    fs->literal = NULL;
+    fs->value = 0;
+    fs->remaining = 0;
+}
+
+// Advance to the next non-empty span. Returns false at end of stream.
+static bool
+fixture_stream_next(fixture_stream_t *fs)
+{
+    fs->remaining = 0;
+    while (fs->remaining == 0) {
+        if (fs->src >= fs->end)
+            return false;
+
+        if (fs->encoding == FIXTURE_RAW) {
+            fs->literal = fs->src;
+            fs->remaining = fs->end - fs->src;
+            fs->src = fs->end;
+        } else if (*fs->src == 0xFF) {
+            if (fs->src + 2 >= fs->end) {
+                fs->src = fs->end;  // Incomplete escape sequence
+                return false;
+            }
+            // Coalesce back-to-back runs of the same byte; the encoder
+            // splits long runs at 255.
+            fs->literal = NULL;
+            fs->value = fs->src[2];
+            while (fs->src + 2 < fs->end && fs->src[0] == 0xFF &&
+                   fs->src[2] == fs->value) {
+                fs->remaining += fs->src[1];
+                fs->src += 3;
+            }
+        } else {
+            fs->literal = fs->src;
+            while (fs->src < fs->end && *fs->src != 0xFF)
+                fs->src++;
+            fs->remaining = fs->src - fs->literal;
+        }
+    }
+    return true;
+}
+
+// Size of the fixture once decoded, computed from the token stream alone
+static size_t
+fixture_decoded_size(const uint8_t *data, size_t size,
+                     fixture_encoding_t encoding)
+{
+    fixture_stream_t fs;
+    size_t total = 0;
+
+    fixture_stream_init(&fs, data, size, encoding);
+    while (fixture_stream_next(&fs))
+        total += fs.remaining;
+    return total;
+}
+
+// Compare len bytes of VRAM snapshot against the next spans of the fixture
+static void
+compare_stream(compare_result_t *res, fixture_stream_t *fs, size_t base,
+               const uint8_t *got, size_t len)
+{
+    size_t pos = 0;
+    while (pos < len) {
+        if (fs->remaining == 0 && !fixture_stream_next(fs))
+            return;
+
+        size_t n = fs->remaining;
+        if (n > len - pos)
+            n = len - pos;
+
+        if (fs->literal) {
+            compare_block(res, base + pos, got + pos, fs->literal, n);
+            fs->literal += n;
+        } else {
+            compare_fill(res, base + pos, got + pos, fs->value, n);
+        }
+        fs->remaining -= n;
+        pos += n;
+    }
+}
+
+static void
+compare_report(ati_device_t *dev, const ati_surface_t *surf,
+               const compare_result_t *res, const char *fixture_name)
+{
+    error_printf("MISMATCH: %zu bytes differ\n", res->mismatch_count);
+    error_printf("First mismatch at byte offset 0x%zx:\n",
+                 res->first_mismatch);
+    error_printf("  Expected: 0x%02x\n", res->first_expected);
+    error_printf("  Got:      0x%02x\n", res->first_got);
+
+    size_t pixel_offset = res->first_mismatch / res->bypp;
+    error_printf("  Pixel at (%zu, %zu)\n", pixel_offset % res->width,
+                 pixel_offset / res->width);
+    error_printf("  Bounding box: (%u, %u) - (%u, %u)\n", res->min_x,
+                 res->min_y, res->max_x, res->max_y);
+
+    // Cards tested in parallel each get their own dump
+    char dump_path[256];
+    if (ati_dev_count > 1)
+        snprintf(dump_path, sizeof(dump_path), "failed/%s-card%d.rle",
+                 fixture_name, dev->index);
+    else
+        snprintf(dump_path, sizeof(dump_path), "failed/%s.rle", fixture_name);
+    error_set_pending_dump(dump_path, surf);
+}
+
+bool
+ati_surface_async_compare_fixture(ati_device_t *dev, const ati_surface_t *surf,
+                                  const char *fixture_name)
+{
+    // Fixtures are packed rows at the surface's depth, so every depth other
+    // than 32 bpp keeps its own set under a _<bpp>bpp suffix
+    char depth_name[128];
+    if (surf->bpp != 32) {
+        snprintf(depth_name, sizeof(depth_name), "%s_%ubpp", fixture_name,
+                 surf->bpp);
+        fixture_name = depth_name;
+    }
+
+    size_t fixture_size;
+    fixture_encoding_t encoding;
+    const uint8_t *fixture =
+        platform_get_fixture(fixture_name, &fixture_size, &encoding);
+
+    if (!fixture) {
+        error_printf("Fixture '%s' not found\n", fixture_name);
+        char path[256];
+        snprintf(path, sizeof(path), "fixtures/%s.rle", fixture_name);
+        error_set_pending_dump(path, surf);
+        return false;
+    }
+
+    // Fixtures hold packed rows of the surface
+    size_t row_bytes = surf->width * (surf->bpp / 8);
+    size_t surf_size = row_bytes * surf->height;
+    size_t decoded_size = fixture_decoded_size(fixture, fixture_size, encoding);
+    if (decoded_size != surf_size) {
+        error_printf("Fixture size mismatch: expected %zu (%ux%ux%u), got "
+                     "%zu\n", surf_size, surf->width, surf->height, surf->bpp,
+                     decoded_size);
+        platform_free_fixture(fixture);
+        return false;
+    }
+
+    // Snapshot the surface a band of rows at a time and diff it in RAM
+    // against the fixture's token stream
+    compare_result_t res;
+    fixture_stream_t fs;
+    compare_result_init(&res, surf);
+    fixture_stream_init(&fs, fixture, fixture_size, encoding);
+    uint32_t band = COMPARE_CHUNK_SIZE / surf->pitch;
+    for (uint32_t y = 0; y < surf->height; y += band) {
+        uint32_t rows = surf->height - y;
+        if (rows > band)
+            rows = band;
+        ati_vram_readback(dev, surf->offset + y * surf->pitch, dev->chunk,
+                          (rows - 1) * surf->pitch + row_bytes);
+        if (surf->pitch == row_bytes) {
+            compare_stream(&res, &fs, y * row_bytes, dev->chunk,
+                           rows * row_bytes);
+            continue;
         }
+        for (uint32_t i = 0; i < rows; i++)
+            compare_stream(&res, &fs, (y + i) * row_bytes,
+                           dev->chunk + i * surf->pitch, row_bytes);
     }
-    return CHIP_UNKNOWN;
+
+    if (res.mismatch_count > 0)
+        compare_report(dev, surf, &res, fixture_name);
+
+    platform_free_fixture(fixture);
+    return res.mismatch_count == 0;
 }
 
-static const char *
-get_chip_name(uint16_t device_id)
+bool
+ati_surface_compare_fixture(ati_device_t *dev, const ati_surface_t *surf,
+                            const char *fixture_name)
 {
-    for (int i = 0; chip_id_table[i].name != NULL; i++) {
-        if (chip_id_table[i].device_id == device_id) {
-            return chip_id_table[i].name;
-        }
-    }
-    return "Unknown ATI Device";
+    ati_wait_for_idle(dev);
+    return ati_surface_async_compare_fixture(dev, surf, fixture_name);
 }
 
-const char *
-ati_chip_family_name(ati_chip_family_t family)
+bool
+ati_screen_async_compare_fixture(ati_device_t *dev, const char *fixture_name)
 {
-    switch (family) {
-    case CHIP_R128:
-        return "R128";
-    case CHIP_R100:
-        return "R100";
-    default:
-        return "Unknown";
-    }
+    ati_surface_t screen = ati_screen_surface(dev);
+    return ati_surface_async_compare_fixture(dev, &screen, fixture_name);
+}
+
+bool
+ati_screen_compare_fixture(ati_device_t *dev, const char *fixture_name)
+{
+    ati_surface_t screen = ati_screen_surface(dev);
+    return ati_surface_compare_fixture(dev, &screen, fixture_name);
 }
 
 // ============================================================================
-// Device Structure
+// Solid Fills
 // ============================================================================
-
-struct ati_device {
-    platform_pci_device_t *pci_dev;
-    ati_chip_family_t family;
-    uint16_t device_id;
-    char name[256];
-    void *bar[NUM_BARS];
+// Clears are drawn by the 2D engine as a solid-brush PATCOPY rectangle, so a
+// full screen costs a few register writes and an idle wait rather than a CPU
+// pass over the aperture. Tests clear between draws and expect their engine
+// setup to survive, so every register the fill touches is put back
+// afterwards: the readable ones from a readback, the R100's write-only
+// DP_GUI_MASTER_CNTL and DST_PITCH_OFFSET from the last host write. The
+// live scissor (SC_TOP_LEFT/SC_BOTTOM_RIGHT) is write-only: it's left at
+// the full range. Colour compare is left disabled, as ati_init_gui_engine
+// sets it up.
+
+#define ROP3_PATCOPY 0xf0
+
+// Readable engine state that a fill clobbers. DP_DATATYPE and DP_MIX carry
+// everything GUI_MASTER_CNTL sets apart from the write-only bits.
+static const uint32_t fill_saved_regs[] = {
+    R128_DP_DATATYPE, // Same offset as R100_DP_DATATYPE
+    DP_MIX,
+    DP_CNTL,
+    DP_WRITE_MSK,
+    DP_BRUSH_FRGD_CLR,
+    DST_OFFSET,
+    DST_PITCH,
+    DST_X,
+    DST_Y,
+    DEFAULT_SC_BOTTOM_RIGHT,
+    AUX_SC_CNTL,
 };
+#define FILL_SAVED_REGS (sizeof(fill_saved_regs) / sizeof(fill_saved_regs[0]))
+// Room for the saved registers plus DP_GUI_MASTER_CNTL and the pitch/offsets
+#define GUI_SAVED_MAX(regs) ((regs) + GUI_WO_COUNT)
+
+static const uint32_t fill_sc_max = (0x1fff << DEFAULT_SC_RIGHT_SHIFT) |
+                                    (0x1fff << DEFAULT_SC_BOTTOM_SHIFT);
+
+// Save DP_GUI_MASTER_CNTL (and on the R100 the first wo_count write-only
+// pitch/offsets) ahead of the readable registers, so restoring it can't undo
+// the DP_DATATYPE and DP_MIX restored after it. Returns false if a
+// write-only register holds a value the host never saw, which the engine
+// mustn't clobber.
+static bool
+gui_save(ati_device_t *dev, int wo_count, const uint32_t *regs,
+         size_t reg_count, ati_reg_pair_t *saved, size_t *n)
+{
+    *n = 0;
+    if (dev->family == CHIP_R128) {
+        saved[(*n)++] = (ati_reg_pair_t) {
+            R128_DP_GUI_MASTER_CNTL,
+            ati_reg_read(dev, R128_DP_GUI_MASTER_CNTL)};
+    } else {
+        for (int i = 0; i < wo_count; i++) {
+            if (dev->gui_wo_state[i] == GUI_WO_UNKNOWN)
+                return false;
+            if (dev->gui_wo_state[i] == GUI_WO_KNOWN)
+                saved[(*n)++] = (ati_reg_pair_t) {gui_wo_regs[i],
+                                                  dev->gui_wo[i]};
+        }
+    }
+    for (size_t i = 0; i < reg_count; i++) {
+        saved[*n].offset = regs[i];
+        saved[*n].value = ati_reg_read(dev, regs[i]);
+        (*n)++;
+    }
+    return true;
+}
 
-ati_chip_family_t
-ati_get_chip_family(const ati_device_t *dev)
+static uint32_t
+fill_gmc(ati_device_t *dev)
 {
-    return dev->family;
+    if (dev->family == CHIP_R128)
+        return R128_GMC_DST_PITCH_OFFSET_CNTL |
+               R128_GMC_BRUSH_DATATYPE_SOLIDCOLOR |
+               ati_get_dst_datatype(32) | R128_GMC_SRC_DATATYPE_DST_COLOR |
+               R128_GMC_BYTE_PIX_ORDER | (ROP3_PATCOPY << R128_GMC_ROP3_SHIFT) |
+               R128_GMC_CLR_CMP_CNTL_DIS | R128_GMC_AUX_CLIP_DIS |
+               R128_GMC_WR_MSK_DIS;
+    return R100_GMC_DST_PITCH_OFFSET_CNTL |
+           R100_GMC_BRUSH_DATATYPE_SOLIDCOLOR | ati_get_dst_datatype(32) |
+           R100_GMC_SRC_DATATYPE_DST_COLOR | R100_GMC_BYTE_PIX_ORDER |
+           (ROP3_PATCOPY << R100_GMC_ROP3_SHIFT) | R100_GMC_CLR_CMP_FCN_DIS |
+           R100_GMC_WR_MSK_DIS;
 }
 
-// ============================================================================
-// Device Lifecycle
-// ============================================================================
+// Destination pitch/offset word as used by DST_PITCH_OFFSET and PAINT_MULTI
+static uint32_t
+fill_pitch_offset(ati_device_t *dev, uint32_t offset, uint32_t pitch)
+{
+    if (dev->family == CHIP_R128)
+        return ((pitch / 4 / 8) << 21) | (offset >> 5);
+    return ((pitch / 64) << 22) | (offset >> 10);
+}
 
-ati_device_t *
-ati_device_init(platform_pci_device_t *pci_dev)
+static bool
+fill_mmio(ati_device_t *dev, uint32_t offset, uint32_t pitch, uint32_t width,
+          uint32_t height, uint32_t color)
 {
-    static ati_device_t ati_dev;
-    ati_device_t *ati = &ati_dev;
+    ati_reg_pair_t saved[GUI_SAVED_MAX(FILL_SAVED_REGS)];
+    ati_reg_pair_t setup[9];
+    size_t saved_count;
+    size_t n = 0;
 
-    ati->pci_dev = pci_dev;
-    ati->device_id = platform_pci_get_device_id(pci_dev);
-    ati->family = detect_chip_family(ati->device_id);
-    ati->bar[0] = platform_pci_map_bar(ati->pci_dev, 0);
-    ati->bar[2] = platform_pci_map_bar(ati->pci_dev, 2);
-    platform_pci_get_name(ati->pci_dev, ati->name, sizeof(ati->name));
+    ati_wait_for_idle(dev);
+    if (!gui_save(dev, GUI_WO_SRC_PITCH_OFFSET, fill_saved_regs,
+                  FILL_SAVED_REGS, saved, &saved_count))
+        return false;
 
-    // Print device info
-    const char *color;
-    switch (ati->family) {
-    case CHIP_R128:
-        color = "\033[36m";  // cyan
-        break;
-    case CHIP_R100:
-        color = "\033[35m";  // magenta
-        break;
-    default:
-        color = "\033[31m";  // red
-        break;
+    setup[n++] = (ati_reg_pair_t) {DEFAULT_SC_BOTTOM_RIGHT, fill_sc_max};
+    setup[n++] = (ati_reg_pair_t) {AUX_SC_CNTL, 0};
+    setup[n++] = (ati_reg_pair_t) {DP_CNTL, DST_X_LEFT_TO_RIGHT |
+                                                DST_Y_TOP_TO_BOTTOM};
+    if (dev->family == CHIP_R128) {
+        setup[n++] = (ati_reg_pair_t) {R128_DP_GUI_MASTER_CNTL, fill_gmc(dev)};
+        setup[n++] = (ati_reg_pair_t) {DST_OFFSET, offset};
+        setup[n++] = (ati_reg_pair_t) {DST_PITCH, pitch / 4 / 8};
+    } else {
+        setup[n++] = (ati_reg_pair_t) {R100_DP_GUI_MASTER_CNTL, fill_gmc(dev)};
+        setup[n++] = (ati_reg_pair_t) {R100_DST_PITCH_OFFSET,
+                                       fill_pitch_offset(dev, offset, pitch)};
     }
-    printf("Detected: %s%s\033[0m [%04x] (%s%s\033[0m family)\n",
-           color, get_chip_name(ati->device_id),
-           ati->device_id,
-           color, ati_chip_family_name(ati->family));
+    setup[n++] = (ati_reg_pair_t) {DP_BRUSH_FRGD_CLR, color};
+    setup[n++] = (ati_reg_pair_t) {DST_Y_X, 0};
+    setup[n++] = (ati_reg_pair_t) {DST_WIDTH_HEIGHT, (width << 16) | height};
 
-    if (ati->family == CHIP_UNKNOWN) {
-        printf("WARNING: Unknown chip family, behavior may be unpredictable\n");
-    }
+    ati_reg_write_batch(dev, setup, n);
+    ati_reg_write_batch(dev, saved, saved_count);
+    ati_wait_for_idle(dev);
+    return true;
+}
 
-    return ati;
+// Same fill while the CCE owns the engine: MMIO writes to the GUI registers
+// are dropped, so the setup, PAINT_MULTI and restore all go in as packets.
+static bool
+fill_cce(ati_device_t *dev, uint32_t offset, uint32_t pitch, uint32_t width,
+         uint32_t height, uint32_t color)
+{
+    ati_reg_pair_t saved[GUI_SAVED_MAX(FILL_SAVED_REGS)];
+    uint32_t buf[4 + 6 + 2 * GUI_SAVED_MAX(FILL_SAVED_REGS)];
+    size_t saved_count;
+    cce_stream_t s;
+
+    ati_cce_wait_for_idle(dev);
+    if (!gui_save(dev, GUI_WO_SRC_PITCH_OFFSET, fill_saved_regs,
+                  FILL_SAVED_REGS, saved, &saved_count))
+        return false;
+
+    uint32_t gmc = fill_gmc(dev);
+    uint32_t pitch_offset = fill_pitch_offset(dev, offset, pitch);
+    cce_stream_init(&s, buf, sizeof(buf) / sizeof(buf[0]));
+    CCE_EMIT0(&s, DEFAULT_SC_BOTTOM_RIGHT, fill_sc_max);
+    CCE_EMIT0(&s, AUX_SC_CNTL, 0);
+    CCE_EMIT3(&s, CCE_CNTL_PAINT_MULTI, gmc, pitch_offset, color, 0,
+              (width << 16) | height);
+    for (size_t i = 0; i < saved_count; i++)
+        CCE_EMIT0(&s, saved[i].offset, saved[i].value);
+    ati_send_stream(dev, &s);
+    ati_cce_wait_for_idle(dev);
+
+    // Unlike a caller's packets, these are known to have left the
+    // write-only registers as the fill found them, or at the fill's values
+    // where the host had never set them
+    gui_wo_record(dev, R100_DP_GUI_MASTER_CNTL, gmc);
+    gui_wo_record(dev, R100_DST_PITCH_OFFSET, pitch_offset);
+    for (size_t i = 0; i < saved_count; i++)
+        gui_wo_record(dev, saved[i].offset, saved[i].value);
+    return true;
+}
+
+static void
+fill_cpu(ati_device_t *dev, uint32_t offset, uint32_t pitch, uint32_t width,
+         uint32_t height, uint32_t color)
+{
+    volatile uint8_t *vram = (volatile uint8_t *) dev->bar[0] + offset;
+
+    for (uint32_t y = 0; y < height; y++)
+        vram_set(dev, vram + (size_t) y * pitch, color, (size_t) width * 4);
+    dev->regs.wc_pending = dev->vram_wc;
 }
 
+// Fill a width x height rectangle of 32-bit pixels at a VRAM byte offset.
+// The engine path needs a 1 KB aligned offset, a pitch that's a multiple of
+// 64 bytes and coordinates inside the 13-bit scissor range; anything else,
+// a CCE in bus-master mode or R100 write-only engine state packets may have
+// changed, falls back to CPU stores of the full colour.
 void
-ati_device_destroy(ati_device_t *dev)
+ati_vram_fill(ati_device_t *dev, uint32_t offset, uint32_t pitch,
+              uint32_t width, uint32_t height, uint32_t color)
 {
-    if (!dev)
+    if (width == 0 || height == 0)
         return;
-    for (int i = 0; i < NUM_BARS; i++) {
-        if (dev->bar[i])
-            platform_pci_unmap_bar(dev->pci_dev, dev->bar[i], i);
+
+    bool engine_ok = (dev->family == CHIP_R128 || dev->family == CHIP_R100) &&
+                     (offset & 0x3ff) == 0 && (pitch & 0x3f) == 0 &&
+                     width <= 0x1fff && height <= 0x1fff;
+    cce_mode_t mode = engine_ok ? ati_cce_get_mode(dev) : CCE_MODE_BM;
+
+    // Pending CPU writes must land before the engine draws over them
+    vram_wc_flush(dev);
+
+    switch (mode) {
+    case CCE_MODE_OFF:
+        if (fill_mmio(dev, offset, pitch, width, height, color))
+            return;
+        break;
+    case CCE_MODE_PIO:
+        if (fill_cce(dev, offset, pitch, width, height, color))
+            return;
+        break;
+    case CCE_MODE_BM:
+        if (engine_ok)
+            ati_cce_wait_for_idle(dev);
+        break;
     }
-    platform_pci_destroy(dev->pci_dev);
+    fill_cpu(dev, offset, pitch, width, height, color);
 }
 
 // ============================================================================
-// Register and VRAM Access
+// Surface Blits
 // ============================================================================
+// A SRCCOPY rectangle through MMIO, with the same save/restore of engine
+// state as the fills, SRC_PITCH_OFFSET included. Overlapping copies within one surface pick the
+// scan direction so the source is read before it's overwritten.
+
+static const uint32_t blit_saved_regs[] = {
+    R128_DP_DATATYPE, // Same offset as R100_DP_DATATYPE
+    DP_MIX,
+    DP_CNTL,
+    DP_WRITE_MSK,
+    DST_OFFSET,
+    DST_PITCH,
+    DST_X,
+    DST_Y,
+    SRC_OFFSET,
+    SRC_PITCH,
+    SRC_X,
+    SRC_Y,
+    DEFAULT_SC_BOTTOM_RIGHT,
+    AUX_SC_CNTL,
+};
+#define BLIT_SAVED_REGS (sizeof(blit_saved_regs) / sizeof(blit_saved_regs[0]))
 
-static inline uint32_t
-reg_read(void *base, uint32_t offset)
+static uint32_t
+blit_gmc(ati_device_t *dev, uint32_t bpp)
 {
-    volatile uint32_t *reg = (volatile uint32_t *) ((char *) base + offset);
-    return *reg;
+    if (dev->family == CHIP_R128)
+        return R128_GMC_SRC_PITCH_OFFSET_CNTL |
+               R128_GMC_DST_PITCH_OFFSET_CNTL | R128_GMC_BRUSH_DATATYPE_NONE |
+               ati_get_dst_datatype(bpp) | R128_GMC_SRC_DATATYPE_DST_COLOR |
+               R128_GMC_BYTE_PIX_ORDER | R128_GMC_ROP3_SRCCOPY |
+               R128_GMC_SRC_SOURCE_MEMORY | R128_GMC_CLR_CMP_CNTL_DIS |
+               R128_GMC_AUX_CLIP_DIS | R128_GMC_WR_MSK_DIS;
+    // SOLIDCOLOR_ALT (15) is the R100's no-brush encoding
+    return R100_GMC_SRC_PITCH_OFFSET_CNTL | R100_GMC_DST_PITCH_OFFSET_CNTL |
+           R100_GMC_BRUSH_DATATYPE_SOLIDCOLOR_ALT | ati_get_dst_datatype(bpp) |
+           R100_GMC_SRC_DATATYPE_DST_COLOR | R100_GMC_BYTE_PIX_ORDER |
+           R100_GMC_ROP3_SRCCOPY | R100_GMC_SRC_SOURCE_MEMORY |
+           R100_GMC_CLR_CMP_FCN_DIS | R100_GMC_WR_MSK_DIS;
 }
 
-static inline void
-reg_write(void *base, uint32_t offset, uint32_t value)
+static bool
+blit_engine_ok(ati_device_t *dev, const ati_surface_t *surf, uint32_t x,
+               uint32_t y, uint32_t w, uint32_t h)
 {
-    volatile uint32_t *reg = (volatile uint32_t *) ((char *) base + offset);
-    *reg = value;
+    return (dev->family == CHIP_R128 || dev->family == CHIP_R100) &&
+           (surf->bpp == 8 || surf->bpp == 16 || surf->bpp == 32) &&
+           (surf->offset & 0x3ff) == 0 && (surf->pitch & 0x3f) == 0 &&
+           x + w <= 0x1fff && y + h <= 0x1fff;
 }
 
-uint32_t
-ati_reg_read(ati_device_t *dev, uint32_t offset)
+static bool
+blit_mmio(ati_device_t *dev, const ati_surface_t *dst, uint32_t dst_x,
+          uint32_t dst_y, const ati_surface_t *src, uint32_t src_x,
+          uint32_t src_y, uint32_t w, uint32_t h)
 {
-    return reg_read(dev->bar[2], offset);
-}
+    ati_reg_pair_t saved[GUI_SAVED_MAX(BLIT_SAVED_REGS)];
+    ati_reg_pair_t setup[10];
+    size_t saved_count;
+    size_t n = 0;
+    uint32_t bypp = dst->bpp / 8;
+    uint32_t dir = DST_X_LEFT_TO_RIGHT | DST_Y_TOP_TO_BOTTOM;
+
+    if (src->offset == dst->offset) {
+        if (src_y < dst_y) {
+            dir &= ~DST_Y_TOP_TO_BOTTOM;
+            src_y += h - 1;
+            dst_y += h - 1;
+        }
+        if (src_x < dst_x) {
+            dir &= ~DST_X_LEFT_TO_RIGHT;
+            src_x += w - 1;
+            dst_x += w - 1;
+        }
+    }
 
-void
-ati_reg_write(ati_device_t *dev, uint32_t offset, uint32_t value)
-{
-    reg_write(dev->bar[2], offset, value);
-}
+    ati_wait_for_idle(dev);
+    if (!gui_save(dev, GUI_WO_COUNT, blit_saved_regs, BLIT_SAVED_REGS, saved,
+                  &saved_count))
+        return false;
 
-uint32_t
-ati_vram_read(ati_device_t *dev, uint32_t offset)
-{
-    return reg_read(dev->bar[0], offset);
-}
+    setup[n++] = (ati_reg_pair_t) {DEFAULT_SC_BOTTOM_RIGHT, fill_sc_max};
+    setup[n++] = (ati_reg_pair_t) {AUX_SC_CNTL, 0};
+    setup[n++] = (ati_reg_pair_t) {DP_CNTL, dir};
+    if (dev->family == CHIP_R128) {
+        setup[n++] = (ati_reg_pair_t) {R128_DP_GUI_MASTER_CNTL,
+                                       blit_gmc(dev, dst->bpp)};
+        setup[n++] = (ati_reg_pair_t) {DST_OFFSET, dst->offset};
+        setup[n++] = (ati_reg_pair_t) {DST_PITCH, dst->pitch / bypp / 8};
+        setup[n++] = (ati_reg_pair_t) {SRC_OFFSET, src->offset};
+        setup[n++] = (ati_reg_pair_t) {SRC_PITCH, src->pitch / bypp / 8};
+    } else {
+        setup[n++] = (ati_reg_pair_t) {R100_DP_GUI_MASTER_CNTL,
+                                       blit_gmc(dev, dst->bpp)};
+        setup[n++] = (ati_reg_pair_t) {R100_DST_PITCH_OFFSET,
+            fill_pitch_offset(dev, dst->offset, dst->pitch)};
+        setup[n++] = (ati_reg_pair_t) {R100_SRC_PITCH_OFFSET,
+            fill_pitch_offset(dev, src->offset, src->pitch)};
+    }
+    setup[n++] = (ati_reg_pair_t) {SRC_Y_X, (src_y << 16) | src_x};
+    setup[n++] = (ati_reg_pair_t) {DST_Y_X, (dst_y << 16) | dst_x};
+    setup[n++] = (ati_reg_pair_t) {DST_WIDTH_HEIGHT, (w << 16) | h};
 
-void
-ati_vram_write(ati_device_t *dev, uint32_t offset, uint32_t value)
-{
-    reg_write(dev->bar[0], offset, value);
+    ati_reg_write_batch(dev, setup, n);
+    ati_reg_write_batch(dev, saved, saved_count);
+    ati_wait_for_idle(dev);
+    return true;
 }
 
-uint64_t
-ati_vram_search(ati_device_t *dev, uint32_t needle)
+// A row at a time through the staging buffer, bottom up when that keeps an
+// overlapping source intact
+static bool
+blit_cpu(ati_device_t *dev, const ati_surface_t *dst, uint32_t dst_x,
+         uint32_t dst_y, const ati_surface_t *src, uint32_t src_x,
+         uint32_t src_y, uint32_t w, uint32_t h)
 {
-    volatile uint32_t *vram = (volatile uint32_t *) dev->bar[0];
-    size_t vram_size = platform_pci_get_bar_size(dev->pci_dev, 0);
-    size_t dwords = vram_size / 4;
+    uint32_t bypp = dst->bpp / 8;
+    size_t row_bytes = (size_t) w * bypp;
+    bool up = src->offset == dst->offset && src_y < dst_y;
 
-    for (size_t i = 0; i < dwords; i++) {
-        if (vram[i] == needle) {
-            return (uint64_t) i * 4;
-        }
+    if (row_bytes > CHUNK_SIZE) {
+        printf("Blit rows of %u bytes don't fit the %u byte staging buffer\n",
+               (uint32_t) row_bytes, CHUNK_SIZE);
+        return false;
     }
-
-    return VRAM_NOT_FOUND;
+    for (uint32_t i = 0; i < h; i++) {
+        uint32_t y = up ? h - 1 - i : i;
+        ati_vram_readback(dev, src->offset + (src_y + y) * src->pitch +
+                                   src_x * bypp,
+                          dev->chunk, row_bytes);
+        ati_vram_upload(dev, dst->offset + (dst_y + y) * dst->pitch +
+                                 dst_x * bypp,
+                        dev->chunk, row_bytes);
+    }
+    return true;
 }
 
-void
-ati_vram_memcpy(ati_device_t *dev, uint32_t dst_offset, const void *src,
-                size_t size)
+bool
+ati_surface_blit(ati_device_t *dev, const ati_surface_t *dst, uint32_t dst_x,
+                 uint32_t dst_y, const ati_surface_t *src, uint32_t src_x,
+                 uint32_t src_y, uint32_t w, uint32_t h)
 {
-    size_t vram_size = platform_pci_get_bar_size(dev->pci_dev, 0);
-    if (size > vram_size) {
-        printf("Copying data larger than BAR0\n");
+    if (w == 0 || h == 0)
+        return true;
+    if (src->bpp != dst->bpp) {
+        printf("Blit between %u and %u bpp surfaces\n", src->bpp, dst->bpp);
+        return false;
+    }
+
+    // Neither engine draws 24 bpp on both chips, but a copy doesn't care
+    // where pixels start, so it's done as bytes three times as wide
+    ati_surface_t dst8, src8;
+    if (dst->bpp == 24) {
+        dst8 = (ati_surface_t) {dst->offset, dst->pitch, dst->width * 3,
+                                dst->height, 8};
+        src8 = (ati_surface_t) {src->offset, src->pitch, src->width * 3,
+                                src->height, 8};
+        dst = &dst8;
+        src = &src8;
+        dst_x *= 3;
+        src_x *= 3;
+        w *= 3;
     }
 
-    memcpy(dev->bar[0] + dst_offset, src, size);
+    bool engine_ok = blit_engine_ok(dev, dst, dst_x, dst_y, w, h) &&
+                     blit_engine_ok(dev, src, src_x, src_y, w, h);
+    cce_mode_t mode = engine_ok ? ati_cce_get_mode(dev) : CCE_MODE_BM;
+
+    vram_wc_flush(dev);
+    if (mode == CCE_MODE_OFF &&
+        blit_mmio(dev, dst, dst_x, dst_y, src, src_x, src_y, w, h))
+        return true;
+    if (engine_ok)
+        ati_cce_wait_for_idle(dev);
+    else
+        ati_wait_for_idle(dev);
+    return blit_cpu(dev, dst, dst_x, dst_y, src, src_x, src_y, w, h);
 }
 
-bool
-ati_screen_async_compare_fixture(ati_device_t *dev, const char *fixture_name)
+// ============================================================================
+// Surface Fills
+// ============================================================================
+
+// 24 bpp colours repeat every three dwords, which no 32-bit fill can draw.
+// They're written a row at a time from a pattern built in the staging
+// buffer, once the engine has finished with the surface.
+static bool
+fill_rgb888(ati_device_t *dev, const ati_surface_t *surf, uint32_t color)
 {
-    size_t fixture_size;
-    const uint8_t *fixture = platform_get_fixture(fixture_name, &fixture_size);
+    size_t row_bytes = (size_t) surf->width * 3;
 
-    if (!fixture) {
-        error_printf("Fixture '%s' not found\n", fixture_name);
-        char path[256];
-        snprintf(path, sizeof(path), "fixtures/%s.rle", fixture_name);
-        error_set_pending_dump(path);
+    if (row_bytes > CHUNK_SIZE) {
+        printf("Fill rows of %u bytes don't fit the %u byte staging buffer\n",
+               (uint32_t) row_bytes, CHUNK_SIZE);
         return false;
     }
-
-    size_t screen_size = 640 * 480 * 4;
-    if (fixture_size != screen_size) {
-        error_printf("Fixture size mismatch: expected %zu, got %zu\n",
-                     screen_size, fixture_size);
-        platform_free_fixture(fixture);
-        return false;
+    for (size_t i = 0; i < row_bytes; i += 3) {
+        dev->chunk[i] = color & 0xff;
+        dev->chunk[i + 1] = (color >> 8) & 0xff;
+        dev->chunk[i + 2] = (color >> 16) & 0xff;
     }
 
-    // Compare with current framebuffer
-    volatile uint8_t *vram = (volatile uint8_t *) dev->bar[0];
-    bool match = true;
-    int first_mismatch = -1;
-    int mismatch_count = 0;
-    for (size_t i = 0; i < screen_size; i++) {
-        if (vram[i] != fixture[i]) {
-            if (first_mismatch == -1) {
-                first_mismatch = i;
-            }
-            mismatch_count++;
-        }
-    }
-    if (mismatch_count > 0) {
-        match = false;
-        error_printf("MISMATCH: %d bytes differ\n", mismatch_count);
-        if (first_mismatch >= 0) {
-            error_printf("First mismatch at byte offset 0x%x:\n",
-                         first_mismatch);
-            error_printf("  Expected: 0x%02x\n", fixture[first_mismatch]);
-            error_printf("  Got:      0x%02x\n", vram[first_mismatch]);
-
-            int pixel_offset = first_mismatch / 4;
-            int y = pixel_offset / 640;
-            int x = pixel_offset % 640;
-            error_printf("  Pixel at (%d, %d)\n", x, y);
-        }
-        char dump_path[256];
-        snprintf(dump_path, sizeof(dump_path), "failed/%s.rle", fixture_name);
-        error_set_pending_dump(dump_path);
-    }
-    platform_free_fixture(fixture);
-    return match;
+    if (ati_cce_get_mode(dev) != CCE_MODE_OFF)
+        ati_cce_wait_for_idle(dev);
+    else
+        ati_wait_for_idle(dev);
+    for (uint32_t y = 0; y < surf->height; y++)
+        ati_vram_upload(dev, surf->offset + y * surf->pitch, dev->chunk,
+                        row_bytes);
+    return true;
 }
 
+// Fills work in 32-bit pixels, so narrower colours are repeated across the
+// dword. A row that isn't a whole number of dwords is rounded up into the
+// pitch padding every surface has past it.
 bool
-ati_screen_compare_fixture(ati_device_t *dev, const char *fixture_name)
+ati_surface_fill(ati_device_t *dev, const ati_surface_t *surf, uint32_t color)
 {
-    ati_wait_for_idle(dev);
-    return ati_screen_async_compare_fixture(dev, fixture_name);
+    switch (surf->bpp) {
+    case 8:
+        color = (color & 0xff) * 0x01010101;
+        break;
+    case 16:
+        color = (color & 0xffff) * 0x00010001;
+        break;
+    case 24:
+        // Greys are one byte repeated and fill like 8 bpp
+        color &= 0xffffff;
+        if (color != (color & 0xff) * 0x010101)
+            return fill_rgb888(dev, surf, color);
+        color = (color & 0xff) * 0x01010101;
+        break;
+    }
+    ati_vram_fill(dev, surf->offset, surf->pitch,
+                  (surf->width * (surf->bpp / 8) + 3) / 4, surf->height,
+                  color);
+    return true;
 }
 
 void
 ati_screen_clear(ati_device_t *dev, uint32_t color)
 {
-    size_t screen_size = 640 * 480 * 4;
-    memset(dev->bar[0], color, screen_size);
+    ati_surface_t screen = ati_screen_surface(dev);
+    ati_surface_fill(dev, &screen, color);
 }
 
+// Whole aperture, drawn as bands of VRAM_CLEAR_PITCH-byte rows
+#define VRAM_CLEAR_PITCH 8192
+#define VRAM_CLEAR_ROWS 4096
+
 void
 ati_vram_clear(ati_device_t *dev)
 {
-    size_t vram_size = platform_pci_get_bar_size(dev->pci_dev, 0);
-    memset(dev->bar[0], 0, vram_size);
+    size_t vram_size = dev->props.vram_aperture;
+    size_t rows = vram_size / VRAM_CLEAR_PITCH;
+    uint32_t offset = 0;
+
+    while (rows > 0) {
+        uint32_t band = rows > VRAM_CLEAR_ROWS ? VRAM_CLEAR_ROWS : rows;
+        ati_vram_fill(dev, offset, VRAM_CLEAR_PITCH, VRAM_CLEAR_PITCH / 4,
+                      band, 0);
+        offset += band * VRAM_CLEAR_PITCH;
+        rows -= band;
+    }
+    if (offset < vram_size)
+        fill_cpu(dev, offset, 0, (vram_size - offset) / 4, 1, 0);
 }
 
 void
 ati_vram_dump(ati_device_t *dev, const char *filename)
 {
     volatile uint32_t *vram = (volatile uint32_t *) dev->bar[0];
-    size_t vram_size = platform_pci_get_bar_size(dev->pci_dev, 0);
+    size_t vram_size = dev->props.vram_aperture;
     platform_write_file(filename, (void *) vram, vram_size);
 }
 
+// Packed surfaces (the screen in every mode) go out straight from the
+// aperture. Padded rows are packed through the staging buffer, which bounds
+// how big such a surface can be.
+void
+ati_surface_dump(ati_device_t *dev, const ati_surface_t *surf,
+                 const char *filename)
+{
+    uint8_t *vram = (uint8_t *) dev->bar[0] + surf->offset;
+    size_t row_bytes = surf->width * (surf->bpp / 8);
+    size_t size = row_bytes * surf->height;
+
+    if (surf->pitch == row_bytes) {
+        platform_write_file(filename, vram, size);
+        return;
+    }
+    if (size > CHUNK_SIZE) {
+        printf("Surface too large to pack for dumping (%zu bytes)\n", size);
+        return;
+    }
+    ati_vram_readback_rect(dev, surf->offset, surf->pitch, dev->chunk,
+                           row_bytes, row_bytes, surf->height);
+    platform_write_file(filename, dev->chunk, size);
+}
+
 void
 ati_screen_dump(ati_device_t *dev, const char *filename)
 {
-    volatile uint32_t *vram = (volatile uint32_t *) dev->bar[0];
-    size_t screen_size = 640 * 480 * 4;
-    platform_write_file(filename, (void *) vram, screen_size);
+    ati_surface_t screen = ati_screen_surface(dev);
+    ati_surface_dump(dev, &screen, filename);
 }
 
 void
@@ -338,106 +2276,61 @@ ati_print_info(ati_device_t *dev)
         break;
     }
 
-    size_t vram_size = platform_pci_get_bar_size(dev->pci_dev, 0);
-    size_t mmio_size = platform_pci_get_bar_size(dev->pci_dev, 2);
+    size_t vram_size = dev->props.vram_aperture;
+    size_t mmio_size = dev->props.mmio_size;
 
     printf("=== ATI Device ===\n");
     printf("Name:    %s%s\033[0m\n", color, get_chip_name(dev->device_id));
     printf("ID:      0x%04x\n", dev->device_id);
     printf("Family:  %s%s\033[0m\n", color, ati_chip_family_name(dev->family));
-    printf("VRAM:    %p (%zu MB)\n", dev->bar[0], vram_size / (1024 * 1024));
+    printf("VRAM:    %p (%zu MB, %s)\n", dev->bar[0], vram_size / (1024 * 1024),
+           dev->vram_wc ? "write-combined" : "uncached");
     printf("MMIO:    %p (%zu KB)\n", dev->bar[2], mmio_size / 1024);
-}
-
-// ============================================================================
-// Register Accessor Functions - Common Registers
-// ============================================================================
-
-/* Reads for common registers */
-#define X(func_name, const_name, offset, flags, fields, aliases)               \
-    uint32_t rd_##func_name(ati_device_t *dev)                                 \
-    {                                                                          \
-        return ati_reg_read(dev, const_name);                                  \
-    }
-COMMON_REGISTERS
-#undef X
-
-/* Writes for common registers */
-#define X(func_name, const_name, offset, flags, fields, aliases)               \
-    void wr_##func_name(ati_device_t *dev, uint32_t val)                       \
-    {                                                                          \
-        ati_reg_write(dev, const_name, val);                                   \
-    }
-COMMON_REGISTERS
-#undef X
-
-// ============================================================================
-// Register Accessor Functions - R128-Specific Registers
-// ============================================================================
-
-#ifdef R128_REGISTERS
-/* Reads for R128-specific registers (with chip guard) */
-#define X(func_name, const_name, offset, flags, fields, aliases)               \
-    uint32_t rd_##func_name(ati_device_t *dev)                                 \
-    {                                                                          \
-        if (dev->family != CHIP_R128) {                                        \
-            printf("ERROR: " #func_name " is R128-only (current: %s)\n",       \
-                   ati_chip_family_name(dev->family));                         \
-            return 0;                                                          \
-        }                                                                      \
-        return ati_reg_read(dev, const_name);                                  \
-    }
-R128_REGISTERS
-#undef X
-
-/* Writes for R128-specific registers (with chip guard) */
-#define X(func_name, const_name, offset, flags, fields, aliases)               \
-    void wr_##func_name(ati_device_t *dev, uint32_t val)                       \
-    {                                                                          \
-        if (dev->family != CHIP_R128) {                                        \
-            printf("ERROR: " #func_name " is R128-only (current: %s)\n",       \
-                   ati_chip_family_name(dev->family));                         \
-            return;                                                            \
-        }                                                                      \
-        ati_reg_write(dev, const_name, val);                                   \
+    printf("Regs:    %s%s\n", ati_reg_backend_name(dev->reg_backend),
+           dev->io_ok ? "" : " (no I/O BAR)");
+    printf("Memory:  %u MB\n", dev->props.vram_size / (1024 * 1024));
+    if (dev->family == CHIP_R100) {
+        uint32_t fb = dev->props.fb_location;
+        printf("FB:      0x%08x-0x%08x (aperture %u MB)\n", fb << 16,
+               (fb & 0xffff0000) | 0xffff, dev->props.aper_size / (1024 * 1024));
     }
-R128_REGISTERS
-#undef X
-#endif
+    printf("Mode:    %s\n", dev->mode->name);
+    uint32_t heap_free, heap_largest;
+    ati_vram_heap_usage(dev, &heap_free, &heap_largest);
+    printf("Heap:    0x%08x-0x%08x (%u KB free, largest %u KB, %zu blocks)\n",
+           dev->heap.start, dev->heap.end, heap_free / 1024,
+           heap_largest / 1024, dev->heap.count);
+}
 
 // ============================================================================
-// Register Accessor Functions - R100-Specific Registers
+// Checked Register Access
 // ============================================================================
+// Out-of-line half of the chip-specific rd_*/wr_* accessors, which are
+// generated inline in the register headers
 
-#ifdef R100_REGISTERS
-/* Reads for R100-specific registers (with chip guard) */
-#define X(func_name, const_name, offset, flags, fields, aliases)               \
-    uint32_t rd_##func_name(ati_device_t *dev)                                 \
-    {                                                                          \
-        if (dev->family != CHIP_R100) {                                        \
-            printf("ERROR: " #func_name " is R100-only (current: %s)\n",       \
-                   ati_chip_family_name(dev->family));                         \
-            return 0;                                                          \
-        }                                                                      \
-        return ati_reg_read(dev, const_name);                                  \
+uint32_t
+ati_reg_read_checked(ati_device_t *dev, ati_chip_family_t family,
+                     uint32_t offset, const char *name)
+{
+    if (dev->family != family) {
+        printf("ERROR: %s is %s-only (current: %s)\n", name,
+               ati_chip_family_name(family), ati_chip_family_name(dev->family));
+        return 0;
     }
-R100_REGISTERS
-#undef X
+    return ati_reg_read(dev, offset);
+}
 
-/* Writes for R100-specific registers (with chip guard) */
-#define X(func_name, const_name, offset, flags, fields, aliases)               \
-    void wr_##func_name(ati_device_t *dev, uint32_t val)                       \
-    {                                                                          \
-        if (dev->family != CHIP_R100) {                                        \
-            printf("ERROR: " #func_name " is R100-only (current: %s)\n",       \
-                   ati_chip_family_name(dev->family));                         \
-            return;                                                            \
-        }                                                                      \
-        ati_reg_write(dev, const_name, val);                                   \
+void
+ati_reg_write_checked(ati_device_t *dev, ati_chip_family_t family,
+                      uint32_t offset, uint32_t value, const char *name)
+{
+    if (dev->family != family) {
+        printf("ERROR: %s is %s-only (current: %s)\n", name,
+               ati_chip_family_name(family), ati_chip_family_name(dev->family));
+        return;
     }
-R100_REGISTERS
-#undef X
-#endif
+    ati_reg_write(dev, offset, value);
+}
 
 // ============================================================================
 // Register Dump Functions
@@ -515,8 +2408,10 @@ ati_get_bytes_per_pixel(ati_device_t *dev)
 // ============================================================================
 
 void
-ati_set_display_mode(ati_device_t *dev)
+ati_set_display_mode(ati_device_t *dev, const ati_display_mode_t *mode)
 {
+    dev->mode = mode;
+    ati_vram_heap_reset(dev);
     switch (dev->family) {
     case CHIP_R128:
         r128_set_display_mode(dev);
@@ -556,8 +2451,7 @@ ati_engine_flush(ati_device_t *dev)
     case CHIP_R128:
         ati_r128_engine_flush(dev); break;
     case CHIP_R100:
-        //ati_r100_wait_for_engine(dev);
-        break;
+        ati_r100_engine_flush(dev); break;
     case CHIP_UNKNOWN:
     default:
         break;
@@ -567,8 +2461,13 @@ ati_engine_flush(ati_device_t *dev)
 void
 ati_engine_reset(ati_device_t *dev)
 {
+    ati_shadow_invalidate(dev);
+    ati_fifo_credits_reset(dev);
     switch (ati_get_chip_family(dev)) {
     case CHIP_R128:
+        // The soft reset takes the CCE with it; reload rather than trust
+        // whatever the instruction RAM holds afterwards
+        ati_microcode_invalidate(dev);
         ati_r128_engine_reset(dev); break;
     case CHIP_R100:
         //ati_r100_engine_reset(dev);
@@ -582,29 +2481,78 @@ ati_engine_reset(ati_device_t *dev)
 void
 ati_reset_for_test(ati_device_t *dev)
 {
-    // Stop CCE engine if it was running (restores standard PIO mode)
-    ati_stop_cce_engine(dev);
+    bool baseline = ati_snapshot_valid(&dev->baseline);
+
+    // Stop the CCE if the last test left it running (on the R128 that
+    // resets the engine too)
+    if (ati_cce_get_mode(dev) != CCE_MODE_OFF)
+        ati_stop_cce_engine(dev);
+    // With the CCE stopped nothing fetches from the shared GART buffers, so
+    // a test that failed before releasing them doesn't keep them from the
+    // other devices
+    ati_r128_gart_release(dev);
+    ati_r100_gart_release(dev);
+
+    // Restoring the baseline undoes whatever the last test changed, so the
+    // engine is only reset when it's hung or there's nothing to restore
+    if (!ati_wait_for_idle(dev) || !baseline) {
+        ati_engine_reset(dev);
+        ati_wait_for_idle(dev);
+    }
+    // Surfaces don't outlive the test that allocated them
+    ati_vram_heap_reset(dev);
+
+    if (baseline) {
+        ati_restore_test_state(dev, NULL);
+    } else {
+        ati_init_gui_engine(dev);
+        ati_screen_clear(dev, 0);
+    }
+}
 
-    ati_engine_reset(dev);
-    ati_wait_for_idle(dev);
-    ati_screen_clear(dev, 0);
+// Write-only registers can't be read back, so after capturing everything
+// readable the engine setup is replayed once to record what it writes to
+// them. No VRAM is kept: the visible framebuffer is far bigger than a
+// snapshot holds, and tests start from a black screen anyway.
+void
+ati_capture_test_state(ati_device_t *dev)
+{
+    if (!ati_snapshot_capture(dev, &dev->baseline, NULL, 0))
+        return;
+    dev->recording = &dev->baseline;
+    reg_fast_update(dev);
     ati_init_gui_engine(dev);
+    dev->recording = NULL;
+    reg_fast_update(dev);
+}
+
+void
+ati_restore_test_state(ati_device_t *dev, ati_snapshot_stats_t *stats)
+{
+    ati_snapshot_restore(dev, &dev->baseline, stats);
+    // After the restore, so the engine clear starts from and puts back the
+    // baseline state
+    ati_screen_clear(dev, 0);
 }
 
 void
 ati_wait_for_reg_value(ati_device_t *dev, uint32_t reg, uint32_t value)
 {
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
     uint32_t prev = ati_reg_read(dev, reg);
-    uint32_t timeout = 1000000;
-    while (timeout--) {
+    ati_wait_begin(&w, &site, ATI_WAIT_ENGINE_US);
+    do {
         uint32_t next = ati_reg_read(dev, reg);
         if (next != prev) {
             printf("0x%x => 0x%x\n", prev, next);
         }
         if (next == value) {
+            ati_wait_end(&w, true);
             return;
         }
-    }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
     // Timed out
     printf("ati_wait_for_value timed out! (waiting for 0x%x on reg 0x%x)\n", value, reg);
 }
@@ -612,41 +2560,46 @@ ati_wait_for_reg_value(ati_device_t *dev, uint32_t reg, uint32_t value)
 void
 ati_wait_for_fifo(ati_device_t *dev, uint32_t entries)
 {
+    if (dev->regs.fifo_credits >= entries && !dev->fifo_credits_suspended)
+        return;
+
+    uint32_t slots = 0;
     switch (ati_get_chip_family(dev)) {
     case CHIP_R128:
-        ati_r128_wait_for_fifo(dev, entries); break;
+        slots = ati_r128_wait_for_fifo(dev, entries); break;
     case CHIP_R100:
-        //ati_r100_wait_for_fifo(dev);
-        break;
+        slots = ati_r100_wait_for_fifo(dev, entries); break;
     case CHIP_UNKNOWN:
     default:
         break;
     }
+    if (!dev->fifo_credits_suspended)
+        dev->regs.fifo_credits = slots < FIFO_MAX ? slots : FIFO_MAX;
 }
 
-void
+static bool
 ati_wait_for_engine(ati_device_t *dev)
 {
     switch (ati_get_chip_family(dev)) {
     case CHIP_R128:
-        ati_r128_wait_for_engine(dev); break;
+        return ati_r128_wait_for_engine(dev);
     case CHIP_R100:
-        //ati_r100_wait_for_engine(dev);
-        break;
+        return ati_r100_wait_for_engine(dev);
     case CHIP_UNKNOWN:
     default:
-        break;
+        return false;
     }
 }
 
-void
+bool
 ati_wait_for_idle(ati_device_t *dev)
 {
     // Wait for FIFO to be completely empty
     ati_wait_for_fifo(dev, FIFO_MAX);
 
-    ati_wait_for_engine(dev);
+    bool idle = ati_wait_for_engine(dev);
 
     // Flush pixel cache
     ati_engine_flush(dev);
+    return idle;
 }
@@ -28,12 +28,10 @@ const char *ati_chip_family_name(ati_chip_family_t family);
 // Device Constants
 // ============================================================================
 
-#define X_RES 640
-#define Y_RES 480
-#define BPP 32
-#define BYPP (BPP / 8)
 #define FIFO_MAX 64
+#define REG_APERTURE_SIZE 0x2000
 #define VRAM_NOT_FOUND UINT64_MAX
+#define VRAM_SEARCH_MAX_NEEDLES 8
 
 // ============================================================================
 // Device Structure
@@ -41,34 +39,276 @@ const char *ati_chip_family_name(ati_chip_family_t family);
 
 typedef struct ati_device ati_device_t;
 
+// VRAM search pattern: a dword matches when (dword & mask) == value
+typedef struct {
+    uint32_t value;
+    uint32_t mask;
+} ati_vram_needle_t;
+
 // Get chip family for a device
 ati_chip_family_t ati_get_chip_family(const ati_device_t *dev);
 
+// ============================================================================
+// Display Modes
+// ============================================================================
+
+// A scanout mode. Timings are in pixels and lines, VESA DMT values. The
+// pixel clock is what the mode calls for; the PLL is left as the BIOS set
+// it, so on real hardware the refresh rate is only nominal.
+typedef struct {
+    const char *name; // "<width>x<height>x<bpp>"
+    uint32_t width;
+    uint32_t height;
+    uint32_t bpp;
+    uint32_t pitch; // Bytes per scanline, a multiple of 64
+    uint32_t pixel_clock_khz;
+    uint32_t h_total, h_sync_start, h_sync_width;
+    uint32_t v_total, v_sync_start, v_sync_width;
+    bool h_sync_neg, v_sync_neg;
+} ati_display_mode_t;
+
+// Table of supported modes, terminated by an entry with a NULL name. The
+// first entry (640x480x32) is the default that fixtures are captured in.
+extern const ati_display_mode_t ati_display_modes[];
+#define ATI_DEFAULT_MODE (&ati_display_modes[0])
+
+const ati_display_mode_t *ati_find_display_mode(const char *name);
+const ati_display_mode_t *ati_get_display_mode(const ati_device_t *dev);
+
+// ============================================================================
+// Surfaces
+// ============================================================================
+
+// A rectangle of pixels somewhere in VRAM. The visible framebuffer is one;
+// offscreen ones come from the VRAM heap (see surface.h).
+typedef struct {
+    uint32_t offset; // VRAM byte offset
+    uint32_t pitch;  // Bytes per row
+    uint32_t width;  // Pixels
+    uint32_t height;
+    uint32_t bpp;
+} ati_surface_t;
+
+// The visible area in the current mode
+ati_surface_t ati_screen_surface(const ati_device_t *dev);
+
 // ============================================================================
 // Device Lifecycle
 // ============================================================================
 
 ati_device_t *ati_device_init(platform_pci_device_t *pci_dev);
 void ati_device_destroy(ati_device_t *dev);
+// True if the PCI device is a chip this driver knows
+bool ati_device_supported(platform_pci_device_t *pci_dev);
+// Devices initialised so far, and each one's position among them
+int ati_device_count(void);
+int ati_device_index(const ati_device_t *dev);
+const char *ati_device_location(const ati_device_t *dev);
+
+// Layout properties, probed once by ati_device_init. Sizing a BAR costs
+// config-space cycles on bare metal, so hot paths read these instead.
+typedef struct {
+    size_t vram_aperture; // BAR0 size
+    size_t mmio_size;     // BAR2 size
+    uint32_t vram_size;   // CONFIG_MEMSIZE
+    uint32_t aper_size;   // R100 CONFIG_APER_SIZE, 0 on R128
+    uint32_t fb_location; // R100 MC_FB_LOCATION, 0 on R128
+} ati_device_props_t;
+
+const ati_device_props_t *ati_device_props(const ati_device_t *dev);
+// Probe the properties again, printing any that changed. Returns true if
+// the layout changed.
+bool ati_device_reprobe(ati_device_t *dev);
 
 // ============================================================================
 // Register and VRAM Access
 // ============================================================================
 
-uint32_t ati_reg_read(ati_device_t *dev, uint32_t offset);
-void ati_reg_write(ati_device_t *dev, uint32_t offset, uint32_t value);
+// The part of the device that register accesses touch on every call. It
+// leads ati_device_t, so the inline accessors below reach it through the
+// device pointer without a call.
+typedef struct {
+    volatile uint8_t *mmio; // BAR2
+    // Set while a register access needs nothing but the MMIO load or store
+    // and the bookkeeping below: registers reached through BAR2, and no
+    // shadow cache or snapshot recording to consult. Builds with the MMIO
+    // trace always take the out-of-line path.
+    bool fast;
+    bool wc_pending; // CPU writes to VRAM may still sit in WC buffers
+    // GUI FIFO slots known to be free. Refreshed by ati_wait_for_fifo and
+    // spent by every register write, so it never overestimates.
+    uint32_t fifo_credits;
+    // Registers whose writes have side effects on the driver's own state
+    // (MM_INDEX/MM_DATA, microcode RAM, write-only GUI registers), by dword
+    uint32_t slow_writes[REG_APERTURE_SIZE / 128];
+    // Per-register access counts since the last ati_reg_stats_reset
+    uint32_t reads[REG_APERTURE_SIZE / 4];
+    uint32_t writes[REG_APERTURE_SIZE / 4];
+} ati_reg_fast_t;
+
+uint32_t ati_reg_read_slow(ati_device_t *dev, uint32_t offset);
+void ati_reg_write_slow(ati_device_t *dev, uint32_t offset, uint32_t value);
+
+static inline uint32_t
+ati_reg_read(ati_device_t *dev, uint32_t offset)
+{
+#ifndef ATI_MMIO_TRACE
+    ati_reg_fast_t *regs = (ati_reg_fast_t *) dev;
+    if (regs->fast && offset < REG_APERTURE_SIZE) {
+        regs->reads[offset / 4]++;
+        return *(volatile uint32_t *) (regs->mmio + offset);
+    }
+#endif
+    return ati_reg_read_slow(dev, offset);
+}
+
+static inline void
+ati_reg_write(ati_device_t *dev, uint32_t offset, uint32_t value)
+{
+#ifndef ATI_MMIO_TRACE
+    ati_reg_fast_t *regs = (ati_reg_fast_t *) dev;
+    if (regs->fast && offset < REG_APERTURE_SIZE &&
+        !(regs->slow_writes[offset / 128] & (1u << ((offset / 4) & 31)))) {
+        if (regs->wc_pending) {
+            __sync_synchronize();
+            regs->wc_pending = false;
+        }
+        if (regs->fifo_credits)
+            regs->fifo_credits--;
+        regs->writes[offset / 4]++;
+        *(volatile uint32_t *) (regs->mmio + offset) = value;
+        return;
+    }
+#endif
+    ati_reg_write_slow(dev, offset, value);
+}
+// Every ati_reg_read/ati_reg_write (and so every rd_*/wr_* accessor) is
+// counted per dword offset across the register aperture
+void ati_reg_stats_reset(ati_device_t *dev);
+void ati_reg_stats_get(const ati_device_t *dev, uint32_t offset,
+                       uint32_t *reads, uint32_t *writes);
+
+// Opt-in shadow cache for registers flagged `shadow` in the YAML
+typedef struct {
+    uint32_t read_hits;   // Reads served from the cache
+    uint32_t read_misses; // Reads that went to the hardware and filled it
+    uint32_t write_drops; // Writes skipped because the value was unchanged
+    uint32_t writes;      // Writes to shadowed registers that went through
+} ati_shadow_stats_t;
+
+void ati_shadow_enable(ati_device_t *dev, bool enable);
+bool ati_shadow_is_enabled(const ati_device_t *dev);
+void ati_shadow_invalidate(ati_device_t *dev);
+void ati_shadow_suspend(ati_device_t *dev, bool suspend);
+void ati_shadow_get_stats(const ati_device_t *dev, ati_shadow_stats_t *out);
+void ati_shadow_reset_stats(ati_device_t *dev);
+
+// How ati_reg_read/ati_reg_write (and so every rd_*/wr_* accessor) reach
+// the registers. VRAM always goes through BAR0. The indexed backends move
+// MM_INDEX, so tests that drive MM_INDEX/MM_DATA themselves assume MMIO.
+typedef enum {
+    ATI_REG_MMIO,     // BAR2, the default
+    ATI_REG_IO,       // I/O BAR: 0x00-0xff directly, the rest indexed
+    ATI_REG_INDIRECT, // MM_INDEX/MM_DATA in BAR2
+} ati_reg_backend_t;
+
+const char *ati_reg_backend_name(ati_reg_backend_t backend);
+ati_reg_backend_t ati_reg_get_backend(const ati_device_t *dev);
+// Fails, leaving the backend as it was, without a usable I/O BAR
+bool ati_reg_set_backend(ati_device_t *dev, ati_reg_backend_t backend);
+
+// Write a list of registers in order. Free GUI FIFO slots are tracked as
+// credits so the status register is only polled when they run out. While
+// the CCE takes PIO packets, the writes go in as type-0 packets instead.
+typedef struct {
+    uint32_t offset;
+    uint32_t value;
+} ati_reg_pair_t;
+
+void ati_reg_write_batch(ati_device_t *dev, const ati_reg_pair_t *pairs,
+                         size_t count);
+// Drop cached FIFO credits. Suspended while something other than the host
+// (the CCE) feeds the FIFO.
+void ati_fifo_credits_reset(ati_device_t *dev);
+void ati_fifo_credits_suspend(ati_device_t *dev, bool suspend);
+// The R100's DP_GUI_MASTER_CNTL and SRC/DST_PITCH_OFFSET are write-only, so
+// the last host write to each is kept for fills and blits to put back.
+// Packets can change them behind the host's back: after this, fills and
+// blits leave the engine alone until the host writes them again.
+void ati_gui_wo_invalidate(ati_device_t *dev);
+
 uint32_t ati_vram_read(ati_device_t *dev, uint32_t offset);
 void ati_vram_write(ati_device_t *dev, uint32_t offset, uint32_t value);
+
+// Bulk aperture copies. VRAM offsets and pitches must be dword aligned; the
+// system RAM side may have any alignment. Transfers are as wide as the
+// device's copy width allows once the VRAM address is aligned for it, and
+// the aperture only ever sees whole-dword accesses (a ragged tail is read,
+// merged and written back as a dword).
+typedef enum {
+    ATI_VRAM_DWORD, // 32-bit loads and stores
+    ATI_VRAM_QWORD, // 64-bit, on 64-bit hosts
+    ATI_VRAM_SSE,   // 128-bit, where the build has SSE2
+} ati_vram_width_t;
+
+const char *ati_vram_width_name(ati_vram_width_t width);
+// The widest transfer this build supports, which devices start with
+ati_vram_width_t ati_vram_widest(void);
+// Cap transfers at width. Returns the width in effect, which is narrower
+// if the build can't do it.
+ati_vram_width_t ati_vram_set_copy_width(ati_device_t *dev,
+                                         ati_vram_width_t width);
+void ati_vram_upload(ati_device_t *dev, uint32_t offset, const void *src,
+                     size_t size);
+void ati_vram_readback(ati_device_t *dev, uint32_t offset, void *dst,
+                       size_t size);
+// Store a dword pattern over size bytes with the CPU
+void ati_vram_set(ati_device_t *dev, uint32_t offset, uint32_t value,
+                  size_t size);
+// height rows of row_bytes each, pitch bytes apart in VRAM and src_pitch
+// (dst_pitch) bytes apart in system RAM
+void ati_vram_upload_rect(ati_device_t *dev, uint32_t offset, uint32_t pitch,
+                          const void *src, size_t src_pitch, size_t row_bytes,
+                          uint32_t height);
+void ati_vram_readback_rect(ati_device_t *dev, uint32_t offset,
+                            uint32_t pitch, void *dst, size_t dst_pitch,
+                            size_t row_bytes, uint32_t height);
+size_t ati_vram_aperture_size(ati_device_t *dev);
+bool ati_vram_is_write_combining(const ati_device_t *dev);
+bool ati_vram_set_write_combining(ati_device_t *dev, bool enable);
 uint64_t ati_vram_search(ati_device_t *dev, uint32_t needle);
+size_t ati_vram_search_range(ati_device_t *dev, const ati_vram_needle_t *needles,
+                             size_t count, uint32_t start, uint32_t end,
+                             uint32_t *hits, size_t max_hits);
+void ati_vram_fill(ati_device_t *dev, uint32_t offset, uint32_t pitch,
+                   uint32_t width, uint32_t height, uint32_t color);
 void ati_vram_clear(ati_device_t *dev);
 void ati_screen_clear(ati_device_t *dev, uint32_t color);
 void ati_vram_dump(ati_device_t *dev, const char *filename);
 void ati_screen_dump(ati_device_t *dev, const char *filename);
-void ati_vram_memcpy(ati_device_t *dev, uint32_t dst_offset, const void *src,
-                     size_t size);
 bool ati_screen_async_compare_fixture(ati_device_t *dev,
                                       const char *fixture_name);
 bool ati_screen_compare_fixture(ati_device_t *dev, const char *fixture_name);
+// The screen versions above work on ati_screen_surface(). Fixtures and dumps
+// hold packed rows of width * bpp / 8 bytes whatever the surface pitch.
+// Fills fail only on 24 bpp rows wider than the staging buffer, which
+// non-grey colours are written through.
+bool ati_surface_fill(ati_device_t *dev, const ati_surface_t *surf,
+                      uint32_t color);
+void ati_surface_dump(ati_device_t *dev, const ati_surface_t *surf,
+                      const char *filename);
+bool ati_surface_async_compare_fixture(ati_device_t *dev,
+                                       const ati_surface_t *surf,
+                                       const char *fixture_name);
+bool ati_surface_compare_fixture(ati_device_t *dev, const ati_surface_t *surf,
+                                 const char *fixture_name);
+// Engine SRCCOPY of a w x h rectangle between surfaces of the same depth.
+// Like fills, the engine state it touches is put back afterwards. Falls back
+// to CPU copies when the engine can't reach the surfaces or the CCE owns it.
+// Fails on mismatched depths or CPU copy rows wider than the staging buffer.
+bool ati_surface_blit(ati_device_t *dev, const ati_surface_t *dst,
+                      uint32_t dst_x, uint32_t dst_y, const ati_surface_t *src,
+                      uint32_t src_x, uint32_t src_y, uint32_t w, uint32_t h);
 void ati_print_info(ati_device_t *dev);
 
 // ============================================================================
@@ -77,14 +317,18 @@ void ati_print_info(ati_device_t *dev);
 
 void ati_dump_all_registers(ati_device_t *dev);
 void ati_dump_registers(ati_device_t *dev, int count, ...);
-void ati_set_display_mode(ati_device_t *dev);
+// Program the CRTC for a mode and make it the device's current mode, which
+// screen clears, dumps and fixture compares follow. Run ati_init_gui_engine
+// afterwards so the engine's default pitch and datatype match.
+void ati_set_display_mode(ati_device_t *dev, const ati_display_mode_t *mode);
 void ati_init_gui_engine(ati_device_t *dev);
 void ati_engine_flush(ati_device_t *dev);
 void ati_engine_reset(ati_device_t *dev);
 void ati_reset_for_test(ati_device_t *dev);
 void ati_wait_for_reg_value(ati_device_t *dev, uint32_t reg, uint32_t value);
 void ati_wait_for_fifo(ati_device_t *dev, uint32_t entries);
-void ati_wait_for_idle(ati_device_t *dev);
+// False if the engine was still busy when the wait timed out
+bool ati_wait_for_idle(ati_device_t *dev);
 
 // clang-format off
 #define DUMP_REGISTERS(dev, ...) \
@@ -92,13 +336,62 @@ void ati_wait_for_idle(ati_device_t *dev);
     sizeof((uint32_t[]){__VA_ARGS__})/sizeof(uint32_t), \
     __VA_ARGS__)
 
+// ============================================================================
+// Register Accessors
+// ============================================================================
+// The register headers below generate a static inline rd_<name>/wr_<name>
+// pair for every register. Common registers go straight to
+// ati_reg_read/ati_reg_write. Chip-specific ones (r128_/r100_ prefix) check
+// the device family first and print an error on a mismatch.
+//
+// Single-chip firmware (make CHIP=r128 or CHIP=r100) defines ATI_CHIP_FAMILY.
+// Accessors for that family then skip the check entirely; the other family's
+// accessors keep it.
+//
+// ati_reg_read/ati_reg_write are inline too: with plain MMIO they load or
+// store straight through BAR2, and only call out for the I/O and indirect
+// backends, the shadow cache, snapshot recording or the trace.
+
+uint32_t ati_reg_read_checked(ati_device_t *dev, ati_chip_family_t family,
+                              uint32_t offset, const char *name);
+void ati_reg_write_checked(ati_device_t *dev, ati_chip_family_t family,
+                           uint32_t offset, uint32_t value, const char *name);
+
+static inline uint32_t
+ati_chip_reg_read(ati_device_t *dev, ati_chip_family_t family,
+                  uint32_t offset, const char *name)
+{
+#ifdef ATI_CHIP_FAMILY
+    if (family == ATI_CHIP_FAMILY)
+        return ati_reg_read(dev, offset);
+#endif
+    return ati_reg_read_checked(dev, family, offset, name);
+}
+
+static inline void
+ati_chip_reg_write(ati_device_t *dev, ati_chip_family_t family,
+                   uint32_t offset, uint32_t value, const char *name)
+{
+#ifdef ATI_CHIP_FAMILY
+    if (family == ATI_CHIP_FAMILY) {
+        ati_reg_write(dev, offset, value);
+        return;
+    }
+#endif
+    ati_reg_write_checked(dev, family, offset, value, name);
+}
+
 // ============================================================================
 // Generated Register Definitions
 // ============================================================================
-// Include generated register constants, field enums, and field tables.
-// Field values are PRE-SHIFTED and can be ORed directly into register values.
+// Include generated register constants, field enums, field tables and
+// accessors. Field values are PRE-SHIFTED and can be ORed directly into
+// register values.
 // Example: reg |= GMC_BRUSH_DATATYPE_SOLIDCOLOR | GMC_ROP3_SRCCOPY;
 
+// Accessors are only emitted when the helpers above are in scope
+#define ATI_REG_ACCESSORS
+
 // Common registers - shared between R128 and R100
 #include "registers/common_regs_gen.h"
 
@@ -106,60 +399,6 @@ void ati_wait_for_idle(ati_device_t *dev);
 #include "registers/r128_regs_gen.h"
 #include "registers/r100_regs_gen.h"
 
-// ============================================================================
-// Read/Write Function Declarations - Common Registers
-// ============================================================================
-// These use the COMMON_REGISTERS macro from common_regs_gen.h.
-// Common register accessors have no prefix.
-
-// Read functions for common registers
-#define X(func_name, const_name, offset, flags, fields, aliases) \
-  uint32_t rd_##func_name(ati_device_t *dev);
-COMMON_REGISTERS
-#undef X
-
-// Write functions for common registers
-#define X(func_name, const_name, offset, flags, fields, aliases) \
-  void wr_##func_name(ati_device_t *dev, uint32_t val);
-COMMON_REGISTERS
-#undef X
-
-// ============================================================================
-// Read/Write Function Declarations - R128-Specific Registers
-// ============================================================================
-// R128-specific register accessors have r128_ prefix.
-// They will assert if called on non-R128 hardware.
-
-#ifdef R128_REGISTERS
-#define X(func_name, const_name, offset, flags, fields, aliases) \
-  uint32_t rd_##func_name(ati_device_t *dev);
-R128_REGISTERS
-#undef X
-
-#define X(func_name, const_name, offset, flags, fields, aliases) \
-  void wr_##func_name(ati_device_t *dev, uint32_t val);
-R128_REGISTERS
-#undef X
-#endif
-
-// ============================================================================
-// Read/Write Function Declarations - R100-Specific Registers
-// ============================================================================
-// R100-specific register accessors have r100_ prefix.
-// They will assert if called on non-R100 hardware.
-
-#ifdef R100_REGISTERS
-#define X(func_name, const_name, offset, flags, fields, aliases) \
-  uint32_t rd_##func_name(ati_device_t *dev);
-R100_REGISTERS
-#undef X
-
-#define X(func_name, const_name, offset, flags, fields, aliases) \
-  void wr_##func_name(ati_device_t *dev, uint32_t val);
-R100_REGISTERS
-#undef X
-#endif
-
 // ============================================================================
 // Helper Functions
 // ============================================================================
@@ -3,26 +3,106 @@
 #include "r128_cce.h"
 #include "r100_cce.h"
 
+// FNV-1a over the family's built-in image
+static uint32_t
+microcode_hash(uint64_t (*inst)(uint8_t))
+{
+    uint32_t hash = 2166136261u;
+    for (uint32_t addr = 0; addr < 256; addr++) {
+        uint64_t v = inst(addr);
+        for (int i = 0; i < 8; i++) {
+            hash ^= (uint8_t) (v >> (i * 8));
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
+
+// Whether the instruction RAM still holds the image with this hash. The
+// hash only says what was uploaded; the readback catches anything that
+// changed it since without going through the register writes.
+static bool
+microcode_resident(ati_device_t *dev, ati_microcode_state_t *state,
+                   uint32_t hash, uint64_t (*inst)(uint8_t))
+{
+    if (!state->valid || state->hash != hash)
+        return false;
+
+    for (int i = 0; i < ATI_MICROCODE_SAMPLES; i++) {
+        // 37 is odd, so the samples walk all 256 addresses in turn
+        uint8_t addr = state->next_sample;
+        state->next_sample += 37;
+        uint64_t got;
+        if (!ati_read_microcode(dev, addr, &got) || got != inst(addr)) {
+            state->mismatches++;
+            return false;
+        }
+    }
+    return true;
+}
+
 bool
 ati_init_cce_engine(ati_device_t *dev, uint32_t mode)
 {
+    uint64_t (*inst)(uint8_t);
+    void (*load)(ati_device_t *);
+    void (*init)(ati_device_t *, uint32_t);
+
     switch (ati_get_chip_family(dev)) {
     case CHIP_R128:
-        ati_r128_init_cce_engine(dev, mode); break;
+        inst = ati_r128_microcode_inst;
+        load = ati_r128_load_microcode;
+        init = ati_r128_init_cce_engine;
+        break;
     case CHIP_R100:
-        ati_r100_init_cce_engine(dev, mode);
+        inst = ati_r100_microcode_inst;
+        load = ati_r100_load_microcode;
+        init = ati_r100_init_cce_engine;
         break;
     case CHIP_UNKNOWN:
     default:
         return false;
         break;
     }
+
+    ati_shadow_invalidate(dev);
+    ati_microcode_state_t *state = ati_device_microcode(dev);
+    uint32_t hash = microcode_hash(inst);
+    ati_wait_for_idle(dev);
+    if (microcode_resident(dev, state, hash, inst)) {
+        state->skips++;
+    } else {
+        load(dev);
+        // The upload's own writes invalidated the state
+        state->valid = true;
+        state->hash = hash;
+        state->loads++;
+    }
+
+    init(dev, mode);
     return true;
 }
 
+// The buffer mode nibble uses the same layout on both chips: zero is
+// non-PM4, and every mode with a PIO primary queue has bit 28 set.
+static cce_mode_t
+cce_mode_from_nibble(uint32_t mode)
+{
+    if (mode == 0)
+        return CCE_MODE_OFF;
+    return (mode & (1u << 28)) ? CCE_MODE_PIO : CCE_MODE_BM;
+}
+
 bool
 ati_start_cce_engine(ati_device_t *dev, uint32_t mode)
 {
+    // Packets can write shadowed registers behind the cache's back, and
+    // the CCE feeds the GUI FIFO so host-side credits don't hold
+    ati_shadow_suspend(dev, true);
+    ati_fifo_credits_suspend(dev, true);
+    // Bus-mastered packets never pass through the host to be recorded
+    if (cce_mode_from_nibble(mode) == CCE_MODE_BM)
+        ati_gui_wo_invalidate(dev);
     switch (ati_get_chip_family(dev)) {
     case CHIP_R128:
         ati_r128_start_cce_engine(dev, mode);
@@ -53,18 +133,36 @@ ati_stop_cce_engine(ati_device_t *dev)
         return false;
         break;
     }
+    ati_shadow_suspend(dev, false);
+    ati_fifo_credits_suspend(dev, false);
     return true;
 }
 
+cce_mode_t
+ati_cce_get_mode(ati_device_t *dev)
+{
+    switch (ati_get_chip_family(dev)) {
+    case CHIP_R128:
+        return cce_mode_from_nibble(rd_r128_pm4_buffer_cntl(dev) &
+                                    R128_PM4_BUFFER_MODE_MASK);
+    case CHIP_R100:
+        return cce_mode_from_nibble(rd_r100_cp_csq_cntl(dev) &
+                                    R100_CSQ_MODE_MASK);
+    case CHIP_UNKNOWN:
+    default:
+        return CCE_MODE_OFF;
+    }
+}
+
 bool
-ati_send_packet(ati_device_t *dev, uint32_t *packets, size_t dwords)
+ati_cce_wait_for_idle(ati_device_t *dev)
 {
     switch (ati_get_chip_family(dev)) {
     case CHIP_R128:
-        ati_r128_cce_pio_submit(dev, packets, dwords);
+        ati_r128_cce_wait_for_idle(dev);
         break;
     case CHIP_R100:
-        ati_r100_cce_pio_submit(dev, packets, dwords);
+        ati_r100_cce_wait_for_idle(dev);
         break;
     case CHIP_UNKNOWN:
     default:
@@ -74,6 +172,41 @@ ati_send_packet(ati_device_t *dev, uint32_t *packets, size_t dwords)
     return true;
 }
 
+bool
+ati_send_packet(ati_device_t *dev, uint32_t *packets, size_t dwords)
+{
+    ati_cce_pio_stats_t *stats = ati_device_pio_stats(dev);
+    uint64_t start = platform_time_ns();
+    bool ok;
+
+    switch (ati_get_chip_family(dev)) {
+    case CHIP_R128:
+        ok = ati_r128_cce_pio_submit(dev, packets, dwords);
+        break;
+    case CHIP_R100:
+        ok = ati_r100_cce_pio_submit(dev, packets, dwords);
+        break;
+    case CHIP_UNKNOWN:
+    default:
+        return false;
+        break;
+    }
+    stats->ns += platform_time_ns() - start;
+    // The packets may have set write-only registers
+    ati_gui_wo_invalidate(dev);
+    return ok;
+}
+
+bool
+ati_send_stream(ati_device_t *dev, const cce_stream_t *s)
+{
+    if (s->overflow) {
+        printf("Packet stream overflowed its %u dword buffer\n", s->size);
+        return false;
+    }
+    return ati_send_packet(dev, s->buf, s->dwords);
+}
+
 bool
 ati_dump_microcode(ati_device_t *dev, uint32_t *out)
 {
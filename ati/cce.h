@@ -21,16 +21,247 @@ enum {
 #define CCE_PKT2() (CCE_PACKET2)
 #define CCE_PKT3(opcode, n) (CCE_PACKET3 | (opcode) | ((n - 1) << 16))
 
+// Dwords a packet takes, header included
+static inline uint32_t
+cce_packet_dwords(uint32_t header)
+{
+    switch (header & CCE_PACKET3) {
+    case CCE_PACKET1:
+        return 3;
+    case CCE_PACKET2:
+        return 1;
+    default:
+        return ((header >> 16) & 0x3fff) + 2;
+    }
+}
+
 // Type-3 packet opcodes
 enum {
+    CCE_NOP = 0x1000,
+    CCE_NEXT_CHAR = 0x1900,
+    CCE_PLY_NEXTSCAN = 0x1D00,
+    CCE_SET_SCISSORS = 0x1E00,
+    CCE_WAIT_FOR_IDLE = 0x2600,
+    CCE_LOAD_PALETTE = 0x2C00,
+    CCE_CNTL_PAINT = 0x9100,
+    CCE_CNTL_BITBLT = 0x9200,
+    CCE_CNTL_SMALLTEXT = 0x9300,
+    CCE_CNTL_HOSTDATA_BLT = 0x9400,
+    CCE_CNTL_POLYLINE = 0x9500,
+    CCE_CNTL_POLYSCANLINES = 0x9800,
     CCE_CNTL_PAINT_MULTI = 0x9A00,
+    CCE_CNTL_BITBLT_MULTI = 0x9B00,
+    CCE_CNTL_TRANS_BITBLT = 0x9C00,
 };
 
+// Most dwords a type-0 or type-3 packet body can hold (14-bit count - 1)
+#define CCE_PKT_MAX_COUNT 0x4000
+// Type-1 packets address registers with 11-bit dword indices
+#define CCE_PKT1_REG_LIMIT 0x2000
+
+/* Packet stream builder.
+ *
+ * Packets are written straight into the caller's buffer, which can be a
+ * plain array, a ring reservation (ati_r100_ring_begin) or an indirect
+ * buffer (ati_r100_ib_alloc). A packet that doesn't fit, or has a bad
+ * count, is dropped and sets overflow, so a run of emits only needs
+ * checking once, at submission: ati_send_stream for PIO, ati_r100_ring_end
+ * or ati_r100_ib_submit.
+ *
+ * The CCE_EMIT macros take their payload as arguments, so the dword count
+ * in the header is counted at compile time and range checked there.
+ */
+
+typedef struct {
+    uint32_t *buf;
+    uint32_t size;   // In dwords
+    uint32_t dwords; // Written so far
+    bool overflow;
+} cce_stream_t;
+
+// Zero, or a build failure if cond is false. cond must be an integer
+// constant expression; anything else would make this a VLA.
+#define CCE_STATIC_CHECK(cond) (0 * sizeof(char[(cond) ? 1 : -1]))
+// 1 if x is an integer constant expression, else 0; itself constant
+#define CCE_IS_CONSTANT(x)                                                     \
+    (sizeof(int) == sizeof(*(8 ? ((void *) ((long) (x) * 0l)) : (int *) 8)))
+// A compile-time body count, which must be in [1, CCE_PKT_MAX_COUNT]
+#define CCE_CHECKED_COUNT(n)                                                   \
+    ((uint32_t) ((n) + CCE_STATIC_CHECK((n) >= 1 && (n) <= CCE_PKT_MAX_COUNT)))
+#define CCE_ARGS(...) ((const uint32_t[]) {__VA_ARGS__})
+#define CCE_NARGS(...) (sizeof(CCE_ARGS(__VA_ARGS__)) / sizeof(uint32_t))
+
+static inline void
+cce_stream_init(cce_stream_t *s, uint32_t *buf, uint32_t size)
+{
+    *s = (cce_stream_t) {buf, buf ? size : 0, 0, false};
+}
+
+// Room for a whole packet, header included, or NULL if it doesn't fit
+static inline uint32_t *
+cce_stream_alloc(cce_stream_t *s, uint32_t dwords)
+{
+    if (s->overflow || dwords > s->size - s->dwords) {
+        s->overflow = true;
+        return NULL;
+    }
+    uint32_t *pkt = s->buf + s->dwords;
+    s->dwords += dwords;
+    return pkt;
+}
+
+// Type-0 header for count registers from reg (or count writes to reg with
+// CCE_PACKET0_ONE_REG in flags); returns where the values go
+static inline uint32_t *
+cce_emit_pkt0(cce_stream_t *s, uint32_t reg, uint32_t flags, uint32_t count)
+{
+    uint32_t *pkt = count >= 1 && count <= CCE_PKT_MAX_COUNT
+                        ? cce_stream_alloc(s, count + 1)
+                        : NULL;
+    if (!pkt) {
+        s->overflow = true;
+        return NULL;
+    }
+    pkt[0] = CCE_PKT0(reg, count) | flags;
+    return pkt + 1;
+}
+
+static inline void
+cce_emit_pkt0_data(cce_stream_t *s, uint32_t reg, uint32_t flags,
+                   const uint32_t *values, uint32_t count)
+{
+    uint32_t *body = cce_emit_pkt0(s, reg, flags, count);
+    if (body) {
+        for (uint32_t i = 0; i < count; i++)
+            body[i] = values[i];
+    }
+}
+
+// A register at or above CCE_PKT1_REG_LIMIT drops the packet
+static inline void
+cce_emit_pkt1(cce_stream_t *s, uint32_t reg0, uint32_t val0, uint32_t reg1,
+              uint32_t val1)
+{
+    uint32_t *pkt = reg0 < CCE_PKT1_REG_LIMIT && reg1 < CCE_PKT1_REG_LIMIT
+                        ? cce_stream_alloc(s, 3)
+                        : NULL;
+    if (!pkt) {
+        s->overflow = true;
+        return;
+    }
+    pkt[0] = CCE_PKT1(reg0, reg1);
+    pkt[1] = val0;
+    pkt[2] = val1;
+}
+
+static inline void
+cce_emit_pkt2(cce_stream_t *s)
+{
+    uint32_t *pkt = cce_stream_alloc(s, 1);
+    if (pkt)
+        pkt[0] = CCE_PKT2();
+}
+
+// Type-3 header with a count dword body; returns where the body goes
+static inline uint32_t *
+cce_emit_pkt3(cce_stream_t *s, uint32_t opcode, uint32_t count)
+{
+    uint32_t *pkt = count >= 1 && count <= CCE_PKT_MAX_COUNT
+                        ? cce_stream_alloc(s, count + 1)
+                        : NULL;
+    if (!pkt) {
+        s->overflow = true;
+        return NULL;
+    }
+    pkt[0] = CCE_PKT3(opcode, count);
+    return pkt + 1;
+}
+
+static inline void
+cce_emit_pkt3_data(cce_stream_t *s, uint32_t opcode, const uint32_t *body,
+                   uint32_t count)
+{
+    uint32_t *dst = cce_emit_pkt3(s, opcode, count);
+    if (dst) {
+        for (uint32_t i = 0; i < count; i++)
+            dst[i] = body[i];
+    }
+}
+
+// CCE_EMIT0(s, reg, values...) writes consecutive registers from reg
+#define CCE_EMIT0(s, reg, ...)                                                 \
+    cce_emit_pkt0_data((s), (reg), 0, CCE_ARGS(__VA_ARGS__),                   \
+                       CCE_CHECKED_COUNT(CCE_NARGS(__VA_ARGS__)))
+// CCE_EMIT0_ONE(s, reg, values...) writes every value to reg
+#define CCE_EMIT0_ONE(s, reg, ...)                                             \
+    cce_emit_pkt0_data((s), (reg), CCE_PACKET0_ONE_REG,                        \
+                       CCE_ARGS(__VA_ARGS__),                                  \
+                       CCE_CHECKED_COUNT(CCE_NARGS(__VA_ARGS__)))
+// Constant registers are range checked at build time, anything else by
+// cce_emit_pkt1 as it emits
+#define CCE_EMIT1(s, reg0, val0, reg1, val1)                                   \
+    cce_emit_pkt1((s), CCE_PKT1_REG(reg0), (val0), CCE_PKT1_REG(reg1), (val1))
+#define CCE_PKT1_REG(reg)                                                      \
+    ((uint32_t) (reg) +                                                        \
+     __builtin_choose_expr(CCE_IS_CONSTANT(reg),                               \
+                           CCE_STATIC_CHECK((reg) < CCE_PKT1_REG_LIMIT), 0))
+// CCE_EMIT3(s, opcode, body...)
+#define CCE_EMIT3(s, opcode, ...)                                              \
+    cce_emit_pkt3_data((s), (opcode), CCE_ARGS(__VA_ARGS__),                   \
+                       CCE_CHECKED_COUNT(CCE_NARGS(__VA_ARGS__)))
+
+// How the command processor is currently taking commands
+typedef enum {
+    CCE_MODE_OFF, // Engine registers are written directly over MMIO
+    CCE_MODE_PIO, // Packets go through the PIO FIFO (ati_send_packet)
+    CCE_MODE_BM,  // Bus-master only; neither MMIO nor PIO packets reach it
+} cce_mode_t;
+
+// Load the microcode (unless it's still resident) and start the engine
 bool ati_init_cce_engine(ati_device_t *dev, uint32_t mode);
 bool ati_start_cce_engine(ati_device_t *dev, uint32_t mode);
 bool ati_stop_cce_engine(ati_device_t *dev);
 
+cce_mode_t ati_cce_get_mode(ati_device_t *dev);
+bool ati_cce_wait_for_idle(ati_device_t *dev);
+// PIO submission spends free FIFO slots as credits, reading the status
+// register (PM4_STAT or RBBM_STATUS) only once they run out
+typedef struct {
+    uint64_t dwords; // Written to the FIFO by ati_send_packet
+    uint64_t ns;     // Spent in ati_send_packet
+    uint32_t polls;  // FIFO status reads
+    uint32_t stalls; // Times the FIFO was full and submission had to wait
+} ati_cce_pio_stats_t;
+
+ati_cce_pio_stats_t *ati_device_pio_stats(ati_device_t *dev);
+
+// False if the FIFO stayed full and the rest of the packets were dropped
 bool ati_send_packet(ati_device_t *dev, uint32_t *packets, size_t dwords);
+// PIO submit of a built stream; refuses one that overflowed
+bool ati_send_stream(ati_device_t *dev, const cce_stream_t *s);
+
+/* Microcode residency.
+ *
+ * The device remembers the hash of the image it last uploaded. When
+ * ati_init_cce_engine finds the same image about to go in, it reads back a
+ * few instructions (a different handful each time) and skips the upload if
+ * they match. Writes to the instruction RAM data registers, including
+ * ati_write_microcode, and an R128 engine reset forget the image.
+ */
+#define ATI_MICROCODE_SAMPLES 8
+
+typedef struct {
+    bool valid;    // hash describes the instruction RAM
+    uint32_t hash; // Of the resident image
+    uint8_t next_sample;
+    // Statistics
+    uint32_t loads;
+    uint32_t skips;
+    uint32_t mismatches; // Hash matched but the readback didn't
+} ati_microcode_state_t;
+
+ati_microcode_state_t *ati_device_microcode(ati_device_t *dev);
+void ati_microcode_invalidate(ati_device_t *dev);
 
 bool ati_dump_microcode(ati_device_t *dev, uint32_t *out);
 bool ati_read_microcode(ati_device_t *dev, uint8_t addr, uint64_t *out);
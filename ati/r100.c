@@ -1,14 +1,32 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 #include "r100.h"
+#include "wait.h"
 #include "registers/r100_regs_gen.h"
 
 // ============================================================================
 // Display Mode Setup for Radeon R100
 // ============================================================================
 
+static uint32_t
+r100_crtc_pix_width(uint32_t bpp)
+{
+    switch (bpp) {
+    case 8:
+        return R100_CRTC_PIX_WIDTH_8BPP;
+    case 16:
+        return R100_CRTC_PIX_WIDTH_16BPP_RGB;
+    case 24:
+        return R100_CRTC_PIX_WIDTH_24BPP;
+    default:
+        return R100_CRTC_PIX_WIDTH_32BPP;
+    }
+}
+
 void
 r100_set_display_mode(ati_device_t *dev)
 {
+    const ati_display_mode_t *mode = ati_get_display_mode(dev);
+
     // Disable display while programming CRTC registers
     uint32_t crtc_ext_cntl = rd_crtc_ext_cntl(dev);
     wr_crtc_ext_cntl(dev, crtc_ext_cntl | CRTC_HSYNC_DIS | CRTC_VSYNC_DIS |
@@ -39,47 +57,38 @@ r100_set_display_mode(ati_device_t *dev)
     wr_r100_crtc_gen_cntl(dev, (crtc_gen_cntl & ~R100_CRTC_PIX_WIDTH_MASK & ~R100_CRTC_CUR_EN &
                                ~R100_CRTC_C_SYNC_EN & ~R100_CRTC_DBL_SCAN_EN & ~R100_CRTC_INTERLACE_EN) |
                                R100_CRTC_EXT_DISP_EN | R100_CRTC_EN |
-                               R100_CRTC_PIX_WIDTH_32BPP);
-
-    // VESA 640x480@60Hz standard timings
-    // Horizontal: 640 visible + 16 front porch + 96 sync + 48 back porch = 800
-    // total Vertical: 480 visible + 10 front porch + 2 sync + 33 back porch =
-    // 525 total Pixel clock: 25.175 MHz
+                               r100_crtc_pix_width(mode->bpp));
 
     // Horizontal timing (in 8-pixel characters)
-    uint32_t h_disp = ((640 / 8) - 1);  // 79 (640 pixels / 8 - 1)
-    uint32_t h_total = ((800 / 8) - 1); // 99 (800 pixels / 8 - 1)
+    uint32_t h_disp = (mode->width / 8) - 1;
+    uint32_t h_total = (mode->h_total / 8) - 1;
     wr_crtc_h_total_disp(dev, (h_disp << CRTC_H_DISP_SHIFT) |
                                   (h_total << CRTC_H_TOTAL_SHIFT));
 
-    // Horizontal sync: starts at 640 + 16 = 656, width = 96 pixels
-    uint32_t h_sync_strt = (640 + 16) / 8; // 82 characters
-    uint32_t h_sync_wid = 96 / 8;          // 12 characters
-    // Negative sync polarity for 640x480@60Hz
+    uint32_t h_sync_strt = mode->h_sync_start / 8;
+    uint32_t h_sync_wid = mode->h_sync_width / 8;
     wr_crtc_h_sync_strt_wid(dev, (h_sync_strt << CRTC_H_SYNC_STRT_CHAR_SHIFT) |
                                      (h_sync_wid << CRTC_H_SYNC_WID_SHIFT) |
-                                     CRTC_H_SYNC_POL);
+                                     (mode->h_sync_neg ? CRTC_H_SYNC_POL : 0));
 
     // Vertical timing (in lines)
-    uint32_t v_disp = 480 - 1;  // 479
-    uint32_t v_total = 525 - 1; // 524
+    uint32_t v_disp = mode->height - 1;
+    uint32_t v_total = mode->v_total - 1;
     wr_crtc_v_total_disp(dev, (v_disp << CRTC_V_DISP_SHIFT) |
                                   (v_total << CRTC_V_TOTAL_SHIFT));
 
-    // Vertical sync: starts at 480 + 10 = 490, width = 2 lines
-    uint32_t v_sync_strt = 480 + 10; // 490
-    uint32_t v_sync_wid = 2;         // 2 lines
-    // Negative sync polarity for 640x480@60Hz
+    uint32_t v_sync_strt = mode->v_sync_start;
+    uint32_t v_sync_wid = mode->v_sync_width;
     wr_crtc_v_sync_strt_wid(dev, (v_sync_strt << CRTC_V_SYNC_STRT_SHIFT) |
                                      (v_sync_wid << CRTC_V_SYNC_WID_SHIFT) |
-                                     CRTC_V_SYNC_POL);
+                                     (mode->v_sync_neg ? CRTC_V_SYNC_POL : 0));
 
     wr_crtc_offset(dev, 0x0);
     wr_crtc_offset_cntl(dev, 0x0);
 
     // R100 has CRTC_PITCH (bits 10:0) and CRTC_PITCH_RIGHT (bits 26:16)
     // Linux driver sets both to the same value even in non-stereo mode
-    uint32_t crtc_pitch = X_RES / 8;
+    uint32_t crtc_pitch = mode->pitch / (mode->bpp / 8) / 8;
     crtc_pitch |= (crtc_pitch << 16);
 
     // R100: Display address = CRTC_OFFSET + DISPLAY_BASE_ADDR
@@ -95,8 +104,8 @@ r100_set_display_mode(ati_device_t *dev)
     // Value from Linux radeon driver (radeonfb)
     wr_r100_grph_buffer_cntl(dev, 0x20117c7c);
 
-    // Initialize linear palette for 32bpp gamma correction
-    // In 32bpp mode, each color component (R,G,B) is looked up through
+    // Initialize linear palette for gamma correction
+    // In direct colour modes each component (R,G,B) is looked up through
     // the palette. Entry N should map to (N,N,N) for correct colors.
     wr_palette_index(dev, 0); // Start at entry 0
     for (int i = 0; i < 256; i++) {
@@ -111,9 +120,69 @@ r100_set_display_mode(ati_device_t *dev)
                               VGA_ATI_LINEAR | VGA_XCRT_CNT_EN | CRTC_CRT_ON);
 }
 
+// Returns the free slot count that satisfied the wait, 0 on timeout
+uint32_t
+ati_r100_wait_for_fifo(ati_device_t *dev, uint32_t entries)
+{
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_ENGINE_US);
+    do {
+        uint32_t slots = rd_r100_rbbm_status(dev) & R100_CMDFIFO_AVAIL_MASK;
+        if (slots >= entries) {
+            ati_wait_end(&w, true);
+            return slots;
+        }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
+    printf("ati_wait_for_fifo timed out! (waiting for %d entries)\n", entries);
+    return 0;
+}
+
+bool
+ati_r100_wait_for_engine(ati_device_t *dev)
+{
+    // Wait for engine to be idle
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_ENGINE_US);
+    do {
+        uint32_t status = rd_r100_rbbm_status(dev);
+        if ((status & R100_GUI_ACTIVE) == 0)
+            return ati_wait_end(&w, true);
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
+    printf("ati_wait_for_idle timed out! GUI still active.\n");
+    return false;
+}
+
+void
+ati_r100_engine_flush(ati_device_t *dev)
+{
+    // Flush the 2D destination cache
+    uint32_t tmp = rd_r100_rb2d_dstcache_ctlstat(dev);
+    wr_r100_rb2d_dstcache_ctlstat(dev, tmp | R100_RB2D_DC_FLUSH_ALL_MASK);
+
+    // Wait for flush to complete (DC_BUSY bit to clear)
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_ENGINE_US);
+    do {
+        uint32_t status = rd_r100_rb2d_dstcache_ctlstat(dev);
+        if ((status & R100_RB2D_DC_BUSY) == 0) {
+            ati_wait_end(&w, true);
+            return;
+        }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
+    printf("ati_engine_flush timed out! Destination cache still busy.\n");
+}
+
 void
 ati_r100_init_gui_engine(ati_device_t *dev)
 {
+    const ati_display_mode_t *mode = ati_get_display_mode(dev);
+
     // Reset the engine
     ati_engine_reset(dev);
 
@@ -121,52 +190,57 @@ ati_r100_init_gui_engine(ati_device_t *dev)
     ati_wait_for_idle(dev);
 
     // R100: Combined register with pitch in bits 29:22, offset in bits 21:0
-    // Pitch is in 64-byte units: (640 * 4) / 64 = 40
+    // Pitch is in 64-byte units: (640 * 4) / 64 = 40 at the default mode
     // Offset is in 1KB units: 0
-    uint32_t pitch_64 = (X_RES * BYPP) / 64;
-    wr_r100_default_pitch_offset(dev, pitch_64 << 22);
-
-    // Disable auxiliary scissor
-    wr_aux_sc_cntl(dev, 0x0);
-
-    // Set scissor clipping to the max.
-    // Range is -8192 to +8191 which is why these aren't just set to the mask.
-    wr_default_sc_bottom_right(dev, (0x1fff << DEFAULT_SC_RIGHT_SHIFT) |
-                                        (0x1fff << DEFAULT_SC_BOTTOM_SHIFT));
-    // The docs say to set DEFAULT_SC_TOP_LEFT... That doesn't exist as far as I
-    // can tell. So, set the actual scissor top left just to be safe.
-    wr_sc_top_left(dev, 0x00000000);
-    wr_sc_bottom_right(dev, (0x1fff << DEFAULT_SC_RIGHT_SHIFT) |
-                                (0x1fff << DEFAULT_SC_BOTTOM_SHIFT));
-
-    // Set blit direction to left-to-right, top-to-bottom
-    wr_dp_cntl(dev, DST_X_LEFT_TO_RIGHT | DST_Y_TOP_TO_BOTTOM);
-
-    // Set GUI master control
-    wr_r100_dp_gui_master_cntl(
-        dev, R100_GMC_BRUSH_DATATYPE_SOLIDCOLOR |
-                 ati_get_dst_datatype(BPP) |
-                 R100_GMC_SRC_DATATYPE_DST_COLOR |
-                 R100_GMC_BYTE_PIX_ORDER |
-                 R100_GMC_ROP3_SRCCOPY |
-                 R100_GMC_SRC_SOURCE_MEMORY |
-                 R100_GMC_WR_MSK_DIS);
-
-    // Clear the line drawing registers
-    wr_dst_bres_err(dev, 0);
-    wr_dst_bres_inc(dev, 0);
-    wr_dst_bres_dec(dev, 0);
-
-    // Set brush colors
-    wr_dp_brush_frgd_clr(dev, 0xffffffff);
-    wr_dp_brush_bkgd_clr(dev, 0x00000000);
-
-    // Set source colors
-    wr_dp_src_frgd_clr(dev, 0xffffffff);
-    wr_dp_src_bkgd_clr(dev, 0x00000000);
-
-    // Set write mask
-    wr_dp_write_msk(dev, 0xffffffff);
+    uint32_t pitch_64 = mode->pitch / 64;
+
+    const ati_reg_pair_t setup[] = {
+        {R100_DEFAULT_PITCH_OFFSET, pitch_64 << 22},
+
+        // Disable auxiliary scissor
+        {AUX_SC_CNTL, 0x0},
+
+        // Set scissor clipping to the max.
+        // Range is -8192 to +8191 which is why these aren't just set to the
+        // mask.
+        {DEFAULT_SC_BOTTOM_RIGHT, (0x1fff << DEFAULT_SC_RIGHT_SHIFT) |
+                                      (0x1fff << DEFAULT_SC_BOTTOM_SHIFT)},
+        // The docs say to set DEFAULT_SC_TOP_LEFT... That doesn't exist as far
+        // as I can tell. So, set the actual scissor top left just to be safe.
+        {SC_TOP_LEFT, 0x00000000},
+        {SC_BOTTOM_RIGHT, (0x1fff << DEFAULT_SC_RIGHT_SHIFT) |
+                              (0x1fff << DEFAULT_SC_BOTTOM_SHIFT)},
+
+        // Set blit direction to left-to-right, top-to-bottom
+        {DP_CNTL, DST_X_LEFT_TO_RIGHT | DST_Y_TOP_TO_BOTTOM},
+
+        // Set GUI master control
+        {R100_DP_GUI_MASTER_CNTL,
+         R100_GMC_BRUSH_DATATYPE_SOLIDCOLOR |
+             ati_get_dst_datatype(mode->bpp) |
+             R100_GMC_SRC_DATATYPE_DST_COLOR |
+             R100_GMC_BYTE_PIX_ORDER |
+             R100_GMC_ROP3_SRCCOPY |
+             R100_GMC_SRC_SOURCE_MEMORY |
+             R100_GMC_WR_MSK_DIS},
+
+        // Clear the line drawing registers
+        {DST_BRES_ERR, 0},
+        {DST_BRES_INC, 0},
+        {DST_BRES_DEC, 0},
+
+        // Set brush colors
+        {DP_BRUSH_FRGD_CLR, 0xffffffff},
+        {DP_BRUSH_BKGD_CLR, 0x00000000},
+
+        // Set source colors
+        {DP_SRC_FRGD_CLR, 0xffffffff},
+        {DP_SRC_BKGD_CLR, 0x00000000},
+
+        // Set write mask
+        {DP_WRITE_MSK, 0xffffffff},
+    };
+    ati_reg_write_batch(dev, setup, sizeof(setup) / sizeof(setup[0]));
 
     // Wait for idle to ensure initialization is complete
     ati_wait_for_idle(dev);
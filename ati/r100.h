@@ -6,6 +6,9 @@
 
 void r100_set_display_mode(ati_device_t *dev);
 void ati_r100_init_gui_engine(ati_device_t *dev);
+uint32_t ati_r100_wait_for_fifo(ati_device_t *dev, uint32_t entries);
+bool ati_r100_wait_for_engine(ati_device_t *dev);
+void ati_r100_engine_flush(ati_device_t *dev);
 uint32_t ati_r100_get_bytes_per_pixel(ati_device_t *dev);
 
 #endif
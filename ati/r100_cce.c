@@ -1,8 +1,7 @@
 #include "ati.h"
 #include "cce.h"
 #include "r100_cce.h"
-
-#define CCE_WAIT_TIMEOUT 10000000
+#include "wait.h"
 
 static uint32_t r100_cce_microcode[][2] = {
     { 0x21007000, 0000000000 },
@@ -263,19 +262,30 @@ static uint32_t r100_cce_microcode[][2] = {
     { 0000000000, 0000000000 },
 };
 
+uint64_t
+ati_r100_microcode_inst(uint8_t addr)
+{
+    return (uint64_t) r100_cce_microcode[addr][1] << 32 |
+           r100_cce_microcode[addr][0];
+}
+
 void
-ati_r100_init_cce_engine(ati_device_t *dev, uint32_t mode)
+ati_r100_load_microcode(ati_device_t *dev)
 {
     ati_wait_for_idle(dev);
 
-    // Load CP microcode
+    // Load CP microcode. Each entry is {low, high}.
     wr_r100_cp_me_ram_addr(dev, 0);
     for (int i = 0; i < 256; i += 1) {
-        int idx = i * 2;
-        wr_r100_cp_me_ram_datah(dev, r100_cce_microcode[idx][1]);
-        wr_r100_cp_me_ram_datal(dev, r100_cce_microcode[idx][0]);
+        wr_r100_cp_me_ram_datah(dev, r100_cce_microcode[i][1]);
+        wr_r100_cp_me_ram_datal(dev, r100_cce_microcode[i][0]);
     }
+}
 
+void
+ati_r100_init_cce_engine(ati_device_t *dev, uint32_t mode)
+{
+    ati_wait_for_idle(dev);
     wr_r100_cp_csq_cntl(dev, mode);
 }
 
@@ -318,47 +328,74 @@ ati_r100_write_microcode(ati_device_t *dev, uint8_t addr, uint64_t inst)
 {
     ati_wait_for_idle(dev);
     wr_r100_cp_me_ram_addr(dev, addr);
-    wr_r100_cp_me_ram_datah(dev, inst << 32);
+    wr_r100_cp_me_ram_datah(dev, inst >> 32);
     wr_r100_cp_me_ram_datal(dev, inst);
 }
 
-void
+// Free command FIFO slots, waiting for at least entries. Returns 0 on
+// timeout.
+static uint32_t
 ati_r100_cce_wait_for_fifo(ati_device_t *dev, uint32_t entries)
 {
-    uint32_t timeout = 1000000;
-    while (timeout--) {
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_ENGINE_US);
+    do {
         uint32_t slots = rd_r100_rbbm_status(dev) & R100_CMDFIFO_AVAIL_MASK;
         if (slots >= entries) {
-            return;
+            ati_wait_end(&w, true);
+            return slots;
         }
-    }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
     printf("ati_r100_cce_wait_for_fifo timed out! (waiting for %d entries)\n", entries);
-
+    return 0;
 }
 
-void
+// Spends the free slots RBBM_STATUS last reported, one per dword, and only
+// reads it again once they're used up. Returns false, having counted only
+// what went in, if the FIFO stays full.
+bool
 ati_r100_cce_pio_submit(ati_device_t *dev, uint32_t *packets, size_t dwords)
 {
-    for (size_t i = 0; i < dwords; i += 2) {
-        ati_r100_cce_wait_for_fifo(dev, 2);
-        wr_r100_cp_csq_aper_primary(dev, packets[i]);
-        if (i + 1 < dwords) {
-            wr_r100_cp_csq_aper_primary(dev, packets[i + 1]);
+    ati_cce_pio_stats_t *stats = ati_device_pio_stats(dev);
+    uint32_t credits = 0;
+
+    for (size_t i = 0; i < dwords; i++) {
+        if (credits == 0) {
+            stats->polls++;
+            credits = rd_r100_rbbm_status(dev) & R100_CMDFIFO_AVAIL_MASK;
+            if (credits == 0) {
+                stats->stalls++;
+                credits = ati_r100_cce_wait_for_fifo(dev, 1);
+                if (credits == 0) {
+                    stats->dwords += i;
+                    return false;
+                }
+            }
         }
+        wr_r100_cp_csq_aper_primary(dev, packets[i]);
+        credits--;
     }
+    stats->dwords += dwords;
+    return true;
 }
 
 int
 ati_r100_cce_wait_for_idle(ati_device_t *dev)
 {
     ati_r100_cce_wait_for_fifo(dev, 64);
-    for (int i = 0; i < CCE_WAIT_TIMEOUT; i++) {
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_CCE_US);
+    do {
         if (!(rd_r100_rbbm_status(dev) & R100_GUI_ACTIVE)) {
+            ati_wait_end(&w, true);
             ati_r100_flush_pixcache(dev);
             return 0;
         }
-        udelay(1);
-    }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
     printf("Failed to wait for cce idle\n");
     return 1;
 }
@@ -370,12 +407,16 @@ ati_r100_flush_pixcache(ati_device_t *dev)
     uint32_t tmp = rd_r100_rb2d_dstcache_ctlstat(dev) | R100_RB2D_DC_FLUSH_ALL_MASK;
     wr_r100_rb2d_dstcache_ctlstat(dev, tmp);
 
-    for (int i = 0; i < CCE_WAIT_TIMEOUT; i++) {
-        if(!(rd_r100_rb2d_dstcache_ctlstat(dev) & R100_RB2D_DC_BUSY)) {
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_ENGINE_US);
+    do {
+        if (!(rd_r100_rb2d_dstcache_ctlstat(dev) & R100_RB2D_DC_BUSY)) {
+            ati_wait_end(&w, true);
             return 0;
         }
-        udelay(1);
-    }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
     printf("Failed to flush pixcache\n");
     return 1;
 }
@@ -0,0 +1,272 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "r100_ib.h"
+#include "cce.h"
+#include "r100_mc.h"
+#include "wait.h"
+
+// The fence writeback shares the ring's writeback page, one 32-byte
+// SCRATCH_ADDR block in
+#define R100_IB_FENCE_DWORD (16 * 1024 + 8)
+#define R100_IB_FENCE_POISON 0xffffffff
+// Chaining packet plus fence
+#define R100_IB_RING_DWORDS 5
+
+static inline uint32_t
+align_up(uint32_t value, uint32_t align)
+{
+    return (value + align - 1) & ~(align - 1);
+}
+
+static uint32_t
+pool_fence(ati_r100_ib_pool_t *pool)
+{
+    if (pool->wb_ok)
+        return *pool->fence_wb;
+
+    pool->mmio_polls++;
+    uint32_t seq = rd_gui_scratch_reg0(pool->ring->dev);
+    if (*pool->fence_wb == seq)
+        pool->wb_ok = true;
+    return seq;
+}
+
+// Chain size dwords at pool offset start from the ring, followed by a fence
+static bool
+pool_emit(ati_r100_ib_pool_t *pool, uint32_t start, uint32_t size,
+          uint32_t seq)
+{
+    cce_stream_t s;
+    if (!ati_r100_ring_begin(pool->ring, &s, R100_IB_RING_DWORDS))
+        return false;
+
+    if (size)
+        CCE_EMIT0(&s, R100_CP_IB_BASE, pool->gart_base + start * 4, size);
+    CCE_EMIT0(&s, GUI_SCRATCH_REG0, seq);
+    return ati_r100_ring_end(pool->ring, &s);
+}
+
+void
+ati_r100_ib_pool_init(ati_r100_ib_pool_t *pool, ati_r100_ring_t *ring)
+{
+    ati_device_t *dev = ring->dev;
+
+    *pool = (ati_r100_ib_pool_t) {0};
+    pool->ring = ring;
+    pool->pool = &gart_mem[R100_IB_POOL_PAGE * 1024];
+    pool->gart_base = ati_r100_gart_addr(ring->gart_base, pool->pool);
+    pool->fence_wb = &gart_mem[R100_IB_FENCE_DWORD];
+    *pool->fence_wb = R100_IB_FENCE_POISON;
+
+    // Like the ring's read pointer, the writeback bypasses the GART
+    wr_r100_scratch_addr(dev, (uint32_t) (uintptr_t) pool->fence_wb);
+    wr_r100_scratch_umsk(dev, R100_SCRATCH0_EN);
+
+    // Start the fence at 0 through the ring, so the register never holds a
+    // stale sequence number a buffer could be mistaken as done by
+    pool_emit(pool, 0, 0, 0);
+    ati_r100_ring_wait_idle(ring);
+}
+
+void
+ati_r100_ib_pool_fini(ati_r100_ib_pool_t *pool)
+{
+    ati_r100_ib_wait_idle(pool);
+    wr_r100_scratch_umsk(pool->ring->dev, 0);
+}
+
+// Give back the space of every buffer the CP has executed
+static void
+pool_retire(ati_r100_ib_pool_t *pool)
+{
+    while (pool->count > 0 &&
+           ati_r100_ib_done(pool, pool->inflight[pool->first].seq)) {
+        pool->first = (pool->first + 1) % R100_IB_MAX_INFLIGHT;
+        pool->count--;
+        pool->recycled++;
+    }
+    pool->tail = pool->count ? pool->inflight[pool->first].start : pool->head;
+}
+
+// Free space is [head, end) and [0, tail) when the buffers in flight don't
+// wrap, [head, tail) when they do
+static bool
+pool_fit(ati_r100_ib_pool_t *pool, uint32_t size, uint32_t *start)
+{
+    if (pool->count == R100_IB_MAX_INFLIGHT)
+        return false;
+
+    if (pool->count == 0 || pool->head > pool->tail) {
+        if (R100_IB_POOL_DWORDS - pool->head >= size) {
+            *start = pool->head;
+            return true;
+        }
+        if (pool->count == 0 || pool->tail >= size) {
+            *start = 0;
+            return true;
+        }
+        return false;
+    }
+    if (pool->tail - pool->head >= size) {
+        *start = pool->head;
+        return true;
+    }
+    return false;
+}
+
+static bool
+pool_wait_space(ati_r100_ib_pool_t *pool, uint32_t size, uint32_t *start)
+{
+    pool_retire(pool);
+    if (pool_fit(pool, size, start))
+        return true;
+
+    // The fences may still be sitting in the ring
+    pool->pool_waits++;
+    ati_r100_ring_flush(pool->ring);
+
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_CCE_US);
+    while (ati_wait_backoff(&w)) {
+        pool_retire(pool);
+        if (pool_fit(pool, size, start))
+            return ati_wait_end(&w, true);
+    }
+    ati_wait_end(&w, false);
+    printf("Timed out waiting for indirect buffer space (fence %u of %u)\n",
+           pool_fence(pool), pool->seq);
+    return false;
+}
+
+bool
+ati_r100_ib_alloc(ati_r100_ib_pool_t *pool, uint32_t dwords,
+                  cce_stream_t *ib)
+{
+    if (pool->allocated) {
+        printf("An indirect buffer is already allocated\n");
+        return false;
+    }
+    uint32_t size = align_up(dwords, R100_IB_ALIGN_DWORDS);
+    if (dwords == 0 || size > R100_IB_POOL_DWORDS / 2) {
+        printf("Can't allocate a %u dword indirect buffer from %u dwords\n",
+               dwords, R100_IB_POOL_DWORDS);
+        return false;
+    }
+
+    uint32_t start;
+    if (!pool_wait_space(pool, size, &start))
+        return false;
+
+    cce_stream_init(ib, (uint32_t *) &pool->pool[start], size);
+    pool->allocated = true;
+    return true;
+}
+
+uint32_t
+ati_r100_ib_submit(ati_r100_ib_pool_t *pool, cce_stream_t *ib)
+{
+    uint32_t start = ib->buf - (uint32_t *) pool->pool;
+    uint32_t size = align_up(ib->dwords, R100_IB_ALIGN_DWORDS);
+
+    pool->allocated = false;
+    if (ib->overflow || ib->dwords == 0) {
+        printf("Indirect buffer of %u dwords %s\n", ib->size,
+               ib->overflow ? "overflowed" : "is empty");
+        return 0;
+    }
+
+    pool->pad_dwords += size - ib->dwords;
+    while (ib->dwords < size)
+        cce_emit_pkt2(ib);
+
+    // The CP fetches the buffer straight from memory
+    __sync_synchronize();
+    if (!pool_emit(pool, start, size, pool->seq + 1))
+        return 0;
+
+    pool->seq++;
+    uint32_t slot = (pool->first + pool->count) % R100_IB_MAX_INFLIGHT;
+    pool->inflight[slot] = (ati_r100_ib_inflight_t) {start, start + size,
+                                                     pool->seq};
+    pool->count++;
+    pool->head = start + size;
+    pool->submitted++;
+    return pool->seq;
+}
+
+bool
+ati_r100_ib_submit_stream(ati_r100_ib_pool_t *pool, const uint32_t *packets,
+                          size_t dwords, uint32_t ib_dwords)
+{
+    while (dwords > 0) {
+        cce_stream_t ib;
+        uint32_t want = dwords < ib_dwords ? dwords : ib_dwords;
+        if (!ati_r100_ib_alloc(pool, want, &ib))
+            return false;
+
+        while (dwords > 0) {
+            uint32_t n = cce_packet_dwords(packets[0]);
+            if (n > dwords) {
+                printf("Packet stream ends mid-packet\n");
+                pool->allocated = false;
+                return false;
+            }
+            uint32_t *pkt = ib.dwords + n <= want ? cce_stream_alloc(&ib, n)
+                                                  : NULL;
+            if (!pkt)
+                break;
+            for (uint32_t i = 0; i < n; i++)
+                pkt[i] = packets[i];
+            packets += n;
+            dwords -= n;
+        }
+        if (ib.dwords == 0) {
+            printf("A %u dword packet doesn't fit a %u dword indirect "
+                   "buffer\n",
+                   cce_packet_dwords(packets[0]), want);
+            pool->allocated = false;
+            return false;
+        }
+        if (!ati_r100_ib_submit(pool, &ib))
+            return false;
+    }
+    return true;
+}
+
+bool
+ati_r100_ib_done(ati_r100_ib_pool_t *pool, uint32_t seq)
+{
+    return (int32_t) (pool_fence(pool) - seq) >= 0;
+}
+
+bool
+ati_r100_ib_wait(ati_r100_ib_pool_t *pool, uint32_t seq)
+{
+    if (ati_r100_ib_done(pool, seq))
+        return true;
+
+    ati_r100_ring_flush(pool->ring);
+
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_CCE_US);
+    while (ati_wait_backoff(&w)) {
+        if (ati_r100_ib_done(pool, seq)) {
+            pool_retire(pool);
+            return ati_wait_end(&w, true);
+        }
+    }
+    ati_wait_end(&w, false);
+    printf("Timed out waiting for indirect buffer fence %u (at %u)\n", seq,
+           pool_fence(pool));
+    return false;
+}
+
+bool
+ati_r100_ib_wait_idle(ati_r100_ib_pool_t *pool)
+{
+    if (!ati_r100_ib_wait(pool, pool->seq))
+        return false;
+    pool_retire(pool);
+    return ati_r100_ring_wait_idle(pool->ring);
+}
@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#ifndef R100_IB_H
+#define R100_IB_H
+
+#include "r100_ring.h"
+
+/* Radeon R100 indirect buffer pool.
+ *
+ * Indirect buffers are carved out of the GART pages past the ring's
+ * writeback page, first-in first-out. Each one is chained from the ring with
+ * a CP_IB_BASE/CP_IB_BUFSZ type-0 packet, followed by a fence: a write of a
+ * sequence number to GUI_SCRATCH_REG0, which the CP writes back to system
+ * memory through SCRATCH_ADDR. Once a buffer's fence has landed, the CP has
+ * executed it and its space goes back to the pool.
+ *
+ * Submitting only writes the ring, so any number of buffers goes out with
+ * the ring's batched CP_RB_WPTR writes. Allocations wait for old buffers to
+ * retire when the pool is full.
+ */
+
+#define R100_IB_POOL_PAGE 17 // First GART page of the pool
+#define R100_IB_POOL_DWORDS ((R100_GART_PAGES - R100_IB_POOL_PAGE) * 1024)
+#define R100_IB_ALIGN_DWORDS 16 // Buffers start and end on 64 bytes
+#define R100_IB_MAX_INFLIGHT 256
+
+typedef struct {
+    uint32_t start; // Pool offset in dwords
+    uint32_t end;
+    uint32_t seq;
+} ati_r100_ib_inflight_t;
+
+typedef struct {
+    ati_r100_ring_t *ring;
+    volatile uint32_t *pool;
+    volatile uint32_t *fence_wb;
+    uint32_t gart_base; // GART address of pool
+    uint32_t head;      // Where the next buffer goes
+    uint32_t tail;      // Start of the oldest buffer in flight
+    uint32_t seq;       // Last fence emitted
+    bool allocated;     // A buffer is out and not yet submitted
+    bool wb_ok;         // The fence writeback has been seen to work
+    ati_r100_ib_inflight_t inflight[R100_IB_MAX_INFLIGHT];
+    uint32_t first; // Oldest entry in inflight
+    uint32_t count;
+    // Statistics
+    uint32_t submitted;
+    uint32_t recycled;
+    uint32_t pad_dwords;
+    uint32_t pool_waits; // Times an allocation found the pool full
+    uint32_t mmio_polls; // Fence reads that went to the register
+} ati_r100_ib_pool_t;
+
+// Set up the pool over a running ring. Enables the GUI_SCRATCH_REG0
+// writeback, which ati_r100_ib_pool_fini turns off again.
+void ati_r100_ib_pool_init(ati_r100_ib_pool_t *pool, ati_r100_ring_t *ring);
+// Wait for every buffer to retire
+void ati_r100_ib_pool_fini(ati_r100_ib_pool_t *pool);
+
+// Point ib at room for dwords of whole packets, at most half the pool.
+// Only one buffer can be out at a time. Returns false if the CP stopped
+// executing.
+bool ati_r100_ib_alloc(ati_r100_ib_pool_t *pool, uint32_t dwords,
+                       cce_stream_t *ib);
+// Pad ib to the alignment and chain it from the ring. Returns its fence, or
+// 0 if it overflowed, is empty or the CP stopped executing.
+uint32_t ati_r100_ib_submit(ati_r100_ib_pool_t *pool, cce_stream_t *ib);
+// Split a packet stream into buffers of at most ib_dwords, on packet
+// boundaries, and submit them all. Returns false on a packet that doesn't
+// fit a buffer or if the CP stopped executing.
+bool ati_r100_ib_submit_stream(ati_r100_ib_pool_t *pool,
+                               const uint32_t *packets, size_t dwords,
+                               uint32_t ib_dwords);
+
+// Whether the buffer with fence seq has been executed
+bool ati_r100_ib_done(ati_r100_ib_pool_t *pool, uint32_t seq);
+bool ati_r100_ib_wait(ati_r100_ib_pool_t *pool, uint32_t seq);
+// Wait for everything submitted so far
+bool ati_r100_ib_wait_idle(ati_r100_ib_pool_t *pool);
+
+#endif
@@ -1,19 +1,43 @@
 #include "r100_mc.h"
 
-volatile uint32_t gart_mem[1024] __attribute__((aligned(4096)));
-uint32_t page_table[32] __attribute__((aligned(4096)));
+volatile uint32_t gart_mem[R100_GART_PAGES * 1024]
+    __attribute__((aligned(R100_GART_PAGE_SIZE)));
+uint32_t page_table[R100_GART_PAGES]
+    __attribute__((aligned(R100_GART_PAGE_SIZE)));
+
+// Devices run their tests in parallel threads on Linux
+static ati_device_t *volatile gart_owner;
+
+bool
+ati_r100_gart_claim(ati_device_t *dev)
+{
+    if (__sync_bool_compare_and_swap(&gart_owner, NULL, dev) ||
+        gart_owner == dev)
+        return true;
+    printf("The R100 GART buffers are in use by another device\n");
+    return false;
+}
+
+void
+ati_r100_gart_release(ati_device_t *dev)
+{
+    __sync_bool_compare_and_swap(&gart_owner, dev, NULL);
+}
 
 uint32_t
 ati_r100_init_pci_gart(ati_device_t *dev)
 {
+    if (!ati_r100_gart_claim(dev))
+        return 0;
+
     // Get the framebuffer and gart locations in
     // the linear aperture address space
     uint32_t fb_location = (rd_r100_mc_fb_location(dev) & 0xffff) << 16;
     uint32_t gart_vm_start = fb_location + rd_r100_config_aper_size(dev);
 
     // Initialize the PCI GART page table
-    memset((void *)page_table, 0, sizeof(page_table));
-    page_table[0] = (uint32_t)gart_mem;
+    for (int i = 0; i < R100_GART_PAGES; i++)
+        page_table[i] = (uint32_t) (uintptr_t) &gart_mem[i * 1024];
     // and GART memory
     memset((void *)gart_mem, 0, sizeof(gart_mem));
 
@@ -27,7 +51,7 @@ ati_r100_init_pci_gart(ati_device_t *dev)
     wr_r100_aic_ctrl(dev, R100_TRANSLATE_EN);
     wr_r100_aic_pt_base(dev, (uint32_t) page_table);
     wr_r100_aic_lo_addr(dev, gart_vm_start);
-    wr_r100_aic_hi_addr(dev, gart_vm_start);
+    wr_r100_aic_hi_addr(dev, gart_vm_start + sizeof(gart_mem) - 1);
 
     // Not entirely sure this is necessary but the Linux DRM driver
     // does this to disable the AGP GART.
@@ -42,4 +66,12 @@ void
 ati_r100_disable_pci_gart(ati_device_t *dev)
 {
     wr_r100_aic_ctrl(dev, 0);
+    ati_r100_gart_release(dev);
+}
+
+uint32_t
+ati_r100_gart_addr(uint32_t gart_base, volatile const void *ptr)
+{
+    return gart_base + (uint32_t) ((volatile const uint8_t *) ptr -
+                                   (volatile const uint8_t *) gart_mem);
 }
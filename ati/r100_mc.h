@@ -3,10 +3,24 @@
 
 #include "ati.h"
 
-extern uint32_t page_table[32];
-extern volatile uint32_t gart_mem[1024];
+#define R100_GART_PAGE_SIZE 4096
+#define R100_GART_PAGES 64
 
+extern uint32_t page_table[R100_GART_PAGES];
+extern volatile uint32_t gart_mem[R100_GART_PAGES * 1024];
+
+// gart_mem and page_table are shared by every device, so in a multi-card run
+// only one R100 can have them at a time. Claiming them again from the same
+// device is fine; another device is refused until they're released, which
+// disabling the GART, finishing a ring and resetting for a test all do.
+bool ati_r100_gart_claim(ati_device_t *dev);
+void ati_r100_gart_release(ati_device_t *dev);
+
+// Claims gart_mem, returning 0 with nothing written if another device has it
 uint32_t ati_r100_init_pci_gart(ati_device_t *dev);
 void ati_r100_disable_pci_gart(ati_device_t *dev);
 
+// GART address of a dword inside gart_mem
+uint32_t ati_r100_gart_addr(uint32_t gart_base, volatile const void *ptr);
+
 #endif
@@ -0,0 +1,319 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "r100_ring.h"
+#include "cce.h"
+#include "r100_cce.h"
+#include "r100_mc.h"
+#include "wait.h"
+
+// The writeback dword gets the page after the largest ring to itself
+#define R100_RING_WB_DWORD (16 * 1024)
+#define R100_RING_WB_POISON 0xffffffff
+#define R100_RING_BLOCK_DWORDS (2u << R100_RING_BLKSZ_L2QW)
+
+bool
+ati_r100_ring_init(ati_device_t *dev, ati_r100_ring_t *ring,
+                   const ati_r100_ring_config_t *config)
+{
+    if (ati_get_chip_family(dev) != CHIP_R100) {
+        printf("The CP ring is R100 only\n");
+        return false;
+    }
+#ifndef PLATFORM_BAREMETAL
+    // The GART and the writeback are given pointers as bus addresses
+    printf("The CP ring needs bare metal's identity mapping\n");
+    return false;
+#endif
+    if (config->size_l2qw < R100_RING_MIN_L2QW ||
+        config->size_l2qw > R100_RING_MAX_L2QW) {
+        printf("Ring size 2^%u qwords out of range (%u-%u)\n",
+               config->size_l2qw, R100_RING_MIN_L2QW, R100_RING_MAX_L2QW);
+        return false;
+    }
+
+    *ring = (ati_r100_ring_t) {0};
+    ring->dev = dev;
+    ring->size = 2u << config->size_l2qw;
+    ring->mask = ring->size - 1;
+    ring->wptr_batch = config->wptr_batch;
+    if (ring->wptr_batch > ring->size / 2)
+        ring->wptr_batch = ring->size / 2;
+
+    // Load the microcode with the CP off, so it doesn't start fetching
+    // until the ring registers are set
+    ati_init_cce_engine(dev, R100_CSQ_MODE_DISABLED);
+    uint32_t gart = ati_r100_init_pci_gart(dev);
+    if (!gart)
+        return false;
+    ring->gart_base = gart;
+    ring->ring = gart_mem;
+    ring->rptr_wb = &gart_mem[R100_RING_WB_DWORD];
+    // No read pointer is all ones, so seeing anything else came from the CP
+    *ring->rptr_wb = R100_RING_WB_POISON;
+
+    uint32_t cntl = config->size_l2qw |
+                    (R100_RING_BLKSZ_L2QW << R100_RB_BLKSZ_SHIFT);
+    wr_r100_cp_rb_base(dev, gart);
+    wr_r100_cp_rb_wptr_delay(dev, config->wptr_delay);
+    // Both pointers to zero; RPTR_WR only takes while RPTR_WR_ENA is set
+    wr_r100_cp_rb_cntl(dev, cntl | R100_RB_RPTR_WR_ENA);
+    wr_r100_cp_rb_rptr_wr(dev, 0);
+    wr_r100_cp_rb_wptr(dev, 0);
+    wr_r100_cp_rb_cntl(dev, cntl);
+    // The writeback doesn't go through the GART: like the ring buffer setup
+    // test, it's given the physical address
+    wr_r100_cp_rb_rptr_addr(dev, (uint32_t) (uintptr_t) ring->rptr_wb);
+
+    // Indirect buffers too, so they can be chained from the ring
+    ati_start_cce_engine(dev, R100_CSQ_MODE_BM_INDBM);
+    return true;
+}
+
+void
+ati_r100_ring_fini(ati_r100_ring_t *ring)
+{
+    ati_r100_ring_wait_idle(ring);
+    ati_stop_cce_engine(ring->dev);
+    ati_r100_gart_release(ring->dev);
+}
+
+uint32_t
+ati_r100_ring_rptr(ati_r100_ring_t *ring)
+{
+    if (ring->wb_ok)
+        return *ring->rptr_wb & ring->mask;
+
+    ring->mmio_polls++;
+    uint32_t rptr = rd_r100_cp_rb_rptr(ring->dev) & R100_RB_RPTR_MASK;
+    if (*ring->rptr_wb == rptr)
+        ring->wb_ok = true;
+    return rptr & ring->mask;
+}
+
+// Credit whatever the CP fetched since the last look. It can never be a
+// whole ring ahead, as the host keeps a dword free.
+static void
+ring_update(ati_r100_ring_t *ring)
+{
+    uint32_t rptr = ati_r100_ring_rptr(ring);
+    ring->retired += (rptr - ring->last_rptr) & ring->mask;
+    ring->last_rptr = rptr;
+}
+
+static uint32_t
+ring_space(ati_r100_ring_t *ring)
+{
+    ring_update(ring);
+    return ring->size - 1 - (uint32_t) (ring->emitted - ring->retired);
+}
+
+// Tell the CP about everything written so far, mid-packet or not
+static void
+ring_publish(ati_r100_ring_t *ring)
+{
+    if (ring->published == ring->wptr)
+        return;
+    // The ring is cached memory: make sure the packets are globally visible
+    // before the CP is told to fetch them
+    __sync_synchronize();
+    wr_r100_cp_rb_wptr(ring->dev, ring->wptr);
+    ring->published = ring->wptr;
+    ring->wptr_writes++;
+}
+
+static void
+ring_emit(ati_r100_ring_t *ring, uint32_t dword)
+{
+    ring->ring[ring->wptr] = dword;
+    ring->wptr = (ring->wptr + 1) & ring->mask;
+    ring->emitted++;
+    if (ring->wptr == 0)
+        ring->wraps++;
+}
+
+static void
+ring_pad(ati_r100_ring_t *ring, uint32_t dwords)
+{
+    for (uint32_t i = 0; i < dwords; i++)
+        ring_emit(ring, CCE_PKT2());
+    ring->pad_dwords += dwords;
+}
+
+// The CP only writes its read pointer back at block boundaries, so with the
+// write pointer mid-block, that part block is never seen to free up. A wait
+// that needs it pads the block out first, which moves the write pointer:
+// callers recheck anything worked out from it.
+static bool
+ring_wait_space(ati_r100_ring_t *ring, uint32_t want)
+{
+    if (ring_space(ring) >= want)
+        return true;
+
+    uint32_t pad = -ring->wptr & (R100_RING_BLOCK_DWORDS - 1);
+    bool need_pad = pad && want > ring->size - 1 -
+                                      (R100_RING_BLOCK_DWORDS - pad);
+
+    // The CP can't free anything it hasn't been told about
+    ring->space_waits++;
+    ring_publish(ring);
+
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_CCE_US);
+    while (ati_wait_backoff(&w)) {
+        uint32_t space = ring_space(ring);
+        if (need_pad && space >= pad) {
+            ring_pad(ring, pad);
+            ring_publish(ring);
+            need_pad = false;
+            space -= pad;
+        }
+        if (!need_pad && space >= want)
+            return ati_wait_end(&w, true);
+    }
+    ati_wait_end(&w, false);
+    printf("Timed out waiting for CP ring space (rptr %u, wptr %u)\n",
+           ati_r100_ring_rptr(ring), ring->wptr);
+    return false;
+}
+
+// Publish once enough work has built up to be worth a register write
+static void
+ring_maybe_publish(ati_r100_ring_t *ring)
+{
+    if (((ring->wptr - ring->published) & ring->mask) >= ring->wptr_batch)
+        ring_publish(ring);
+}
+
+uint32_t *
+ati_r100_ring_reserve(ati_r100_ring_t *ring, uint32_t dwords)
+{
+    if (dwords == 0 || dwords > ring->size / 2) {
+        printf("Can't reserve %u dwords of a %u dword ring\n", dwords,
+               ring->size);
+        return NULL;
+    }
+
+    // A wrap pads out the end of the ring before waiting for the rest. The
+    // end is a block boundary, so the writeback then catches up with
+    // everything, where waiting for the tail and the packets together could
+    // need the block the writeback hasn't reported yet.
+    for (;;) {
+        uint32_t tail = ring->size - ring->wptr;
+        uint32_t want = dwords > tail ? tail : dwords;
+        if (ring_space(ring) >= want) {
+            if (dwords <= tail)
+                break;
+            ring_pad(ring, tail);
+        } else if (!ring_wait_space(ring, want)) {
+            return NULL;
+        }
+    }
+
+    ring->reserved = dwords;
+    return (uint32_t *) &ring->ring[ring->wptr];
+}
+
+void
+ati_r100_ring_commit(ati_r100_ring_t *ring, uint32_t dwords)
+{
+    if (dwords > ring->reserved) {
+        printf("Committing %u dwords of a %u dword reservation\n", dwords,
+               ring->reserved);
+        dwords = ring->reserved;
+    }
+    ring->reserved = 0;
+    if (dwords == 0)
+        return;
+
+    ring->wptr = (ring->wptr + dwords) & ring->mask;
+    ring->emitted += dwords;
+    if (ring->wptr == 0)
+        ring->wraps++;
+    ring_maybe_publish(ring);
+}
+
+bool
+ati_r100_ring_begin(ati_r100_ring_t *ring, cce_stream_t *s, uint32_t dwords)
+{
+    uint32_t *buf = ati_r100_ring_reserve(ring, dwords);
+    cce_stream_init(s, buf, dwords);
+    return buf != NULL;
+}
+
+bool
+ati_r100_ring_end(ati_r100_ring_t *ring, const cce_stream_t *s)
+{
+    ati_r100_ring_commit(ring, s->dwords);
+    if (s->overflow)
+        printf("Packet stream overflowed its %u dword reservation\n", s->size);
+    return !s->overflow;
+}
+
+bool
+ati_r100_ring_submit(ati_r100_ring_t *ring, const uint32_t *packets,
+                     size_t dwords)
+{
+    while (dwords > 0) {
+        uint32_t want = dwords < ring->size / 2 ? dwords : ring->size / 2;
+        if (!ring_wait_space(ring, want))
+            return false;
+
+        uint32_t space = ring_space(ring);
+        size_t n = dwords < space ? dwords : space;
+        for (size_t i = 0; i < n; i++)
+            ring_emit(ring, packets[i]);
+        packets += n;
+        dwords -= n;
+        ring_maybe_publish(ring);
+    }
+    return true;
+}
+
+void
+ati_r100_ring_flush(ati_r100_ring_t *ring)
+{
+    uint32_t pad = -ring->wptr & (R100_RING_BLOCK_DWORDS - 1);
+    if (pad && ring_wait_space(ring, pad))
+        ring_pad(ring, pad);
+    ring_publish(ring);
+}
+
+uint64_t
+ati_r100_ring_mark(ati_r100_ring_t *ring)
+{
+    ati_r100_ring_flush(ring);
+    return ring->emitted;
+}
+
+bool
+ati_r100_ring_done(ati_r100_ring_t *ring, uint64_t mark)
+{
+    ring_update(ring);
+    return ring->retired >= mark;
+}
+
+bool
+ati_r100_ring_wait(ati_r100_ring_t *ring, uint64_t mark)
+{
+    if (ati_r100_ring_done(ring, mark))
+        return true;
+
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_CCE_US);
+    while (ati_wait_backoff(&w)) {
+        if (ati_r100_ring_done(ring, mark))
+            return ati_wait_end(&w, true);
+    }
+    ati_wait_end(&w, false);
+    printf("Timed out waiting for the CP ring (rptr %u, wptr %u)\n",
+           ati_r100_ring_rptr(ring), ring->wptr);
+    return false;
+}
+
+bool
+ati_r100_ring_wait_idle(ati_r100_ring_t *ring)
+{
+    return ati_r100_ring_wait(ring, ati_r100_ring_mark(ring)) &&
+           ati_r100_cce_wait_for_idle(ring->dev) == 0;
+}
@@ -0,0 +1,107 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#ifndef R100_RING_H
+#define R100_RING_H
+
+#include "ati.h"
+#include "cce.h"
+
+/* Radeon R100 CP ring buffer.
+ *
+ * The ring lives at the start of gart_mem and the CP fetches it through the
+ * PCI GART. Work goes in either by reserving space and writing packets in
+ * place (ati_r100_ring_reserve/commit), or by copying a stream that may be
+ * bigger than the ring (ati_r100_ring_submit).
+ *
+ * Commits only advance the host's write pointer. CP_RB_WPTR is written once
+ * wptr_batch dwords have built up, or when something needs the CP to catch
+ * up (a flush, a mark, a wait or a full ring). A non-zero wptr_delay is
+ * programmed into CP_RB_WPTR_DELAY, letting the CP hold off on fetching
+ * after each write, so batches there can be smaller.
+ *
+ * The CP writes its read pointer back to system memory every 2^blksz
+ * qwords fetched, and flushes pad to that block size, so the final read
+ * pointer is always written back. A wrap pads out the end of the ring, also
+ * a block boundary, before waiting for space at the start, and any wait
+ * that needs the unreported part of a block pads it out first. Completion
+ * and space checks poll that dword. It's trusted once it has matched
+ * CP_RB_RPTR; until then the register is read.
+ *
+ * Positions handed out by ati_r100_ring_mark count every dword ever written,
+ * so they don't alias when the ring wraps.
+ */
+
+#define R100_RING_MIN_L2QW 4 // Room to pad to a writeback block
+#define R100_RING_MAX_L2QW 13 // 64 KB
+#define R100_RING_BLKSZ_L2QW 3 // Read pointer written back every 64 bytes
+
+typedef struct {
+    uint32_t size_l2qw;  // Ring of 2^size_l2qw qwords
+    uint32_t wptr_batch; // Committed dwords that trigger a CP_RB_WPTR write
+    uint32_t wptr_delay; // CP_RB_WPTR_DELAY
+} ati_r100_ring_config_t;
+
+#define ATI_R100_RING_DEFAULT_CONFIG {12, 1024, 0}
+
+typedef struct {
+    ati_device_t *dev;
+    volatile uint32_t *ring;
+    volatile uint32_t *rptr_wb;
+    uint32_t gart_base; // GART address of gart_mem
+    uint32_t size;      // In dwords
+    uint32_t mask;
+    uint32_t wptr_batch;
+    uint32_t wptr;      // Next dword the host writes
+    uint32_t published; // Last value written to CP_RB_WPTR
+    uint32_t reserved;  // Dwords handed out by the last reserve
+    uint32_t last_rptr;
+    uint64_t emitted; // Dwords ever written, padding included
+    uint64_t retired; // Dwords the CP has fetched
+    bool wb_ok;       // The read pointer writeback has been seen to work
+    // Statistics
+    uint32_t wptr_writes;
+    uint32_t wraps;
+    uint32_t pad_dwords;
+    uint32_t space_waits; // Times a reservation found the ring full
+    uint32_t mmio_polls;  // Read pointer reads that went to the register
+} ati_r100_ring_t;
+
+// Map the ring through the GART, load the microcode and start the CP in
+// bus-master mode. Returns false on a non-R100 device, a bad config, off
+// bare metal, where pointers into gart_mem aren't bus addresses, or while
+// another device has gart_mem. The ring holds gart_mem until it's finished.
+bool ati_r100_ring_init(ati_device_t *dev, ati_r100_ring_t *ring,
+                        const ati_r100_ring_config_t *config);
+// Drain the ring, stop the CP and release gart_mem
+void ati_r100_ring_fini(ati_r100_ring_t *ring);
+
+// Contiguous space for dwords of whole packets, at most half the ring.
+// Skips to the start of the ring with type-2 padding when the end is too
+// close. Returns NULL if the CP stopped fetching.
+uint32_t *ati_r100_ring_reserve(ati_r100_ring_t *ring, uint32_t dwords);
+// Hand over the first dwords of the last reservation
+void ati_r100_ring_commit(ati_r100_ring_t *ring, uint32_t dwords);
+// Reserve dwords and point a packet stream builder at them
+bool ati_r100_ring_begin(ati_r100_ring_t *ring, cce_stream_t *s,
+                         uint32_t dwords);
+// Commit the packets built since ati_r100_ring_begin. Returns false, having
+// committed only the packets that fit, if the stream overflowed.
+bool ati_r100_ring_end(ati_r100_ring_t *ring, const cce_stream_t *s);
+// Copy a packet stream in, feeding it through as the CP drains. Returns
+// false if the CP stopped fetching.
+bool ati_r100_ring_submit(ati_r100_ring_t *ring, const uint32_t *packets,
+                          size_t dwords);
+
+// Pad to the writeback block size and write CP_RB_WPTR
+void ati_r100_ring_flush(ati_r100_ring_t *ring);
+// Flush, and return the position after everything committed so far
+uint64_t ati_r100_ring_mark(ati_r100_ring_t *ring);
+// Whether the CP has fetched everything before mark
+bool ati_r100_ring_done(ati_r100_ring_t *ring, uint64_t mark);
+bool ati_r100_ring_wait(ati_r100_ring_t *ring, uint64_t mark);
+// Wait for the CP to fetch everything committed and go idle
+bool ati_r100_ring_wait_idle(ati_r100_ring_t *ring);
+
+// Where the CP has fetched up to
+uint32_t ati_r100_ring_rptr(ati_r100_ring_t *ring);
+
+#endif
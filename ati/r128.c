@@ -1,13 +1,74 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 #include "r128.h"
+#include "wait.h"
 
 // ============================================================================
 // Display Mode Setup for Rage 128
 // ============================================================================
 
+static uint32_t
+r128_crtc_pix_width(uint32_t bpp)
+{
+    switch (bpp) {
+    case 8:
+        return R128_CRTC_PIX_WIDTH_8BPP;
+    case 16:
+        return R128_CRTC_PIX_WIDTH_16BPP;
+    case 24:
+        return R128_CRTC_PIX_WIDTH_24BPP;
+    default:
+        return R128_CRTC_PIX_WIDTH_32BPP;
+    }
+}
+
+// Display FIFO arbitration, following XFree86's R128InitDDARegisters.
+// The clocks aren't reprogrammed, so XCLK * FIFO width / VCLK is fixed by
+// the BIOS; 544 reproduces the known-good 32bpp values (0x01060220 /
+// 0x05e03b80) and only the pixel size changes between modes.
+#define R128_DDA_XCLK_FIFO_RATIO 544
+#define R128_DDA_FIFO_DEPTH 32
+
+// SDR SGRAM 1:1 timings, in XCLKs
+#define R128_RAM_MB 4
+#define R128_RAM_TRCD 3
+#define R128_RAM_TRP 3
+#define R128_RAM_TWR 1
+#define R128_RAM_CL 3
+#define R128_RAM_TR2W 1
+#define R128_RAM_RLOOP 16
+
+static uint32_t
+r128_min_bits(uint32_t val)
+{
+    uint32_t bits = 0;
+    for (; val; val >>= 1)
+        bits++;
+    return bits;
+}
+
+static void
+r128_set_dda(ati_device_t *dev, uint32_t bpp)
+{
+    uint32_t xclks_per_xfer = (R128_DDA_XCLK_FIFO_RATIO + bpp / 2) / bpp;
+    uint32_t precision = r128_min_bits(xclks_per_xfer) + 1;
+    uint32_t precise =
+        ((R128_DDA_XCLK_FIFO_RATIO << (11 - precision)) + bpp / 2) / bpp;
+    uint32_t roff = precise * (R128_DDA_FIFO_DEPTH - 4);
+    uint32_t ron = (4 * R128_RAM_MB + 3 * (R128_RAM_TRCD - 2) +
+                    2 * R128_RAM_TRP + R128_RAM_TWR + R128_RAM_CL +
+                    R128_RAM_TR2W + xclks_per_xfer)
+                   << (11 - precision);
+
+    wr_r128_dda_config(dev, precise | (precision << 16) |
+                                (R128_RAM_RLOOP << 20));
+    wr_r128_dda_on_off(dev, (ron << 16) | roff);
+}
+
 void
 r128_set_display_mode(ati_device_t *dev)
 {
+    const ati_display_mode_t *mode = ati_get_display_mode(dev);
+
     // Disable display while programming CRTC registers
     uint32_t crtc_ext_cntl = rd_crtc_ext_cntl(dev);
     wr_crtc_ext_cntl(dev, crtc_ext_cntl | CRTC_HSYNC_DIS | CRTC_VSYNC_DIS |
@@ -38,59 +99,44 @@ r128_set_display_mode(ati_device_t *dev)
     wr_r128_crtc_gen_cntl(dev, (crtc_gen_cntl & ~R128_CRTC_PIX_WIDTH_MASK & ~R128_CRTC_CUR_EN &
                            ~R128_CRTC_C_SYNC_EN & ~R128_CRTC_DBL_SCAN_EN & ~R128_CRTC_INTERLACE_EN) |
                               R128_CRTC_EXT_DISP_EN | R128_CRTC_EN |
-                              R128_CRTC_PIX_WIDTH_32BPP);
-
-    // VESA 640x480@60Hz standard timings
-    // Horizontal: 640 visible + 16 front porch + 96 sync + 48 back porch = 800
-    // total Vertical: 480 visible + 10 front porch + 2 sync + 33 back porch =
-    // 525 total Pixel clock: 25.175 MHz
+                              r128_crtc_pix_width(mode->bpp));
 
     // Horizontal timing (in 8-pixel characters)
-    uint32_t h_disp = ((640 / 8) - 1);  // 79 (640 pixels / 8 - 1)
-    uint32_t h_total = ((800 / 8) - 1); // 99 (800 pixels / 8 - 1)
+    uint32_t h_disp = (mode->width / 8) - 1;
+    uint32_t h_total = (mode->h_total / 8) - 1;
     wr_crtc_h_total_disp(dev, (h_disp << CRTC_H_DISP_SHIFT) |
                                   (h_total << CRTC_H_TOTAL_SHIFT));
 
-    // Horizontal sync: starts at 640 + 16 = 656, width = 96 pixels
-    uint32_t h_sync_strt = (640 + 16) / 8; // 82 characters
-    uint32_t h_sync_wid = 96 / 8;          // 12 characters
-    // Negative sync polarity for 640x480@60Hz
+    uint32_t h_sync_strt = mode->h_sync_start / 8;
+    uint32_t h_sync_wid = mode->h_sync_width / 8;
     wr_crtc_h_sync_strt_wid(dev, (h_sync_strt << CRTC_H_SYNC_STRT_CHAR_SHIFT) |
                                      (h_sync_wid << CRTC_H_SYNC_WID_SHIFT) |
-                                     CRTC_H_SYNC_POL);
+                                     (mode->h_sync_neg ? CRTC_H_SYNC_POL : 0));
 
     // Vertical timing (in lines)
-    uint32_t v_disp = 480 - 1;  // 479
-    uint32_t v_total = 525 - 1; // 524
+    uint32_t v_disp = mode->height - 1;
+    uint32_t v_total = mode->v_total - 1;
     wr_crtc_v_total_disp(dev, (v_disp << CRTC_V_DISP_SHIFT) |
                                   (v_total << CRTC_V_TOTAL_SHIFT));
 
-    // Vertical sync: starts at 480 + 8 = 490, width = 2 lines
-    uint32_t v_sync_strt = 480 + 8; // 488
-    uint32_t v_sync_wid = 2;         // 2 lines
-    // Negative sync polarity for 640x480@60Hz
+    uint32_t v_sync_strt = mode->v_sync_start;
+    uint32_t v_sync_wid = mode->v_sync_width;
     wr_crtc_v_sync_strt_wid(dev, (v_sync_strt << CRTC_V_SYNC_STRT_SHIFT) |
                                      (v_sync_wid << CRTC_V_SYNC_WID_SHIFT) |
-                                     CRTC_V_SYNC_POL);
+                                     (mode->v_sync_neg ? CRTC_V_SYNC_POL : 0));
 
     wr_crtc_offset(dev, 0x0);
     wr_crtc_offset_cntl(dev, 0x0);
 
     // R128: CRTC_PITCH is bits 9:0, pitch in (pixels * 8)
-    uint32_t crtc_pitch = X_RES / 8;
+    uint32_t crtc_pitch = mode->pitch / (mode->bpp / 8) / 8;
     wr_r128_crtc_pitch(dev, crtc_pitch);
 
     // R128: DDA-based display FIFO arbitration
-    // These values are calculated for:
-    //   XCLK = 134 MHz (memory clock from BIOS)
-    //   VCLK = 67 MHz (BIOS-configured pixel clock, not 25MHz)
-    //   32bpp, 640x480, FIFO depth=32, FIFO width=128 bits
-    // Using Linux's known-working values for now:
-    wr_r128_dda_config(dev, 0x01060220);
-    wr_r128_dda_on_off(dev, 0x05e03b80);
-
-    // Initialize linear palette for 32bpp gamma correction
-    // In 32bpp mode, each color component (R,G,B) is looked up through
+    r128_set_dda(dev, mode->bpp);
+
+    // Initialize linear palette for gamma correction
+    // In direct colour modes each component (R,G,B) is looked up through
     // the palette. Entry N should map to (N,N,N) for correct colors.
     wr_palette_index(dev, 0); // Start at entry 0
     for (int i = 0; i < 256; i++) {
@@ -105,37 +151,44 @@ r128_set_display_mode(ati_device_t *dev)
                               VGA_ATI_LINEAR | VGA_XCRT_CNT_EN | CRTC_CRT_ON);
 }
 
-void
+// Returns the free slot count that satisfied the wait, 0 on timeout
+uint32_t
 ati_r128_wait_for_fifo(ati_device_t *dev, uint32_t entries)
 {
-    uint32_t timeout = 1000000;
-    while (timeout--) {
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_ENGINE_US);
+    do {
         uint32_t slots = rd_r128_gui_stat(dev) & R128_GUI_FIFO_CNT_MASK;
         if (slots >= entries) {
-            return;
+            ati_wait_end(&w, true);
+            return slots;
         }
-    }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
     printf("ati_wait_for_fifo timed out! (waiting for %d entries)\n", entries);
     // TODO: I'm not sure what should happen on a timeout here.
     //       It looks like the r128 driver resets the engine.
     //       We'll see if we can get away with not worrying about it...
+    return 0;
 }
 
 
-void
+bool
 ati_r128_wait_for_engine(ati_device_t *dev)
 {
     // Wait for engine to be idle
-    uint32_t timeout = 1000000;
-    while (timeout--) {
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_ENGINE_US);
+    do {
         uint32_t status = rd_r128_gui_stat(dev);
-        if ((status & R128_GUI_ACTIVE) == 0) {
-            break;
-        }
-    }
-    if (timeout == 0) {
-        printf("ati_wait_for_idle timed out! GUI still active.\n");
-    }
+        if ((status & R128_GUI_ACTIVE) == 0)
+            return ati_wait_end(&w, true);
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
+    printf("ati_wait_for_idle timed out! GUI still active.\n");
+    return false;
 }
 
 
@@ -146,13 +199,17 @@ ati_r128_engine_flush(ati_device_t *dev)
     wr_r128_pc_ngui_ctlstat(dev, R128_PC_FLUSH_ALL_MASK);
 
     // Wait for flush to complete (PC_BUSY bit to clear)
-    uint32_t timeout = 1000000;
-    while (timeout--) {
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_ENGINE_US);
+    do {
         uint32_t status = rd_r128_pc_ngui_ctlstat(dev);
         if ((status & R128_PC_BUSY) == 0) {
+            ati_wait_end(&w, true);
             return;
         }
-    }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
     printf("ati_engine_flush timed out! Pixel cache still busy.\n");
 }
 
@@ -182,6 +239,8 @@ ati_r128_engine_reset(ati_device_t *dev)
 void
 ati_r128_init_gui_engine(ati_device_t *dev)
 {
+    const ati_display_mode_t *mode = ati_get_display_mode(dev);
+
     // Disable 3D scaling
     wr_r128_scale_3d_cntl(dev, 0x0);
 
@@ -191,50 +250,54 @@ ati_r128_init_gui_engine(ati_device_t *dev)
     // Wait for engine to be idle after reset
     ati_wait_for_idle(dev);
 
-    wr_r128_default_offset(dev, 0x0);
-    wr_r128_default_pitch(dev, X_RES / 8);
-
-    // Disable auxiliary scissor
-    wr_aux_sc_cntl(dev, 0x0);
-
-    // Set scissor clipping to the max.
-    // Range is -8192 to +8191 which is why these aren't just set to the mask.
-    wr_default_sc_bottom_right(dev, (0x1fff << DEFAULT_SC_RIGHT_SHIFT) |
-                                        (0x1fff << DEFAULT_SC_BOTTOM_SHIFT));
-    // The docs say to set DEFAULT_SC_TOP_LEFT... That doesn't exist as far as I
-    // can tell. So, set the actual scissor top left just to be safe.
-    wr_sc_top_left(dev, 0x00000000);
-    wr_sc_bottom_right(dev, (0x1fff << DEFAULT_SC_RIGHT_SHIFT) |
-                                (0x1fff << DEFAULT_SC_BOTTOM_SHIFT));
-
-    // Set blit direction to left-to-right, top-to-bottom
-    wr_dp_cntl(dev, DST_X_LEFT_TO_RIGHT | DST_Y_TOP_TO_BOTTOM);
-
-    // Set GUI master control
-    wr_r128_dp_gui_master_cntl(
-        dev, R128_GMC_BRUSH_DATATYPE_SOLIDCOLOR |
-                 ati_get_dst_datatype(BPP) |
-                 R128_GMC_SRC_DATATYPE_DST_COLOR |
-                 R128_GMC_BYTE_PIX_ORDER | // LSB to MSB
-                 R128_GMC_ROP3_SRCCOPY |
-                 R128_GMC_SRC_SOURCE_MEMORY |
-                 R128_GMC_CLR_CMP_CNTL_DIS | R128_GMC_AUX_CLIP_DIS | R128_GMC_WR_MSK_DIS);
-
-    // Clear the line drawing registers
-    wr_dst_bres_err(dev, 0);
-    wr_dst_bres_inc(dev, 0);
-    wr_dst_bres_dec(dev, 0);
-
-    // Set brush colors
-    wr_dp_brush_frgd_clr(dev, 0xffffffff);
-    wr_dp_brush_bkgd_clr(dev, 0x00000000);
-
-    // Set source colors
-    wr_dp_src_frgd_clr(dev, 0xffffffff);
-    wr_dp_src_bkgd_clr(dev, 0x00000000);
-
-    // Set write mask
-    wr_dp_write_msk(dev, 0xffffffff);
+    const ati_reg_pair_t setup[] = {
+        {R128_DEFAULT_OFFSET, 0x0},
+        {R128_DEFAULT_PITCH, mode->pitch / (mode->bpp / 8) / 8},
+
+        // Disable auxiliary scissor
+        {AUX_SC_CNTL, 0x0},
+
+        // Set scissor clipping to the max.
+        // Range is -8192 to +8191 which is why these aren't just set to the
+        // mask.
+        {DEFAULT_SC_BOTTOM_RIGHT, (0x1fff << DEFAULT_SC_RIGHT_SHIFT) |
+                                      (0x1fff << DEFAULT_SC_BOTTOM_SHIFT)},
+        // The docs say to set DEFAULT_SC_TOP_LEFT... That doesn't exist as far
+        // as I can tell. So, set the actual scissor top left just to be safe.
+        {SC_TOP_LEFT, 0x00000000},
+        {SC_BOTTOM_RIGHT, (0x1fff << DEFAULT_SC_RIGHT_SHIFT) |
+                              (0x1fff << DEFAULT_SC_BOTTOM_SHIFT)},
+
+        // Set blit direction to left-to-right, top-to-bottom
+        {DP_CNTL, DST_X_LEFT_TO_RIGHT | DST_Y_TOP_TO_BOTTOM},
+
+        // Set GUI master control
+        {R128_DP_GUI_MASTER_CNTL,
+         R128_GMC_BRUSH_DATATYPE_SOLIDCOLOR |
+             ati_get_dst_datatype(mode->bpp) |
+             R128_GMC_SRC_DATATYPE_DST_COLOR |
+             R128_GMC_BYTE_PIX_ORDER | // LSB to MSB
+             R128_GMC_ROP3_SRCCOPY |
+             R128_GMC_SRC_SOURCE_MEMORY |
+             R128_GMC_CLR_CMP_CNTL_DIS | R128_GMC_AUX_CLIP_DIS | R128_GMC_WR_MSK_DIS},
+
+        // Clear the line drawing registers
+        {DST_BRES_ERR, 0},
+        {DST_BRES_INC, 0},
+        {DST_BRES_DEC, 0},
+
+        // Set brush colors
+        {DP_BRUSH_FRGD_CLR, 0xffffffff},
+        {DP_BRUSH_BKGD_CLR, 0x00000000},
+
+        // Set source colors
+        {DP_SRC_FRGD_CLR, 0xffffffff},
+        {DP_SRC_BKGD_CLR, 0x00000000},
+
+        // Set write mask
+        {DP_WRITE_MSK, 0xffffffff},
+    };
+    ati_reg_write_batch(dev, setup, sizeof(setup) / sizeof(setup[0]));
 
     // Wait for idle to ensure initialization is complete
     ati_wait_for_idle(dev);
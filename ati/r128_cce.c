@@ -1,7 +1,6 @@
 #include "cce.h"
 #include "r128_cce.h"
-
-#define CCE_WAIT_TIMEOUT 10000000
+#include "wait.h"
 
 /* CCE microcode (from ATI) */
 static uint32_t r128_cce_microcode[] = {
@@ -69,8 +68,15 @@ static uint32_t r128_cce_microcode[] = {
     0,  0,           0,  0,          0,  0,           0,  0,
     0,  0,           0,  0,          0,  0,           0,  0};
 
+uint64_t
+ati_r128_microcode_inst(uint8_t addr)
+{
+    return (uint64_t) r128_cce_microcode[addr * 2] << 32 |
+           r128_cce_microcode[addr * 2 + 1];
+}
+
 void
-ati_r128_init_cce_engine(ati_device_t *dev, uint32_t mode)
+ati_r128_load_microcode(ati_device_t *dev)
 {
     ati_wait_for_idle(dev);
 
@@ -80,6 +86,12 @@ ati_r128_init_cce_engine(ati_device_t *dev, uint32_t mode)
         wr_r128_pm4_microcode_datah(dev, r128_cce_microcode[i * 2]);
         wr_r128_pm4_microcode_datal(dev, r128_cce_microcode[i * 2 + 1]);
     }
+}
+
+void
+ati_r128_init_cce_engine(ati_device_t *dev, uint32_t mode)
+{
+    ati_wait_for_idle(dev);
 
     wr_r128_pm4_buffer_cntl(dev, mode | R128_PM4_BUFFER_CNTL_NOUPDATE);
 
@@ -133,7 +145,7 @@ ati_r128_read_microcode(ati_device_t *dev, uint8_t addr)
 void
 ati_r128_write_microcode(ati_device_t *dev, uint8_t addr, uint64_t inst)
 {
-    uint32_t high = inst << 32;
+    uint32_t high = inst >> 32;
     uint32_t low = inst;
     // Must wait for idle before writing microcode
     ati_wait_for_idle(dev);
@@ -143,42 +155,78 @@ ati_r128_write_microcode(ati_device_t *dev, uint8_t addr, uint64_t inst)
 }
 
 
-static void
+// Free PM4 FIFO slots, waiting for at least entries. Returns 0 on timeout.
+static uint32_t
 ati_r128_cce_wait_for_fifo(ati_device_t *dev, uint32_t entries)
 {
-    while ((rd_r128_pm4_stat(dev) & R128_PM4_FIFOCNT_MASK) < entries) {
-        // spin
-    }
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_CCE_US);
+    do {
+        uint32_t slots = rd_r128_pm4_stat(dev) & R128_PM4_FIFOCNT_MASK;
+        if (slots >= entries) {
+            ati_wait_end(&w, true);
+            return slots;
+        }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
+    printf("ati_r128_cce_wait_for_fifo timed out! (waiting for %u entries)\n",
+           entries);
+    return 0;
 }
 
-void
+// Dwords go in as even/odd pairs, spending the free slots PM4_STAT last
+// reported. It's only read again once they're used up. Returns false,
+// having counted only what went in, if the FIFO stays full.
+bool
 ati_r128_cce_pio_submit(ati_device_t *dev, uint32_t *packets, size_t dwords)
 {
+    ati_cce_pio_stats_t *stats = ati_device_pio_stats(dev);
+    uint32_t credits = 0;
+
     for (size_t i = 0; i < dwords; i += 2) {
-        //ati_r128_cce_wait_for_fifo(dev, 2);
+        if (credits < 2) {
+            stats->polls++;
+            credits = rd_r128_pm4_stat(dev) & R128_PM4_FIFOCNT_MASK;
+            if (credits < 2) {
+                stats->stalls++;
+                credits = ati_r128_cce_wait_for_fifo(dev, 2);
+                if (credits < 2) {
+                    stats->dwords += i;
+                    return false;
+                }
+            }
+        }
         wr_r128_pm4_fifo_data_even(dev, packets[i]);
         if (i + 1 < dwords) {
             wr_r128_pm4_fifo_data_odd(dev, packets[i + 1]);
         } else {
             wr_r128_pm4_fifo_data_odd(dev, CCE_PKT2());
         }
+        credits -= 2;
     }
+    stats->dwords += dwords;
+    return true;
 }
 
 int
 ati_r128_cce_wait_for_idle(ati_device_t *dev)
 {
-
-    for (int i = 0; i < CCE_WAIT_TIMEOUT; i++) {
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_CCE_US);
+    do {
         uint32_t pm4_stat = rd_r128_pm4_stat(dev);
         uint32_t fifocnt = pm4_stat & R128_PM4_FIFOCNT_MASK;
         bool busy = pm4_stat & (R128_PM4_BUSY | R128_GUI_ACTIVE);
         bool fifo_empty = fifocnt >= 192;
         if (fifo_empty && !busy) {
+            ati_wait_end(&w, true);
             ati_r128_flush_pixcache(dev);
             return 0;
         }
-    }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
     printf("Failed to wait for cce idle\n");
     return 1;
 }
@@ -189,12 +237,16 @@ ati_r128_flush_pixcache(ati_device_t *dev)
     uint32_t tmp = rd_r128_pc_ngui_ctlstat(dev) | R128_PC_FLUSH_ALL_MASK;
     wr_r128_pc_ngui_ctlstat(dev, tmp);
 
-    for (int i = 0; i < CCE_WAIT_TIMEOUT; i++) {
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_ENGINE_US);
+    do {
         if (!(rd_r128_pc_ngui_ctlstat(dev) & R128_PC_BUSY)) {
+            ati_wait_end(&w, true);
             return 0;
         }
-        udelay(1);
-    }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
     printf("Failed to flush pixcache\n");
     return 1;
 }
@@ -4,6 +4,11 @@
 #include "ati.h"
 
 // CCE engine functions
+// Upload the built-in microcode image; ati_r128_microcode_inst is its
+// instruction at addr
+void ati_r128_load_microcode(ati_device_t *dev);
+uint64_t ati_r128_microcode_inst(uint8_t addr);
+// Set the buffer mode and start the engine on the resident microcode
 void ati_r128_init_cce_engine(ati_device_t *dev, uint32_t mode);
 void ati_r128_start_cce_engine(ati_device_t *dev, uint32_t mode);
 void ati_r128_stop_cce_engine(ati_device_t *dev);
@@ -12,7 +17,7 @@ void ati_r128_dump_microcode(ati_device_t *dev, uint32_t *out);
 uint64_t ati_r128_read_microcode(ati_device_t *dev, uint8_t addr);
 void ati_r128_write_microcode(ati_device_t *dev, uint8_t addr, uint64_t inst);
 
-void ati_r128_cce_pio_submit(ati_device_t *dev, uint32_t *packets, size_t dwords);
+bool ati_r128_cce_pio_submit(ati_device_t *dev, uint32_t *packets, size_t dwords);
 int ati_r128_cce_wait_for_idle(ati_device_t *dev);
 int ati_r128_flush_pixcache(ati_device_t *dev);
 
@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "r128_mc.h"
+
+volatile uint32_t r128_gart_mem[R128_GART_PAGES * 1024]
+    __attribute__((aligned(R128_GART_PAGE_SIZE)));
+
+static ati_device_t *volatile r128_gart_owner;
+
+bool
+ati_r128_gart_claim(ati_device_t *dev)
+{
+    if (__sync_bool_compare_and_swap(&r128_gart_owner, NULL, dev) ||
+        r128_gart_owner == dev)
+        return true;
+    printf("The R128 GART buffers are in use by another device\n");
+    return false;
+}
+
+void
+ati_r128_gart_release(ati_device_t *dev)
+{
+    __sync_bool_compare_and_swap(&r128_gart_owner, dev, NULL);
+}
+
+#ifdef PLATFORM_BAREMETAL
+static uint32_t r128_page_table[R128_GART_PAGES]
+    __attribute__((aligned(R128_GART_PAGE_SIZE)));
+
+bool
+ati_r128_init_pci_gart(ati_device_t *dev, uint32_t *gart_base)
+{
+    if (!ati_r128_gart_claim(dev))
+        return false;
+
+    for (int i = 0; i < R128_GART_PAGES; i++) {
+        r128_page_table[i] =
+            (uint32_t) (uintptr_t) &r128_gart_mem[i * 1024];
+    }
+
+    wr_r128_pci_gart_page(dev, (uint32_t) (uintptr_t) r128_page_table);
+
+    // Enable bus mastering. It should be enabled by default but...
+    wr_r128_bus_cntl(dev, rd_r128_bus_cntl(dev) & ~R128_BUS_MASTER_DIS);
+
+    *gart_base = R128_AGP_OFFSET;
+    return true;
+}
+#else
+bool
+ati_r128_init_pci_gart(ati_device_t *dev, uint32_t *gart_base)
+{
+    (void) dev;
+    (void) gart_base;
+    printf("The PCI GART needs bare metal's identity mapping\n");
+    return false;
+}
+#endif
+
+uint32_t
+ati_r128_gart_addr(uint32_t gart_base, volatile const void *ptr)
+{
+    return gart_base + (uint32_t) ((volatile const uint8_t *) ptr -
+                                   (volatile const uint8_t *) r128_gart_mem);
+}
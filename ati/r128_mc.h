@@ -0,0 +1,37 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#ifndef R128_MC_H
+#define R128_MC_H
+
+#include "ati.h"
+
+/* Rage 128 PCI GART.
+ *
+ * The CCE reaches system memory through a page table of 32-bit bus
+ * addresses at PCI_GART_PAGE, mapping r128_gart_mem page by page from
+ * R128_AGP_OFFSET in its VM space. Like the R100 GART this relies on bare
+ * metal's identity mapping: the bus address of a page is its pointer.
+ */
+
+#define R128_AGP_OFFSET 0x02000000
+#define R128_GART_PAGE_SIZE 4096
+#define R128_GART_PAGES 32
+
+extern volatile uint32_t r128_gart_mem[R128_GART_PAGES * 1024];
+
+// r128_gart_mem is shared by every device, so only one Rage 128 can have it
+// at a time. Claiming it again from the same device is fine; another device
+// is refused until it's released, which finishing a ring and resetting for a
+// test both do.
+bool ati_r128_gart_claim(ati_device_t *dev);
+void ati_r128_gart_release(ati_device_t *dev);
+
+// Claim r128_gart_mem, point the GART at it and enable bus mastering, setting
+// *gart_base to the VM address the CCE sees r128_gart_mem at. False, with
+// nothing written, off bare metal where pointers aren't bus addresses or
+// when another device has r128_gart_mem.
+bool ati_r128_init_pci_gart(ati_device_t *dev, uint32_t *gart_base);
+
+// VM address of a dword inside r128_gart_mem
+uint32_t ati_r128_gart_addr(uint32_t gart_base, volatile const void *ptr);
+
+#endif
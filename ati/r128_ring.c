@@ -0,0 +1,181 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "r128_ring.h"
+#include "cce.h"
+#include "r128_cce.h"
+#include "r128_mc.h"
+#include "wait.h"
+
+// The writeback dword gets the last page of r128_gart_mem to itself, past
+// the largest ring
+#define R128_RING_WB_DWORD ((R128_GART_PAGES - 1) * 1024)
+#define R128_RING_WB_POISON 0xffffffff
+
+// Fetch watermarks from the DRM driver (R128_WATERMARK_L/M/N/K)
+#define R128_RING_WM_CNTL                                                      \
+    ((16 / 4) << R128_WMA_SHIFT | (8 / 4) << R128_WMB_SHIFT |                  \
+     (8 / 4) << R128_WMC_SHIFT | (128 / 64) << R128_WB_WM_SHIFT)
+
+bool
+ati_r128_ring_init(ati_device_t *dev, ati_r128_ring_t *ring,
+                   uint32_t size_l2qw)
+{
+    if (ati_get_chip_family(dev) != CHIP_R128) {
+        printf("The PM4 ring is R128 only\n");
+        return false;
+    }
+    if (size_l2qw < R128_RING_MIN_L2QW || size_l2qw > R128_RING_MAX_L2QW) {
+        printf("Ring size 2^%u qwords out of range (%u-%u)\n", size_l2qw,
+               R128_RING_MIN_L2QW, R128_RING_MAX_L2QW);
+        return false;
+    }
+
+    // Before the writeback poison goes into r128_gart_mem
+    if (!ati_r128_gart_claim(dev))
+        return false;
+
+    *ring = (ati_r128_ring_t) {0};
+    ring->dev = dev;
+    ring->ring = r128_gart_mem;
+    ring->rptr_wb = &r128_gart_mem[R128_RING_WB_DWORD];
+    ring->size = 2u << size_l2qw;
+    ring->mask = ring->size - 1;
+    // No read pointer is all ones, so seeing anything else came from the CCE
+    *ring->rptr_wb = R128_RING_WB_POISON;
+
+    // Load the microcode with the CCE in non-PM4 mode, so it doesn't start
+    // fetching until the ring registers are set
+    ati_init_cce_engine(dev, R128_PM4_BUFFER_MODE_NONPM4);
+    uint32_t gart;
+    if (!ati_r128_init_pci_gart(dev, &gart))
+        return false;
+    wr_r128_pm4_buffer_offset(dev, gart);
+    wr_r128_pm4_buffer_dl_wptr(dev, 0);
+    wr_r128_pm4_buffer_dl_rptr(dev, 0);
+    wr_r128_pm4_buffer_dl_rptr_addr(dev,
+                                    ati_r128_gart_addr(gart, ring->rptr_wb));
+    wr_r128_pm4_buffer_wm_cntl(dev, R128_RING_WM_CNTL);
+
+    // Drivers always set NOUPDATE and read DL_RPTR over MMIO. It's left
+    // clear here so the read pointer is written back; wb_ok records whether
+    // it actually is.
+    ati_start_cce_engine(dev, R128_PM4_BUFFER_MODE_192BM | size_l2qw);
+    wr_r128_pm4_buffer_cntl(dev, R128_PM4_BUFFER_MODE_192BM | size_l2qw);
+    // Read as per sample code (may be required for mode change to take effect)
+    (void) rd_r128_pm4_buffer_addr(dev);
+    return true;
+}
+
+void
+ati_r128_ring_fini(ati_r128_ring_t *ring)
+{
+    ati_r128_ring_wait_idle(ring);
+    ati_stop_cce_engine(ring->dev);
+    ati_r128_gart_release(ring->dev);
+}
+
+uint32_t
+ati_r128_ring_rptr(ati_r128_ring_t *ring)
+{
+    if (ring->wb_ok)
+        return *ring->rptr_wb & ring->mask;
+
+    ring->mmio_polls++;
+    uint32_t rptr = rd_r128_pm4_buffer_dl_rptr(ring->dev);
+    if (*ring->rptr_wb == rptr)
+        ring->wb_ok = true;
+    return rptr & ring->mask;
+}
+
+// Free dwords, keeping a qword between the write and read pointers so a
+// full ring never looks empty. Always even.
+static uint32_t
+ring_space(ati_r128_ring_t *ring)
+{
+    uint32_t used = (ring->wptr - ati_r128_ring_rptr(ring)) & ring->mask;
+    return (ring->size - 2 - used) & ~1u;
+}
+
+// Wait until want dwords are free, or the ring is at least half empty for
+// bigger submissions. Returns the space, or 0 if the CCE stopped fetching.
+static uint32_t
+ring_wait_space(ati_r128_ring_t *ring, size_t want)
+{
+    if (want > ring->size / 2)
+        want = ring->size / 2;
+
+    uint32_t space = ring_space(ring);
+    if (space >= want)
+        return space;
+
+    ring->space_waits++;
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_CCE_US);
+    while (ati_wait_backoff(&w)) {
+        space = ring_space(ring);
+        if (space >= want) {
+            ati_wait_end(&w, true);
+            return space;
+        }
+    }
+    ati_wait_end(&w, false);
+    printf("Timed out waiting for PM4 ring space (rptr %u, wptr %u)\n",
+           ati_r128_ring_rptr(ring), ring->wptr);
+    return 0;
+}
+
+static void
+ring_emit(ati_r128_ring_t *ring, uint32_t dword)
+{
+    ring->ring[ring->wptr] = dword;
+    ring->wptr = (ring->wptr + 1) & ring->mask;
+    if (ring->wptr == 0)
+        ring->wraps++;
+}
+
+bool
+ati_r128_ring_submit(ati_r128_ring_t *ring, const uint32_t *packets,
+                     size_t dwords)
+{
+    while (dwords > 0) {
+        uint32_t space = ring_wait_space(ring, (dwords + 1) & ~(size_t) 1);
+        if (space == 0)
+            return false;
+
+        // Pieces before the last stay even, so padding only ever follows
+        // the end of a packet
+        size_t n = dwords < space ? dwords : space;
+        for (size_t i = 0; i < n; i++)
+            ring_emit(ring, packets[i]);
+        packets += n;
+        dwords -= n;
+        if (dwords == 0 && (ring->wptr & 1))
+            ring_emit(ring, CCE_PKT2());
+        ring->dwords += n + (n & 1);
+
+        // The ring is cached memory: make sure the packets are globally
+        // visible before the CCE is told to fetch them
+        __sync_synchronize();
+        wr_r128_pm4_buffer_dl_wptr(ring->dev, ring->wptr);
+        ring->commits++;
+    }
+    return true;
+}
+
+bool
+ati_r128_ring_wait_idle(ati_r128_ring_t *ring)
+{
+    ATI_WAIT_SITE(site);
+    ati_wait_t w;
+    ati_wait_begin(&w, &site, ATI_WAIT_CCE_US);
+    do {
+        if (ati_r128_ring_rptr(ring) == ring->wptr) {
+            ati_wait_end(&w, true);
+            return ati_r128_cce_wait_for_idle(ring->dev) == 0;
+        }
+    } while (ati_wait_backoff(&w));
+    ati_wait_end(&w, false);
+    printf("Timed out waiting for the PM4 ring to drain (rptr %u, wptr %u)\n",
+           ati_r128_ring_rptr(ring), ring->wptr);
+    return false;
+}
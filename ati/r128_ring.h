@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#ifndef R128_RING_H
+#define R128_RING_H
+
+#include "ati.h"
+
+/* Rage 128 bus-master ring buffer.
+ *
+ * The CCE fetches packets from a power-of-two ring at the start of
+ * r128_gart_mem. The host copies packets in at its write pointer and
+ * publishes it through PM4_BUFFER_DL_WPTR; the CCE writes its read pointer
+ * back to a dword in system memory as it fetches, so waiting for space or
+ * for completion polls RAM rather than MMIO. The writeback is only trusted
+ * once it has been seen to match PM4_BUFFER_DL_RPTR; until then the read
+ * pointer comes from the register.
+ *
+ * Packets may straddle the end of the ring. A submission bigger than the
+ * free space is fed in as the CCE catches up, and its last commit is padded
+ * to a whole qword with type-2 packets, as the PIO path pads to a FIFO pair.
+ */
+
+#define R128_RING_MIN_L2QW 1
+#define R128_RING_MAX_L2QW 13 // 64 KB
+
+typedef struct {
+    ati_device_t *dev;
+    volatile uint32_t *ring;
+    volatile uint32_t *rptr_wb;
+    uint32_t size; // In dwords
+    uint32_t mask;
+    uint32_t wptr; // Next dword the host writes, last one committed
+    bool wb_ok;    // The read pointer writeback has been seen to work
+    // Statistics
+    uint64_t dwords;      // Submitted, padding included
+    uint32_t commits;     // PM4_BUFFER_DL_WPTR writes
+    uint32_t wraps;
+    uint32_t space_waits; // Times a submission found the ring full
+    uint32_t mmio_polls;  // Read pointer reads that went to the register
+} ati_r128_ring_t;
+
+// Map the ring through the GART, load the microcode and start the CCE in
+// 192BM mode with a ring of 2^size_l2qw qwords. Returns false on a
+// non-R128 device, an unsupported size, off bare metal, where the GART
+// can't be set up, or while another device has r128_gart_mem.
+bool ati_r128_ring_init(ati_device_t *dev, ati_r128_ring_t *ring,
+                        uint32_t size_l2qw);
+// Drain the ring, stop the CCE and release r128_gart_mem
+void ati_r128_ring_fini(ati_r128_ring_t *ring);
+
+// Copy packets into the ring and commit them. Returns false if the CCE
+// stopped fetching before they all fit.
+bool ati_r128_ring_submit(ati_r128_ring_t *ring, const uint32_t *packets,
+                          size_t dwords);
+// Where the CCE has fetched up to
+uint32_t ati_r128_ring_rptr(ati_r128_ring_t *ring);
+// Wait for the CCE to fetch everything committed and go idle
+bool ati_r128_ring_wait_idle(ati_r128_ring_t *ring);
+
+#endif
@@ -0,0 +1,788 @@
+// Auto-generated from registers/common.yaml - DO NOT EDIT
+// Generated by: bin/generate_registers --chip common
+//
+// Common (shared between R128 and R100) register definitions.
+//
+// Field values are PRE-SHIFTED and can be ORed directly into register values.
+// Example: reg |= GMC_BRUSH_DATATYPE_SOLIDCOLOR | GMC_ROP3_SRCCOPY;
+
+#ifndef COMMON_REGS_GEN_H
+#define COMMON_REGS_GEN_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+// Named value entry for multi-bit fields
+typedef struct {
+    const char *name;
+    uint32_t value;  // raw, unshifted value
+} field_value_t;
+
+// Field entry structure for REPL field display
+typedef struct {
+    const char *name;
+    uint8_t shift;
+    uint8_t width;
+    uint8_t flags;
+    const field_value_t *values;  // NULL if no named values
+} field_entry_t;
+
+// Flags (for registers and fields)
+enum {
+    FLAG_NO_READ           = (1 << 0),  // Cannot be read (write-only)
+    FLAG_NO_WRITE          = (1 << 1),  // Cannot be written (read-only)
+    FLAG_READ_SIDE_EFFECTS = (1 << 2),  // Reading modifies hardware state
+    FLAG_INDIRECT          = (1 << 3),  // Access requires index register set first
+    FLAG_REVERSE_ENGINEERED = (1 << 4), // Discovered through hardware testing
+    FLAG_SHADOW            = (1 << 5),  // Only changes when written; reads may be cached
+    FLAG_NO_SNAPSHOT       = (1 << 6),  // Left out of state snapshots
+};
+
+
+// ============================================================================
+// Field Constants
+// ============================================================================
+
+// CRTC_EXT_CNTL fields
+enum {
+    CRTC_VGA_XOVERSCAN = (1u << 0),
+    VGA_BLINK_RATE_SHIFT = 1,
+    VGA_BLINK_RATE_MASK = 0x6u,
+    VGA_ATI_LINEAR = (1u << 3),
+    VGA_128KAP_PAGING = (1u << 4),
+    VGA_TEXT_132 = (1u << 5),
+    VGA_XCRT_CNT_EN = (1u << 6),
+    CRTC_HSYNC_DIS = (1u << 8),
+    CRTC_VSYNC_DIS = (1u << 9),
+    CRTC_DISPLAY_DIS = (1u << 10),
+    CRTC_SYNC_TRISTATE = (1u << 11),
+    CRTC_HSYNC_TRISTATE = (1u << 12),
+    CRTC_VSYNC_TRISTATE = (1u << 13),
+    CRTC_CRT_ON = (1u << 15),
+    VGA_CUR_B_TEST = (1u << 17),
+    VGA_PACK_DIS = (1u << 18),
+    VGA_MEM_PS_EN = (1u << 19),
+    VGA_READ_PREFETCH_DIS = (1u << 20),
+    DFIFO_EXTSENSE = (1u << 21),
+    FP_OUT_EN = (1u << 22),
+    FP_ACTIVE = (1u << 23),
+    VCRTC_IDX_MASTER_SHIFT = 24,
+    VCRTC_IDX_MASTER_MASK = 0x7f000000u,
+};
+
+// CRTC_H_TOTAL_DISP fields
+enum {
+    CRTC_H_TOTAL_SHIFT = 0,
+    CRTC_H_TOTAL_MASK = 0x1ffu,
+    CRTC_H_DISP_SHIFT = 16,
+    CRTC_H_DISP_MASK = 0xff0000u,
+};
+
+// CRTC_H_SYNC_STRT_WID fields
+enum {
+    CRTC_H_SYNC_STRT_PIX_SHIFT = 0,
+    CRTC_H_SYNC_STRT_PIX_MASK = 0x7u,
+    CRTC_H_SYNC_STRT_CHAR_SHIFT = 3,
+    CRTC_H_SYNC_STRT_CHAR_MASK = 0xff8u,
+    CRTC_H_SYNC_WID_SHIFT = 16,
+    CRTC_H_SYNC_WID_MASK = 0x3f0000u,
+    CRTC_H_SYNC_POL = (1u << 23),
+};
+
+// CRTC_V_TOTAL_DISP fields
+enum {
+    CRTC_V_TOTAL_SHIFT = 0,
+    CRTC_V_TOTAL_MASK = 0x7ffu,
+    CRTC_V_DISP_SHIFT = 16,
+    CRTC_V_DISP_MASK = 0x7ff0000u,
+};
+
+// CRTC_V_SYNC_STRT_WID fields
+enum {
+    CRTC_V_SYNC_STRT_SHIFT = 0,
+    CRTC_V_SYNC_STRT_MASK = 0x7ffu,
+    CRTC_V_SYNC_WID_SHIFT = 16,
+    CRTC_V_SYNC_WID_MASK = 0x1f0000u,
+    CRTC_V_SYNC_POL = (1u << 23),
+};
+
+// DAC_CNTL fields
+enum {
+    DAC_RANGE_CNTL_SHIFT = 0,
+    DAC_RANGE_CNTL_MASK = 0x3u,
+    DAC_BLANKING = (1u << 2),
+    DAC_CMP_EN = (1u << 3),
+    DAC_CMP_OUT_R = (1u << 4),
+    DAC_CMP_OUT_G = (1u << 5),
+    DAC_CMP_OUT_B = (1u << 6),
+    DAC_CMP_OUTPUT = (1u << 7),
+    DAC_8BIT_EN = (1u << 8),
+    DAC_4BPP_PIX_ORDER = (1u << 9),
+    DAC_TVO_EN = (1u << 10),
+    DAC_TVO_OVR_EXCL = (1u << 11),
+    DAC_TVO_16BPP_DITH_EN = (1u << 12),
+    DAC_VGA_ADR_EN = (1u << 13),
+    DAC_EXPAND_MODE = (1u << 14),
+    DAC_PDWN = (1u << 15),
+    CRT_SENSE = (1u << 16),
+    CRT_DETECTION_ON = (1u << 17),
+    DAC_CRC_CONT_EN = (1u << 18),
+    DAC_CRC_EN = (1u << 19),
+    DAC_CRC_FIELD = (1u << 20),
+    DAC_LUT_COUNTER_LIMIT_SHIFT = 21,
+    DAC_LUT_COUNTER_LIMIT_MASK = 0x600000u,
+    DAC_LUT_READ_SEL = (1u << 23),
+    DAC_MASK_SHIFT = 24,
+    DAC_MASK_MASK = 0xff000000u,
+};
+
+// GEN_INT_CNTL fields
+enum {
+    CRTC_VBLANK_INT_EN = (1u << 0),
+    CRTC_VLINE_INT_EN = (1u << 1),
+    CRTC_VSYNC_INT_EN = (1u << 2),
+    SNAPSHOT_INT_EN = (1u << 3),
+    FP_DETECT_MASK = (1u << 4),
+    CRTC2_VLINE_MASK = (1u << 5),
+    CRTC2_VSYNC_MASK = (1u << 6),
+    SNAPSHOT2_MASK = (1u << 7),
+    CRTC_VBLANK_MASK = (1u << 9),
+    FP_DETECT_INT_EN = (1u << 10),
+    VSYNC_DIFF_OVER_LIMIT_MASK = (1u << 11),
+    BUSMASTER_EOL_INT_EN = (1u << 16),
+    I2C_INT_EN = (1u << 17),
+    MPP_GP_INT_EN = (1u << 18),
+    GUI_IDLE_INT_EN = (1u << 19),
+    VIPH_INT_EN = (1u << 24),
+    SW_INT_EN = (1u << 25),
+    GEYSERVILLE_MASK = (1u << 27),
+    HDCP_AUTHORIZED_INT_MASK = (1u << 28),
+    DVI_I2C_INT_MASK = (1u << 29),
+    GUIDMA_MASK = (1u << 30),
+};
+
+// GUI_PROBE fields
+enum {
+    GUI_STATE_SHIFT = 0,
+    GUI_STATE_MASK = 0x7u,
+    GUI_STATE_IDLE = 0u,
+    GUI_STATE_DO_COLOR_WRITE = 1u,
+    GUI_STATE_DO_SPAN_EVEN = 2u,
+    GUI_STATE_DO_SPAN = 3u,
+    GUI_STATE_WAIT_FOR_SPAN = 6u,
+    GUI_STATE_WAIT_FOR_PIPE_EMPTY = 7u,
+    GUI_SPAN_REQ = (1u << 8),
+    GUI_SPAN_RDY = (1u << 9),
+    GUI_REQ_SRCS = (1u << 10),
+    GUI_HOST_REQ = (1u << 11),
+    GUI_HOST_RDY = (1u << 12),
+    GUI_SRC_REQ = (1u << 13),
+    GUI_SRC_RDY = (1u << 14),
+    GUI_E3D_REQ = (1u << 15),
+    GUI_E3D_RDY = (1u << 16),
+    GUI_DST_REQ = (1u << 17),
+    GUI_DST_RDY = (1u << 18),
+    GUI_WRT_REQ = (1u << 19),
+    GUI_WRT_ZS_REQ = (1u << 20),
+    GUI_WRT_RDY = (1u << 21),
+};
+
+// DP_MIX fields
+enum {
+    DP_SRC_SOURCE_SHIFT = 8,
+    DP_SRC_SOURCE_MASK = 0x700u,
+    DP_SRC_SOURCE_MEMORY = 0x200u,
+    DP_SRC_SOURCE_HOST_DATA = 0x300u,
+    DP_SRC_SOURCE_HOST_DATA_ALIGNED = 0x400u,
+    DP_ROP3_SHIFT = 16,
+    DP_ROP3_MASK = 0xff0000u,
+};
+
+// DP_CNTL fields
+enum {
+    DST_X_LEFT_TO_RIGHT = (1u << 0),
+    DST_Y_TOP_TO_BOTTOM = (1u << 1),
+    DST_Y_MAJOR = (1u << 2),
+    DST_X_TILE = (1u << 3),
+    DST_Y_TILE = (1u << 4),
+    DST_LAST_PEL = (1u << 5),
+    TRAIL_X_DIR = (1u << 6),
+    TRAIL_FILL_DIR = (1u << 7),
+    BRES_SIGN = (1u << 8),
+    DP_CULL_TRI = (1u << 9),
+    POLY_LINE = (1u << 15),
+    DP_RASTER_STALL = (1u << 16),
+    DP_TRI_DIS = (1u << 17),
+    DP_POLY_EDGE = (1u << 18),
+    ANTI_ALIAS_INV_DMAJOR_SHIFT = 19,
+    ANTI_ALIAS_INV_DMAJOR_MASK = 0x780000u,
+    ANTI_ALIAS_SHIFT_SHIFT = 23,
+    ANTI_ALIAS_SHIFT_MASK = 0xf800000u,
+    ANTI_ALIAS_SLOPE_SHIFT = 28,
+    ANTI_ALIAS_SLOPE_MASK = 0xf0000000u,
+};
+
+// DEFAULT_SC_BOTTOM_RIGHT fields
+enum {
+    DEFAULT_SC_RIGHT_SHIFT = 0,
+    DEFAULT_SC_RIGHT_MASK = 0x3fffu,
+    DEFAULT_SC_BOTTOM_SHIFT = 16,
+    DEFAULT_SC_BOTTOM_MASK = 0x3fff0000u,
+};
+
+// ============================================================================
+// Field Value Tables (for REPL display of named values)
+// ============================================================================
+
+static const field_value_t gui_state_values[] = {
+    {"IDLE", 0},
+    {"DO_COLOR_WRITE", 1},
+    {"DO_SPAN_EVEN", 2},
+    {"DO_SPAN", 3},
+    {"WAIT_FOR_SPAN", 6},
+    {"WAIT_FOR_PIPE_EMPTY", 7},
+    {NULL, 0}
+};
+
+static const field_value_t dp_src_source_values[] = {
+    {"MEMORY", 2},
+    {"HOST_DATA", 3},
+    {"HOST_DATA_ALIGNED", 4},
+    {NULL, 0}
+};
+
+// ============================================================================
+// Field Tables (for REPL display)
+// ============================================================================
+
+static const field_entry_t crtc_ext_cntl_fields[] = {
+    {"CRTC_VGA_XOVERSCAN", 0, 1, 0, NULL},
+    {"VGA_BLINK_RATE", 1, 2, 0, NULL},
+    {"VGA_ATI_LINEAR", 3, 1, 0, NULL},
+    {"VGA_128KAP_PAGING", 4, 1, 0, NULL},
+    {"VGA_TEXT_132", 5, 1, 0, NULL},
+    {"VGA_XCRT_CNT_EN", 6, 1, 0, NULL},
+    {"CRTC_HSYNC_DIS", 8, 1, 0, NULL},
+    {"CRTC_VSYNC_DIS", 9, 1, 0, NULL},
+    {"CRTC_DISPLAY_DIS", 10, 1, 0, NULL},
+    {"CRTC_SYNC_TRISTATE", 11, 1, 0, NULL},
+    {"CRTC_HSYNC_TRISTATE", 12, 1, 0, NULL},
+    {"CRTC_VSYNC_TRISTATE", 13, 1, 0, NULL},
+    {"CRTC_CRT_ON", 15, 1, 0, NULL},
+    {"VGA_CUR_B_TEST", 17, 1, 0, NULL},
+    {"VGA_PACK_DIS", 18, 1, 0, NULL},
+    {"VGA_MEM_PS_EN", 19, 1, 0, NULL},
+    {"VGA_READ_PREFETCH_DIS", 20, 1, 0, NULL},
+    {"DFIFO_EXTSENSE", 21, 1, 0, NULL},
+    {"FP_OUT_EN", 22, 1, 0, NULL},
+    {"FP_ACTIVE", 23, 1, 0, NULL},
+    {"VCRTC_IDX_MASTER", 24, 7, 0, NULL},
+    {"(reserved)", 7, 1, 0, NULL},
+    {"(reserved)", 14, 1, 0, NULL},
+    {"(reserved)", 16, 1, 0, NULL},
+    {"(reserved)", 31, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t crtc_h_total_disp_fields[] = {
+    {"CRTC_H_TOTAL", 0, 9, 0, NULL},
+    {"CRTC_H_DISP", 16, 8, 0, NULL},
+    {"(reserved)", 9, 7, 0, NULL},
+    {"(reserved)", 24, 8, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t crtc_h_sync_strt_wid_fields[] = {
+    {"CRTC_H_SYNC_STRT_PIX", 0, 3, 0, NULL},
+    {"CRTC_H_SYNC_STRT_CHAR", 3, 9, 0, NULL},
+    {"CRTC_H_SYNC_WID", 16, 6, 0, NULL},
+    {"CRTC_H_SYNC_POL", 23, 1, 0, NULL},
+    {"(reserved)", 12, 4, 0, NULL},
+    {"(reserved)", 22, 1, 0, NULL},
+    {"(reserved)", 24, 8, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t crtc_v_total_disp_fields[] = {
+    {"CRTC_V_TOTAL", 0, 11, 0, NULL},
+    {"CRTC_V_DISP", 16, 11, 0, NULL},
+    {"(reserved)", 11, 5, 0, NULL},
+    {"(reserved)", 27, 5, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t crtc_v_sync_strt_wid_fields[] = {
+    {"CRTC_V_SYNC_STRT", 0, 11, 0, NULL},
+    {"CRTC_V_SYNC_WID", 16, 5, 0, NULL},
+    {"CRTC_V_SYNC_POL", 23, 1, 0, NULL},
+    {"(reserved)", 11, 5, 0, NULL},
+    {"(reserved)", 21, 2, 0, NULL},
+    {"(reserved)", 24, 8, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t dac_cntl_fields[] = {
+    {"DAC_RANGE_CNTL", 0, 2, 0, NULL},
+    {"DAC_BLANKING", 2, 1, 0, NULL},
+    {"DAC_CMP_EN", 3, 1, 0, NULL},
+    {"DAC_CMP_OUT_R", 4, 1, 0, NULL},
+    {"DAC_CMP_OUT_G", 5, 1, 0, NULL},
+    {"DAC_CMP_OUT_B", 6, 1, 0, NULL},
+    {"DAC_CMP_OUTPUT", 7, 1, 0, NULL},
+    {"DAC_8BIT_EN", 8, 1, 0, NULL},
+    {"DAC_4BPP_PIX_ORDER", 9, 1, 0, NULL},
+    {"DAC_TVO_EN", 10, 1, 0, NULL},
+    {"DAC_TVO_OVR_EXCL", 11, 1, 0, NULL},
+    {"DAC_TVO_16BPP_DITH_EN", 12, 1, 0, NULL},
+    {"DAC_VGA_ADR_EN", 13, 1, 0, NULL},
+    {"DAC_EXPAND_MODE", 14, 1, 0, NULL},
+    {"DAC_PDWN", 15, 1, 0, NULL},
+    {"CRT_SENSE", 16, 1, 0, NULL},
+    {"CRT_DETECTION_ON", 17, 1, 0, NULL},
+    {"DAC_CRC_CONT_EN", 18, 1, 0, NULL},
+    {"DAC_CRC_EN", 19, 1, 0, NULL},
+    {"DAC_CRC_FIELD", 20, 1, 0, NULL},
+    {"DAC_LUT_COUNTER_LIMIT", 21, 2, 0, NULL},
+    {"DAC_LUT_READ_SEL", 23, 1, 0, NULL},
+    {"DAC_MASK", 24, 8, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t gen_int_cntl_fields[] = {
+    {"CRTC_VBLANK_INT_EN", 0, 1, 0, NULL},
+    {"CRTC_VLINE_INT_EN", 1, 1, 0, NULL},
+    {"CRTC_VSYNC_INT_EN", 2, 1, 0, NULL},
+    {"SNAPSHOT_INT_EN", 3, 1, 0, NULL},
+    {"FP_DETECT_MASK", 4, 1, 0, NULL},
+    {"CRTC2_VLINE_MASK", 5, 1, 0, NULL},
+    {"CRTC2_VSYNC_MASK", 6, 1, 0, NULL},
+    {"SNAPSHOT2_MASK", 7, 1, 0, NULL},
+    {"CRTC_VBLANK_MASK", 9, 1, 0, NULL},
+    {"FP_DETECT_INT_EN", 10, 1, 0, NULL},
+    {"VSYNC_DIFF_OVER_LIMIT_MASK", 11, 1, 0, NULL},
+    {"BUSMASTER_EOL_INT_EN", 16, 1, 0, NULL},
+    {"I2C_INT_EN", 17, 1, 0, NULL},
+    {"MPP_GP_INT_EN", 18, 1, 0, NULL},
+    {"GUI_IDLE_INT_EN", 19, 1, 0, NULL},
+    {"VIPH_INT_EN", 24, 1, 0, NULL},
+    {"SW_INT_EN", 25, 1, 0, NULL},
+    {"GEYSERVILLE_MASK", 27, 1, 0, NULL},
+    {"HDCP_AUTHORIZED_INT_MASK", 28, 1, 0, NULL},
+    {"DVI_I2C_INT_MASK", 29, 1, 0, NULL},
+    {"GUIDMA_MASK", 30, 1, 0, NULL},
+    {"(reserved)", 8, 1, 0, NULL},
+    {"(reserved)", 12, 4, 0, NULL},
+    {"(reserved)", 20, 4, 0, NULL},
+    {"(reserved)", 26, 1, 0, NULL},
+    {"(reserved)", 31, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t gui_probe_fields[] = {
+    {"GUI_STATE", 0, 3, 0, gui_state_values},
+    {"GUI_SPAN_REQ", 8, 1, 0, NULL},
+    {"GUI_SPAN_RDY", 9, 1, 0, NULL},
+    {"GUI_REQ_SRCS", 10, 1, 0, NULL},
+    {"GUI_HOST_REQ", 11, 1, 0, NULL},
+    {"GUI_HOST_RDY", 12, 1, 0, NULL},
+    {"GUI_SRC_REQ", 13, 1, 0, NULL},
+    {"GUI_SRC_RDY", 14, 1, 0, NULL},
+    {"GUI_E3D_REQ", 15, 1, 0, NULL},
+    {"GUI_E3D_RDY", 16, 1, 0, NULL},
+    {"GUI_DST_REQ", 17, 1, 0, NULL},
+    {"GUI_DST_RDY", 18, 1, 0, NULL},
+    {"GUI_WRT_REQ", 19, 1, 0, NULL},
+    {"GUI_WRT_ZS_REQ", 20, 1, 0, NULL},
+    {"GUI_WRT_RDY", 21, 1, 0, NULL},
+    {"(reserved)", 3, 5, 0, NULL},
+    {"(reserved)", 22, 10, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t dp_mix_fields[] = {
+    {"DP_SRC_SOURCE", 8, 3, 0, dp_src_source_values},
+    {"DP_ROP3", 16, 8, 0, NULL},
+    {"(reserved)", 0, 8, 0, NULL},
+    {"(reserved)", 11, 5, 0, NULL},
+    {"(reserved)", 24, 8, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t dp_cntl_fields[] = {
+    {"DST_X_LEFT_TO_RIGHT", 0, 1, 0, NULL},
+    {"DST_Y_TOP_TO_BOTTOM", 1, 1, 0, NULL},
+    {"DST_Y_MAJOR", 2, 1, 0, NULL},
+    {"DST_X_TILE", 3, 1, 0, NULL},
+    {"DST_Y_TILE", 4, 1, 0, NULL},
+    {"DST_LAST_PEL", 5, 1, 0, NULL},
+    {"TRAIL_X_DIR", 6, 1, 0, NULL},
+    {"TRAIL_FILL_DIR", 7, 1, 0, NULL},
+    {"BRES_SIGN", 8, 1, 0, NULL},
+    {"DP_CULL_TRI", 9, 1, 0, NULL},
+    {"POLY_LINE", 15, 1, 0, NULL},
+    {"DP_RASTER_STALL", 16, 1, 0, NULL},
+    {"DP_TRI_DIS", 17, 1, 0, NULL},
+    {"DP_POLY_EDGE", 18, 1, 0, NULL},
+    {"ANTI_ALIAS_INV_DMAJOR", 19, 4, 0, NULL},
+    {"ANTI_ALIAS_SHIFT", 23, 5, 0, NULL},
+    {"ANTI_ALIAS_SLOPE", 28, 4, 0, NULL},
+    {"(reserved)", 10, 5, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t default_sc_bottom_right_fields[] = {
+    {"DEFAULT_SC_RIGHT", 0, 14, 0, NULL},
+    {"DEFAULT_SC_BOTTOM", 16, 14, 0, NULL},
+    {"(reserved)", 14, 2, 0, NULL},
+    {"(reserved)", 30, 2, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+// ============================================================================
+// Alias Tables (for REPL display)
+// ============================================================================
+
+// ============================================================================
+// Register Offsets
+// ============================================================================
+
+enum {
+    CONFIG_MEMSIZE = 0xf8,
+    CRTC_EXT_CNTL = 0x54,
+    CRTC_H_TOTAL_DISP = 0x200,
+    CRTC_H_SYNC_STRT_WID = 0x204,
+    CRTC_V_TOTAL_DISP = 0x208,
+    CRTC_V_SYNC_STRT_WID = 0x20c,
+    CRTC_OFFSET = 0x224,
+    CRTC_OFFSET_CNTL = 0x228,
+    DAC_CNTL = 0x58,
+    PALETTE_INDEX = 0xb0,
+    PALETTE_DATA = 0xb4,
+    GEN_INT_CNTL = 0x40,
+    OVR_CLR = 0x230,
+    OVR_WID_LEFT_RIGHT = 0x234,
+    OVR_WID_TOP_BOTTOM = 0x238,
+    OV0_SCALE_CNTL = 0x420,
+    MPP_TB_CONFIG = 0x1c0,
+    MPP_GP_CONFIG = 0x1c8,
+    SUBPIC_CNTL = 0x540,
+    I2C_CNTL_1 = 0x94,
+    CAP0_TRIG_CNTL = 0x950,
+    CAP1_TRIG_CNTL = 0x9c0,
+    GUI_PROBE = 0x16bc,
+    DP_MIX = 0x16c8,
+    DP_WRITE_MSK = 0x16cc,
+    DP_CNTL = 0x16c0,
+    DP_BRUSH_BKGD_CLR = 0x15dc,
+    DP_BRUSH_FRGD_CLR = 0x1578,
+    DP_SRC_BKGD_CLR = 0x15dc,
+    DP_SRC_FRGD_CLR = 0x15d8,
+    BIOS_0_SCRATCH = 0x10,
+    BIOS_1_SCRATCH = 0x14,
+    BIOS_2_SCRATCH = 0x18,
+    BIOS_3_SCRATCH = 0x1c,
+    GUI_SCRATCH_REG0 = 0x15e0,
+    GUI_SCRATCH_REG1 = 0x15e4,
+    GUI_SCRATCH_REG2 = 0x15e8,
+    GUI_SCRATCH_REG3 = 0x15ec,
+    GUI_SCRATCH_REG4 = 0x15f0,
+    GUI_SCRATCH_REG5 = 0x15f4,
+    SC_LEFT = 0x1640,
+    SC_TOP = 0x1648,
+    SC_RIGHT = 0x1644,
+    SC_BOTTOM = 0x164c,
+    DEFAULT_SC_BOTTOM_RIGHT = 0x16e8,
+    SC_TOP_LEFT = 0x16ec,
+    SC_BOTTOM_RIGHT = 0x16f0,
+    SRC_SC_BOTTOM = 0x165c,
+    SRC_SC_RIGHT = 0x1654,
+    SRC_SC_BOTTOM_RIGHT = 0x16f4,
+    AUX_SC_CNTL = 0x1660,
+    DST_OFFSET = 0x1404,
+    DST_PITCH = 0x1408,
+    DST_X = 0x141c,
+    DST_Y = 0x1420,
+    DST_X_Y = 0x1594,
+    DST_Y_X = 0x1438,
+    DST_WIDTH = 0x140c,
+    DST_HEIGHT = 0x1410,
+    DST_WIDTH_HEIGHT = 0x1598,
+    DST_BRES_ERR = 0x1628,
+    DST_BRES_INC = 0x162c,
+    DST_BRES_DEC = 0x1630,
+    SRC_OFFSET = 0x15ac,
+    SRC_PITCH = 0x15b0,
+    SRC_X = 0x1414,
+    SRC_Y = 0x1418,
+    SRC_X_Y = 0x1590,
+    SRC_Y_X = 0x1434,
+    HOST_DATA0 = 0x17c0,
+    HOST_DATA1 = 0x17c4,
+    HOST_DATA2 = 0x17c8,
+    HOST_DATA3 = 0x17cc,
+    HOST_DATA4 = 0x17d0,
+    HOST_DATA5 = 0x17d4,
+    HOST_DATA6 = 0x17d8,
+    HOST_DATA7 = 0x17dc,
+    HOST_DATA_LAST = 0x17e0,
+    MM_INDEX = 0x0,
+    MM_DATA = 0x4,
+};
+
+// ============================================================================
+// COMMON_REGISTERS X-macro
+// Used to generate read/write functions, register tables, etc.
+// X(func_name, const_name, offset, flags, fields, aliases)
+// ============================================================================
+
+#define COMMON_REGISTERS \
+  X(config_memsize, CONFIG_MEMSIZE, 0xf8, 0, NULL, NULL) \
+  X(crtc_ext_cntl, CRTC_EXT_CNTL, 0x54, 0, crtc_ext_cntl_fields, NULL) \
+  X(crtc_h_total_disp, CRTC_H_TOTAL_DISP, 0x200, FLAG_SHADOW, crtc_h_total_disp_fields, NULL) \
+  X(crtc_h_sync_strt_wid, CRTC_H_SYNC_STRT_WID, 0x204, FLAG_SHADOW, crtc_h_sync_strt_wid_fields, NULL) \
+  X(crtc_v_total_disp, CRTC_V_TOTAL_DISP, 0x208, FLAG_SHADOW, crtc_v_total_disp_fields, NULL) \
+  X(crtc_v_sync_strt_wid, CRTC_V_SYNC_STRT_WID, 0x20c, FLAG_SHADOW, crtc_v_sync_strt_wid_fields, NULL) \
+  X(crtc_offset, CRTC_OFFSET, 0x224, 0, NULL, NULL) \
+  X(crtc_offset_cntl, CRTC_OFFSET_CNTL, 0x228, 0, NULL, NULL) \
+  X(dac_cntl, DAC_CNTL, 0x58, 0, dac_cntl_fields, NULL) \
+  X(palette_index, PALETTE_INDEX, 0xb0, 0, NULL, NULL) \
+  X(palette_data, PALETTE_DATA, 0xb4, FLAG_READ_SIDE_EFFECTS, NULL, NULL) \
+  X(gen_int_cntl, GEN_INT_CNTL, 0x40, 0, gen_int_cntl_fields, NULL) \
+  X(ovr_clr, OVR_CLR, 0x230, FLAG_SHADOW, NULL, NULL) \
+  X(ovr_wid_left_right, OVR_WID_LEFT_RIGHT, 0x234, FLAG_SHADOW, NULL, NULL) \
+  X(ovr_wid_top_bottom, OVR_WID_TOP_BOTTOM, 0x238, FLAG_SHADOW, NULL, NULL) \
+  X(ov0_scale_cntl, OV0_SCALE_CNTL, 0x420, 0, NULL, NULL) \
+  X(mpp_tb_config, MPP_TB_CONFIG, 0x1c0, 0, NULL, NULL) \
+  X(mpp_gp_config, MPP_GP_CONFIG, 0x1c8, 0, NULL, NULL) \
+  X(subpic_cntl, SUBPIC_CNTL, 0x540, 0, NULL, NULL) \
+  X(i2c_cntl_1, I2C_CNTL_1, 0x94, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(cap0_trig_cntl, CAP0_TRIG_CNTL, 0x950, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(cap1_trig_cntl, CAP1_TRIG_CNTL, 0x9c0, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(gui_probe, GUI_PROBE, 0x16bc, FLAG_NO_WRITE, gui_probe_fields, NULL) \
+  X(dp_mix, DP_MIX, 0x16c8, 0, dp_mix_fields, NULL) \
+  X(dp_write_msk, DP_WRITE_MSK, 0x16cc, 0, NULL, NULL) \
+  X(dp_cntl, DP_CNTL, 0x16c0, 0, dp_cntl_fields, NULL) \
+  X(dp_brush_bkgd_clr, DP_BRUSH_BKGD_CLR, 0x15dc, 0, NULL, NULL) \
+  X(dp_brush_frgd_clr, DP_BRUSH_FRGD_CLR, 0x1578, 0, NULL, NULL) \
+  X(dp_src_bkgd_clr, DP_SRC_BKGD_CLR, 0x15dc, 0, NULL, NULL) \
+  X(dp_src_frgd_clr, DP_SRC_FRGD_CLR, 0x15d8, 0, NULL, NULL) \
+  X(bios_0_scratch, BIOS_0_SCRATCH, 0x10, FLAG_SHADOW, NULL, NULL) \
+  X(bios_1_scratch, BIOS_1_SCRATCH, 0x14, FLAG_SHADOW, NULL, NULL) \
+  X(bios_2_scratch, BIOS_2_SCRATCH, 0x18, FLAG_SHADOW, NULL, NULL) \
+  X(bios_3_scratch, BIOS_3_SCRATCH, 0x1c, FLAG_SHADOW, NULL, NULL) \
+  X(gui_scratch_reg0, GUI_SCRATCH_REG0, 0x15e0, 0, NULL, NULL) \
+  X(gui_scratch_reg1, GUI_SCRATCH_REG1, 0x15e4, 0, NULL, NULL) \
+  X(gui_scratch_reg2, GUI_SCRATCH_REG2, 0x15e8, 0, NULL, NULL) \
+  X(gui_scratch_reg3, GUI_SCRATCH_REG3, 0x15ec, 0, NULL, NULL) \
+  X(gui_scratch_reg4, GUI_SCRATCH_REG4, 0x15f0, 0, NULL, NULL) \
+  X(gui_scratch_reg5, GUI_SCRATCH_REG5, 0x15f4, 0, NULL, NULL) \
+  X(sc_left, SC_LEFT, 0x1640, 0, NULL, NULL) \
+  X(sc_top, SC_TOP, 0x1648, 0, NULL, NULL) \
+  X(sc_right, SC_RIGHT, 0x1644, 0, NULL, NULL) \
+  X(sc_bottom, SC_BOTTOM, 0x164c, 0, NULL, NULL) \
+  X(default_sc_bottom_right, DEFAULT_SC_BOTTOM_RIGHT, 0x16e8, FLAG_SHADOW, default_sc_bottom_right_fields, NULL) \
+  X(sc_top_left, SC_TOP_LEFT, 0x16ec, FLAG_NO_READ, NULL, NULL) \
+  X(sc_bottom_right, SC_BOTTOM_RIGHT, 0x16f0, FLAG_NO_READ, NULL, NULL) \
+  X(src_sc_bottom, SRC_SC_BOTTOM, 0x165c, 0, NULL, NULL) \
+  X(src_sc_right, SRC_SC_RIGHT, 0x1654, 0, NULL, NULL) \
+  X(src_sc_bottom_right, SRC_SC_BOTTOM_RIGHT, 0x16f4, FLAG_NO_READ, NULL, NULL) \
+  X(aux_sc_cntl, AUX_SC_CNTL, 0x1660, 0, NULL, NULL) \
+  X(dst_offset, DST_OFFSET, 0x1404, 0, NULL, NULL) \
+  X(dst_pitch, DST_PITCH, 0x1408, 0, NULL, NULL) \
+  X(dst_x, DST_X, 0x141c, 0, NULL, NULL) \
+  X(dst_y, DST_Y, 0x1420, 0, NULL, NULL) \
+  X(dst_x_y, DST_X_Y, 0x1594, FLAG_NO_READ, NULL, NULL) \
+  X(dst_y_x, DST_Y_X, 0x1438, FLAG_NO_READ, NULL, NULL) \
+  X(dst_width, DST_WIDTH, 0x140c, 0, NULL, NULL) \
+  X(dst_height, DST_HEIGHT, 0x1410, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(dst_width_height, DST_WIDTH_HEIGHT, 0x1598, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(dst_bres_err, DST_BRES_ERR, 0x1628, 0, NULL, NULL) \
+  X(dst_bres_inc, DST_BRES_INC, 0x162c, 0, NULL, NULL) \
+  X(dst_bres_dec, DST_BRES_DEC, 0x1630, 0, NULL, NULL) \
+  X(src_offset, SRC_OFFSET, 0x15ac, 0, NULL, NULL) \
+  X(src_pitch, SRC_PITCH, 0x15b0, 0, NULL, NULL) \
+  X(src_x, SRC_X, 0x1414, 0, NULL, NULL) \
+  X(src_y, SRC_Y, 0x1418, 0, NULL, NULL) \
+  X(src_x_y, SRC_X_Y, 0x1590, FLAG_NO_READ, NULL, NULL) \
+  X(src_y_x, SRC_Y_X, 0x1434, FLAG_NO_READ, NULL, NULL) \
+  X(host_data0, HOST_DATA0, 0x17c0, FLAG_NO_READ, NULL, NULL) \
+  X(host_data1, HOST_DATA1, 0x17c4, FLAG_NO_READ, NULL, NULL) \
+  X(host_data2, HOST_DATA2, 0x17c8, FLAG_NO_READ, NULL, NULL) \
+  X(host_data3, HOST_DATA3, 0x17cc, FLAG_NO_READ, NULL, NULL) \
+  X(host_data4, HOST_DATA4, 0x17d0, FLAG_NO_READ, NULL, NULL) \
+  X(host_data5, HOST_DATA5, 0x17d4, FLAG_NO_READ, NULL, NULL) \
+  X(host_data6, HOST_DATA6, 0x17d8, FLAG_NO_READ, NULL, NULL) \
+  X(host_data7, HOST_DATA7, 0x17dc, FLAG_NO_READ, NULL, NULL) \
+  X(host_data_last, HOST_DATA_LAST, 0x17e0, FLAG_NO_READ, NULL, NULL) \
+  X(mm_index, MM_INDEX, 0x0, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(mm_data, MM_DATA, 0x4, FLAG_NO_SNAPSHOT, NULL, NULL)
+
+// ============================================================================
+// Register Accessors
+// ============================================================================
+
+#ifdef ATI_REG_ACCESSORS
+static inline uint32_t rd_config_memsize(ati_device_t *dev) { return ati_reg_read(dev, CONFIG_MEMSIZE); }
+static inline void wr_config_memsize(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, CONFIG_MEMSIZE, val); }
+static inline uint32_t rd_crtc_ext_cntl(ati_device_t *dev) { return ati_reg_read(dev, CRTC_EXT_CNTL); }
+static inline void wr_crtc_ext_cntl(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, CRTC_EXT_CNTL, val); }
+static inline uint32_t rd_crtc_h_total_disp(ati_device_t *dev) { return ati_reg_read(dev, CRTC_H_TOTAL_DISP); }
+static inline void wr_crtc_h_total_disp(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, CRTC_H_TOTAL_DISP, val); }
+static inline uint32_t rd_crtc_h_sync_strt_wid(ati_device_t *dev) { return ati_reg_read(dev, CRTC_H_SYNC_STRT_WID); }
+static inline void wr_crtc_h_sync_strt_wid(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, CRTC_H_SYNC_STRT_WID, val); }
+static inline uint32_t rd_crtc_v_total_disp(ati_device_t *dev) { return ati_reg_read(dev, CRTC_V_TOTAL_DISP); }
+static inline void wr_crtc_v_total_disp(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, CRTC_V_TOTAL_DISP, val); }
+static inline uint32_t rd_crtc_v_sync_strt_wid(ati_device_t *dev) { return ati_reg_read(dev, CRTC_V_SYNC_STRT_WID); }
+static inline void wr_crtc_v_sync_strt_wid(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, CRTC_V_SYNC_STRT_WID, val); }
+static inline uint32_t rd_crtc_offset(ati_device_t *dev) { return ati_reg_read(dev, CRTC_OFFSET); }
+static inline void wr_crtc_offset(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, CRTC_OFFSET, val); }
+static inline uint32_t rd_crtc_offset_cntl(ati_device_t *dev) { return ati_reg_read(dev, CRTC_OFFSET_CNTL); }
+static inline void wr_crtc_offset_cntl(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, CRTC_OFFSET_CNTL, val); }
+static inline uint32_t rd_dac_cntl(ati_device_t *dev) { return ati_reg_read(dev, DAC_CNTL); }
+static inline void wr_dac_cntl(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DAC_CNTL, val); }
+static inline uint32_t rd_palette_index(ati_device_t *dev) { return ati_reg_read(dev, PALETTE_INDEX); }
+static inline void wr_palette_index(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, PALETTE_INDEX, val); }
+static inline uint32_t rd_palette_data(ati_device_t *dev) { return ati_reg_read(dev, PALETTE_DATA); }
+static inline void wr_palette_data(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, PALETTE_DATA, val); }
+static inline uint32_t rd_gen_int_cntl(ati_device_t *dev) { return ati_reg_read(dev, GEN_INT_CNTL); }
+static inline void wr_gen_int_cntl(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, GEN_INT_CNTL, val); }
+static inline uint32_t rd_ovr_clr(ati_device_t *dev) { return ati_reg_read(dev, OVR_CLR); }
+static inline void wr_ovr_clr(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, OVR_CLR, val); }
+static inline uint32_t rd_ovr_wid_left_right(ati_device_t *dev) { return ati_reg_read(dev, OVR_WID_LEFT_RIGHT); }
+static inline void wr_ovr_wid_left_right(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, OVR_WID_LEFT_RIGHT, val); }
+static inline uint32_t rd_ovr_wid_top_bottom(ati_device_t *dev) { return ati_reg_read(dev, OVR_WID_TOP_BOTTOM); }
+static inline void wr_ovr_wid_top_bottom(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, OVR_WID_TOP_BOTTOM, val); }
+static inline uint32_t rd_ov0_scale_cntl(ati_device_t *dev) { return ati_reg_read(dev, OV0_SCALE_CNTL); }
+static inline void wr_ov0_scale_cntl(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, OV0_SCALE_CNTL, val); }
+static inline uint32_t rd_mpp_tb_config(ati_device_t *dev) { return ati_reg_read(dev, MPP_TB_CONFIG); }
+static inline void wr_mpp_tb_config(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, MPP_TB_CONFIG, val); }
+static inline uint32_t rd_mpp_gp_config(ati_device_t *dev) { return ati_reg_read(dev, MPP_GP_CONFIG); }
+static inline void wr_mpp_gp_config(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, MPP_GP_CONFIG, val); }
+static inline uint32_t rd_subpic_cntl(ati_device_t *dev) { return ati_reg_read(dev, SUBPIC_CNTL); }
+static inline void wr_subpic_cntl(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SUBPIC_CNTL, val); }
+static inline uint32_t rd_i2c_cntl_1(ati_device_t *dev) { return ati_reg_read(dev, I2C_CNTL_1); }
+static inline void wr_i2c_cntl_1(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, I2C_CNTL_1, val); }
+static inline uint32_t rd_cap0_trig_cntl(ati_device_t *dev) { return ati_reg_read(dev, CAP0_TRIG_CNTL); }
+static inline void wr_cap0_trig_cntl(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, CAP0_TRIG_CNTL, val); }
+static inline uint32_t rd_cap1_trig_cntl(ati_device_t *dev) { return ati_reg_read(dev, CAP1_TRIG_CNTL); }
+static inline void wr_cap1_trig_cntl(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, CAP1_TRIG_CNTL, val); }
+static inline uint32_t rd_gui_probe(ati_device_t *dev) { return ati_reg_read(dev, GUI_PROBE); }
+static inline void wr_gui_probe(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, GUI_PROBE, val); }
+static inline uint32_t rd_dp_mix(ati_device_t *dev) { return ati_reg_read(dev, DP_MIX); }
+static inline void wr_dp_mix(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DP_MIX, val); }
+static inline uint32_t rd_dp_write_msk(ati_device_t *dev) { return ati_reg_read(dev, DP_WRITE_MSK); }
+static inline void wr_dp_write_msk(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DP_WRITE_MSK, val); }
+static inline uint32_t rd_dp_cntl(ati_device_t *dev) { return ati_reg_read(dev, DP_CNTL); }
+static inline void wr_dp_cntl(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DP_CNTL, val); }
+static inline uint32_t rd_dp_brush_bkgd_clr(ati_device_t *dev) { return ati_reg_read(dev, DP_BRUSH_BKGD_CLR); }
+static inline void wr_dp_brush_bkgd_clr(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DP_BRUSH_BKGD_CLR, val); }
+static inline uint32_t rd_dp_brush_frgd_clr(ati_device_t *dev) { return ati_reg_read(dev, DP_BRUSH_FRGD_CLR); }
+static inline void wr_dp_brush_frgd_clr(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DP_BRUSH_FRGD_CLR, val); }
+static inline uint32_t rd_dp_src_bkgd_clr(ati_device_t *dev) { return ati_reg_read(dev, DP_SRC_BKGD_CLR); }
+static inline void wr_dp_src_bkgd_clr(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DP_SRC_BKGD_CLR, val); }
+static inline uint32_t rd_dp_src_frgd_clr(ati_device_t *dev) { return ati_reg_read(dev, DP_SRC_FRGD_CLR); }
+static inline void wr_dp_src_frgd_clr(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DP_SRC_FRGD_CLR, val); }
+static inline uint32_t rd_bios_0_scratch(ati_device_t *dev) { return ati_reg_read(dev, BIOS_0_SCRATCH); }
+static inline void wr_bios_0_scratch(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, BIOS_0_SCRATCH, val); }
+static inline uint32_t rd_bios_1_scratch(ati_device_t *dev) { return ati_reg_read(dev, BIOS_1_SCRATCH); }
+static inline void wr_bios_1_scratch(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, BIOS_1_SCRATCH, val); }
+static inline uint32_t rd_bios_2_scratch(ati_device_t *dev) { return ati_reg_read(dev, BIOS_2_SCRATCH); }
+static inline void wr_bios_2_scratch(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, BIOS_2_SCRATCH, val); }
+static inline uint32_t rd_bios_3_scratch(ati_device_t *dev) { return ati_reg_read(dev, BIOS_3_SCRATCH); }
+static inline void wr_bios_3_scratch(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, BIOS_3_SCRATCH, val); }
+static inline uint32_t rd_gui_scratch_reg0(ati_device_t *dev) { return ati_reg_read(dev, GUI_SCRATCH_REG0); }
+static inline void wr_gui_scratch_reg0(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, GUI_SCRATCH_REG0, val); }
+static inline uint32_t rd_gui_scratch_reg1(ati_device_t *dev) { return ati_reg_read(dev, GUI_SCRATCH_REG1); }
+static inline void wr_gui_scratch_reg1(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, GUI_SCRATCH_REG1, val); }
+static inline uint32_t rd_gui_scratch_reg2(ati_device_t *dev) { return ati_reg_read(dev, GUI_SCRATCH_REG2); }
+static inline void wr_gui_scratch_reg2(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, GUI_SCRATCH_REG2, val); }
+static inline uint32_t rd_gui_scratch_reg3(ati_device_t *dev) { return ati_reg_read(dev, GUI_SCRATCH_REG3); }
+static inline void wr_gui_scratch_reg3(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, GUI_SCRATCH_REG3, val); }
+static inline uint32_t rd_gui_scratch_reg4(ati_device_t *dev) { return ati_reg_read(dev, GUI_SCRATCH_REG4); }
+static inline void wr_gui_scratch_reg4(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, GUI_SCRATCH_REG4, val); }
+static inline uint32_t rd_gui_scratch_reg5(ati_device_t *dev) { return ati_reg_read(dev, GUI_SCRATCH_REG5); }
+static inline void wr_gui_scratch_reg5(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, GUI_SCRATCH_REG5, val); }
+static inline uint32_t rd_sc_left(ati_device_t *dev) { return ati_reg_read(dev, SC_LEFT); }
+static inline void wr_sc_left(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SC_LEFT, val); }
+static inline uint32_t rd_sc_top(ati_device_t *dev) { return ati_reg_read(dev, SC_TOP); }
+static inline void wr_sc_top(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SC_TOP, val); }
+static inline uint32_t rd_sc_right(ati_device_t *dev) { return ati_reg_read(dev, SC_RIGHT); }
+static inline void wr_sc_right(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SC_RIGHT, val); }
+static inline uint32_t rd_sc_bottom(ati_device_t *dev) { return ati_reg_read(dev, SC_BOTTOM); }
+static inline void wr_sc_bottom(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SC_BOTTOM, val); }
+static inline uint32_t rd_default_sc_bottom_right(ati_device_t *dev) { return ati_reg_read(dev, DEFAULT_SC_BOTTOM_RIGHT); }
+static inline void wr_default_sc_bottom_right(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DEFAULT_SC_BOTTOM_RIGHT, val); }
+static inline uint32_t rd_sc_top_left(ati_device_t *dev) { return ati_reg_read(dev, SC_TOP_LEFT); }
+static inline void wr_sc_top_left(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SC_TOP_LEFT, val); }
+static inline uint32_t rd_sc_bottom_right(ati_device_t *dev) { return ati_reg_read(dev, SC_BOTTOM_RIGHT); }
+static inline void wr_sc_bottom_right(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SC_BOTTOM_RIGHT, val); }
+static inline uint32_t rd_src_sc_bottom(ati_device_t *dev) { return ati_reg_read(dev, SRC_SC_BOTTOM); }
+static inline void wr_src_sc_bottom(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SRC_SC_BOTTOM, val); }
+static inline uint32_t rd_src_sc_right(ati_device_t *dev) { return ati_reg_read(dev, SRC_SC_RIGHT); }
+static inline void wr_src_sc_right(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SRC_SC_RIGHT, val); }
+static inline uint32_t rd_src_sc_bottom_right(ati_device_t *dev) { return ati_reg_read(dev, SRC_SC_BOTTOM_RIGHT); }
+static inline void wr_src_sc_bottom_right(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SRC_SC_BOTTOM_RIGHT, val); }
+static inline uint32_t rd_aux_sc_cntl(ati_device_t *dev) { return ati_reg_read(dev, AUX_SC_CNTL); }
+static inline void wr_aux_sc_cntl(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, AUX_SC_CNTL, val); }
+static inline uint32_t rd_dst_offset(ati_device_t *dev) { return ati_reg_read(dev, DST_OFFSET); }
+static inline void wr_dst_offset(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_OFFSET, val); }
+static inline uint32_t rd_dst_pitch(ati_device_t *dev) { return ati_reg_read(dev, DST_PITCH); }
+static inline void wr_dst_pitch(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_PITCH, val); }
+static inline uint32_t rd_dst_x(ati_device_t *dev) { return ati_reg_read(dev, DST_X); }
+static inline void wr_dst_x(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_X, val); }
+static inline uint32_t rd_dst_y(ati_device_t *dev) { return ati_reg_read(dev, DST_Y); }
+static inline void wr_dst_y(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_Y, val); }
+static inline uint32_t rd_dst_x_y(ati_device_t *dev) { return ati_reg_read(dev, DST_X_Y); }
+static inline void wr_dst_x_y(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_X_Y, val); }
+static inline uint32_t rd_dst_y_x(ati_device_t *dev) { return ati_reg_read(dev, DST_Y_X); }
+static inline void wr_dst_y_x(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_Y_X, val); }
+static inline uint32_t rd_dst_width(ati_device_t *dev) { return ati_reg_read(dev, DST_WIDTH); }
+static inline void wr_dst_width(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_WIDTH, val); }
+static inline uint32_t rd_dst_height(ati_device_t *dev) { return ati_reg_read(dev, DST_HEIGHT); }
+static inline void wr_dst_height(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_HEIGHT, val); }
+static inline uint32_t rd_dst_width_height(ati_device_t *dev) { return ati_reg_read(dev, DST_WIDTH_HEIGHT); }
+static inline void wr_dst_width_height(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_WIDTH_HEIGHT, val); }
+static inline uint32_t rd_dst_bres_err(ati_device_t *dev) { return ati_reg_read(dev, DST_BRES_ERR); }
+static inline void wr_dst_bres_err(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_BRES_ERR, val); }
+static inline uint32_t rd_dst_bres_inc(ati_device_t *dev) { return ati_reg_read(dev, DST_BRES_INC); }
+static inline void wr_dst_bres_inc(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_BRES_INC, val); }
+static inline uint32_t rd_dst_bres_dec(ati_device_t *dev) { return ati_reg_read(dev, DST_BRES_DEC); }
+static inline void wr_dst_bres_dec(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, DST_BRES_DEC, val); }
+static inline uint32_t rd_src_offset(ati_device_t *dev) { return ati_reg_read(dev, SRC_OFFSET); }
+static inline void wr_src_offset(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SRC_OFFSET, val); }
+static inline uint32_t rd_src_pitch(ati_device_t *dev) { return ati_reg_read(dev, SRC_PITCH); }
+static inline void wr_src_pitch(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SRC_PITCH, val); }
+static inline uint32_t rd_src_x(ati_device_t *dev) { return ati_reg_read(dev, SRC_X); }
+static inline void wr_src_x(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SRC_X, val); }
+static inline uint32_t rd_src_y(ati_device_t *dev) { return ati_reg_read(dev, SRC_Y); }
+static inline void wr_src_y(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SRC_Y, val); }
+static inline uint32_t rd_src_x_y(ati_device_t *dev) { return ati_reg_read(dev, SRC_X_Y); }
+static inline void wr_src_x_y(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SRC_X_Y, val); }
+static inline uint32_t rd_src_y_x(ati_device_t *dev) { return ati_reg_read(dev, SRC_Y_X); }
+static inline void wr_src_y_x(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, SRC_Y_X, val); }
+static inline uint32_t rd_host_data0(ati_device_t *dev) { return ati_reg_read(dev, HOST_DATA0); }
+static inline void wr_host_data0(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, HOST_DATA0, val); }
+static inline uint32_t rd_host_data1(ati_device_t *dev) { return ati_reg_read(dev, HOST_DATA1); }
+static inline void wr_host_data1(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, HOST_DATA1, val); }
+static inline uint32_t rd_host_data2(ati_device_t *dev) { return ati_reg_read(dev, HOST_DATA2); }
+static inline void wr_host_data2(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, HOST_DATA2, val); }
+static inline uint32_t rd_host_data3(ati_device_t *dev) { return ati_reg_read(dev, HOST_DATA3); }
+static inline void wr_host_data3(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, HOST_DATA3, val); }
+static inline uint32_t rd_host_data4(ati_device_t *dev) { return ati_reg_read(dev, HOST_DATA4); }
+static inline void wr_host_data4(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, HOST_DATA4, val); }
+static inline uint32_t rd_host_data5(ati_device_t *dev) { return ati_reg_read(dev, HOST_DATA5); }
+static inline void wr_host_data5(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, HOST_DATA5, val); }
+static inline uint32_t rd_host_data6(ati_device_t *dev) { return ati_reg_read(dev, HOST_DATA6); }
+static inline void wr_host_data6(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, HOST_DATA6, val); }
+static inline uint32_t rd_host_data7(ati_device_t *dev) { return ati_reg_read(dev, HOST_DATA7); }
+static inline void wr_host_data7(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, HOST_DATA7, val); }
+static inline uint32_t rd_host_data_last(ati_device_t *dev) { return ati_reg_read(dev, HOST_DATA_LAST); }
+static inline void wr_host_data_last(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, HOST_DATA_LAST, val); }
+static inline uint32_t rd_mm_index(ati_device_t *dev) { return ati_reg_read(dev, MM_INDEX); }
+static inline void wr_mm_index(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, MM_INDEX, val); }
+static inline uint32_t rd_mm_data(ati_device_t *dev) { return ati_reg_read(dev, MM_DATA); }
+static inline void wr_mm_data(ati_device_t *dev, uint32_t val) { ati_reg_write(dev, MM_DATA, val); }
+#endif // ATI_REG_ACCESSORS
+
+#endif // COMMON_REGS_GEN_H
\ No newline at end of file
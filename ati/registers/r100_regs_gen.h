@@ -0,0 +1,1285 @@
+// Auto-generated from registers/r100.yaml - DO NOT EDIT
+// Generated by: bin/generate_registers --chip r100 --prefix R100_
+//
+// ATI Radeon R100 (Mobility M6) specific register definitions.
+//
+// Field values are PRE-SHIFTED and can be ORed directly into register values.
+// Example: reg |= R100_GMC_BRUSH_DATATYPE_SOLIDCOLOR | R100_GMC_ROP3_SRCCOPY;
+
+#ifndef R100_REGS_GEN_H
+#define R100_REGS_GEN_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+// Note: field_value_t, field_entry_t, and flag enums are defined in common_regs_gen.h
+
+#include "common_regs_gen.h"
+
+
+// ============================================================================
+// Field Constants
+// ============================================================================
+
+// R100_BUS_CNTL fields
+enum {
+    R100_BUS_DBL_RESYNC = (1u << 0),
+    R100_BUS_MSTR_RESET = (1u << 1),
+    R100_BUS_FLUSH_BUF = (1u << 2),
+    R100_BUS_STOP_REQ_DIS = (1u << 3),
+    R100_BUS_READ_COMBINE_EN = (1u << 4),
+    R100_BUS_WRT_COMBINE_EN = (1u << 5),
+    R100_BUS_MASTER_DIS = (1u << 6),
+    R100_BIOS_ROM_WRT_EN = (1u << 7),
+    R100_BUS_PREFETCH_MODE_SHIFT = 8,
+    R100_BUS_PREFETCH_MODE_MASK = 0x300u,
+    R100_BUS_VGA_PREFETCH_EN = (1u << 10),
+    R100_BUS_SGL_READ_DISABLE = (1u << 11),
+    R100_BIOS_DIS_ROM = (1u << 12),
+    R100_BUS_PCI_READ_RETRY_EN = (1u << 13),
+    R100_BUS_AGP_AD_STEPPING_EN = (1u << 14),
+    R100_BUS_PCI_WRT_RETRY_EN = (1u << 15),
+    R100_BUS_RETRY_WS_SHIFT = 16,
+    R100_BUS_RETRY_WS_MASK = 0xf0000u,
+    R100_BUS_MSTR_RD_MULT = (1u << 20),
+    R100_BUS_MSTR_RD_LINE = (1u << 21),
+    R100_BUS_SUSPEND = (1u << 22),
+    R100_LAT_16X = (1u << 23),
+    R100_BUS_RD_DISCARD_EN = (1u << 24),
+    R100_ENFRCWRDY = (1u << 25),
+    R100_BUS_MSTR_WS = (1u << 26),
+    R100_BUS_PARKING_DIS = (1u << 27),
+    R100_BUS_MSTR_DISCONNECT_EN = (1u << 28),
+    R100_SERR_EN = (1u << 29),
+    R100_BUS_READ_BURST = (1u << 30),
+    R100_BUS_RDY_READ_DLY = (1u << 31),
+};
+
+// R100_GRPH_BUFFER_CNTL fields
+enum {
+    R100_GRPH_START_REQ_SHIFT = 0,
+    R100_GRPH_START_REQ_MASK = 0x7fu,
+    R100_GRPH_STOP_REQ_SHIFT = 8,
+    R100_GRPH_STOP_REQ_MASK = 0x7f00u,
+    R100_GRPH_CRITICAL_POINT_SHIFT = 16,
+    R100_GRPH_CRITICAL_POINT_MASK = 0x7f0000u,
+    R100_GRPH_CRITICAL_CNTL = (1u << 28),
+    R100_GRPH_BUFFER_SIZE = (1u << 29),
+    R100_GRPH_CRITICAL_AT_SOF = (1u << 30),
+    R100_GRPH_STOP_CNTL = (1u << 31),
+};
+
+// R100_SRC_PITCH_OFFSET fields
+enum {
+    R100_SRC_OFFSET_SHIFT = 0,
+    R100_SRC_OFFSET_MASK = 0x3fffffu,
+    R100_SRC_PITCH_SHIFT = 22,
+    R100_SRC_PITCH_MASK = 0x3fc00000u,
+    R100_SRC_TILE = (1u << 30),
+};
+
+// R100_DST_PITCH_OFFSET fields
+enum {
+    R100_DST_OFFSET_SHIFT = 0,
+    R100_DST_OFFSET_MASK = 0x3fffffu,
+    R100_DST_PITCH_SHIFT = 22,
+    R100_DST_PITCH_MASK = 0x3fc00000u,
+    R100_DST_TILE_SHIFT = 30,
+    R100_DST_TILE_MASK = 0xc0000000u,
+};
+
+// R100_DP_GUI_MASTER_CNTL fields
+enum {
+    R100_GMC_SRC_PITCH_OFFSET_CNTL = (1u << 0),
+    R100_GMC_DST_PITCH_OFFSET_CNTL = (1u << 1),
+    R100_GMC_SRC_CLIPPING = (1u << 2),
+    R100_GMC_DST_CLIPPING = (1u << 3),
+    R100_GMC_BRUSH_DATATYPE_SHIFT = 4,
+    R100_GMC_BRUSH_DATATYPE_MASK = 0xf0u,
+    R100_GMC_BRUSH_DATATYPE_8X8_MONO = 0u,
+    R100_GMC_BRUSH_DATATYPE_8X8_MONO_TRANS = 0x10u,
+    R100_GMC_BRUSH_DATATYPE_32X1_MONO = 0x60u,
+    R100_GMC_BRUSH_DATATYPE_32X1_MONO_TRANS = 0x70u,
+    R100_GMC_BRUSH_DATATYPE_8X8_COLOR = 0xa0u,
+    R100_GMC_BRUSH_DATATYPE_SOLIDCOLOR = 0xd0u,
+    R100_GMC_BRUSH_DATATYPE_SOLIDCOLOR_LINES = 0xe0u,
+    R100_GMC_BRUSH_DATATYPE_SOLIDCOLOR_ALT = 0xf0u,
+    R100_GMC_DST_DATATYPE_SHIFT = 8,
+    R100_GMC_DST_DATATYPE_MASK = 0xf00u,
+    R100_GMC_DST_DATATYPE_PSEUDO_COLOR_8 = 0x200u,
+    R100_GMC_DST_DATATYPE_ARGB_1555 = 0x300u,
+    R100_GMC_DST_DATATYPE_RGB_565 = 0x400u,
+    R100_GMC_DST_DATATYPE_ARGB_8888 = 0x600u,
+    R100_GMC_SRC_DATATYPE_SHIFT = 12,
+    R100_GMC_SRC_DATATYPE_MASK = 0x3000u,
+    R100_GMC_SRC_DATATYPE_MONO = 0u,
+    R100_GMC_SRC_DATATYPE_MONO_TRANS = 0x1000u,
+    R100_GMC_SRC_DATATYPE_DST_COLOR = 0x3000u,
+    R100_GMC_BYTE_PIX_ORDER = (1u << 14),
+    R100_GMC_DEFAULT_SEL = (1u << 15),
+    R100_GMC_ROP3_SHIFT = 16,
+    R100_GMC_ROP3_MASK = 0xff0000u,
+    R100_GMC_ROP3_SRCCOPY = 0xcc0000u,
+    R100_GMC_SRC_SOURCE_SHIFT = 24,
+    R100_GMC_SRC_SOURCE_MASK = 0x7000000u,
+    R100_GMC_SRC_SOURCE_MEMORY = 0x2000000u,
+    R100_GMC_SRC_SOURCE_HOST_DATA = 0x3000000u,
+    R100_GMC_SRC_SOURCE_HOST_DATA_ALIGNED = 0x4000000u,
+    R100_GMC_SRC_DATATYPE2 = (1u << 27),
+    R100_GMC_CLR_CMP_FCN_DIS = (1u << 28),
+    R100_GMC_WR_MSK_DIS = (1u << 30),
+};
+
+// R100_DP_DATATYPE fields
+enum {
+    R100_DP_DST_DATATYPE_SHIFT = 0,
+    R100_DP_DST_DATATYPE_MASK = 0xfu,
+    R100_DP_DST_DATATYPE_PSEUDO_COLOR_8 = 2u,
+    R100_DP_DST_DATATYPE_ARGB_1555 = 3u,
+    R100_DP_DST_DATATYPE_RGB_565 = 4u,
+    R100_DP_DST_DATATYPE_ARGB_8888 = 6u,
+    R100_DP_BRUSH_DATATYPE_SHIFT = 8,
+    R100_DP_BRUSH_DATATYPE_MASK = 0xf00u,
+    R100_DP_BRUSH_DATATYPE_8X8_MONO = 0u,
+    R100_DP_BRUSH_DATATYPE_8X8_MONO_TRANS = 0x100u,
+    R100_DP_BRUSH_DATATYPE_32X1_MONO = 0x600u,
+    R100_DP_BRUSH_DATATYPE_32X1_MONO_TRANS = 0x700u,
+    R100_DP_BRUSH_DATATYPE_8X8_COLOR = 0xa00u,
+    R100_DP_BRUSH_DATATYPE_SOLIDCOLOR = 0xd00u,
+    R100_DP_BRUSH_DATATYPE_SOLIDCOLOR_LINES = 0xe00u,
+    R100_DP_BRUSH_DATATYPE_SOLIDCOLOR_ALT = 0xf00u,
+    R100_DP_SRC_DATATYPE_SHIFT = 16,
+    R100_DP_SRC_DATATYPE_MASK = 0x70000u,
+    R100_DP_SRC_DATATYPE_MONO = 0u,
+    R100_DP_SRC_DATATYPE_MONO_TRANS = 0x10000u,
+    R100_DP_SRC_DATATYPE_DST_COLOR = 0x30000u,
+    R100_DP_SRC_DATATYPE_CLUT_8BPP = 0x50000u,
+    R100_DP_SRC_DATATYPE_CLUT_32BPP = 0x60000u,
+    R100_DP_SRC_DATATYPE_OBUFFER = 0x70000u,
+    R100_DP_BYTE_PIX_ORDER = (1u << 30),
+};
+
+// R100_DEFAULT_PITCH_OFFSET fields
+enum {
+    R100_DEFAULT_OFFSET_SHIFT = 0,
+    R100_DEFAULT_OFFSET_MASK = 0x3fffffu,
+    R100_DEFAULT_PITCH_SHIFT = 22,
+    R100_DEFAULT_PITCH_MASK = 0x3fc00000u,
+    R100_DEFAULT_TILE_SHIFT = 30,
+    R100_DEFAULT_TILE_MASK = 0xc0000000u,
+    R100_DEFAULT_TILE_LINEAR = 0u,
+    R100_DEFAULT_TILE_TILED = 0x40000000u,
+    R100_DEFAULT_TILE_MICROTILED = 0x80000000u,
+    R100_DEFAULT_TILE_TILED_MICROTILED = 0xc0000000u,
+};
+
+// R100_MC_FB_LOCATION fields
+enum {
+    R100_MC_FB_START_SHIFT = 0,
+    R100_MC_FB_START_MASK = 0xffffu,
+    R100_MC_FB_TOP_SHIFT = 16,
+    R100_MC_FB_TOP_MASK = 0xffff0000u,
+};
+
+// R100_MC_AGP_LOCATION fields
+enum {
+    R100_MC_AGP_START_SHIFT = 0,
+    R100_MC_AGP_START_MASK = 0xffffu,
+    R100_MC_AGP_TOP_SHIFT = 16,
+    R100_MC_AGP_TOP_MASK = 0xffff0000u,
+};
+
+// R100_AGP_COMMAND fields
+enum {
+    R100_DATA_RATE_SHIFT = 0,
+    R100_DATA_RATE_MASK = 0x7u,
+    R100_AGP_EN = (1u << 8),
+    R100_SBA_EN = (1u << 9),
+    R100_RQ_DEPTH_SHIFT = 24,
+    R100_RQ_DEPTH_MASK = 0xff000000u,
+};
+
+// R100_CONFIG_APER_SIZE fields
+enum {
+    R100_APER_SIZE_SHIFT = 24,
+    R100_APER_SIZE_MASK = 0xf000000u,
+};
+
+// R100_CRTC_GEN_CNTL fields
+enum {
+    R100_CRTC_DBL_SCAN_EN = (1u << 0),
+    R100_CRTC_INTERLACE_EN = (1u << 1),
+    R100_CRTC_C_SYNC_EN = (1u << 4),
+    R100_CRTC_PIX_WIDTH_SHIFT = 8,
+    R100_CRTC_PIX_WIDTH_MASK = 0xf00u,
+    R100_CRTC_PIX_WIDTH_DISABLED = 0u,
+    R100_CRTC_PIX_WIDTH_4BPP = 0x100u,
+    R100_CRTC_PIX_WIDTH_8BPP = 0x200u,
+    R100_CRTC_PIX_WIDTH_15BPP = 0x300u,
+    R100_CRTC_PIX_WIDTH_16BPP_RGB = 0x400u,
+    R100_CRTC_PIX_WIDTH_24BPP = 0x500u,
+    R100_CRTC_PIX_WIDTH_32BPP = 0x600u,
+    R100_CRTC_PIX_WIDTH_16BPP_ARGB = 0x700u,
+    R100_CRTC_PIX_WIDTH_16BPP_AIDX = 0x800u,
+    R100_CRTC_ICON_EN = (1u << 15),
+    R100_CRTC_CUR_EN = (1u << 16),
+    R100_CRTC_VSTAT_MODE_SHIFT = 17,
+    R100_CRTC_VSTAT_MODE_MASK = 0x60000u,
+    R100_CRTC_CUR_MODE_SHIFT = 20,
+    R100_CRTC_CUR_MODE_MASK = 0x700000u,
+    R100_CRTC_CUR_MODE_64X64_MONO = 0u,
+    R100_CRTC_EXT_DISP_EN = (1u << 24),
+    R100_CRTC_EN = (1u << 25),
+    R100_CRTC_DISP_REQ_EN_B = (1u << 26),
+};
+
+// R100_CRTC_PITCH fields
+enum {
+    R100_CRTC_PITCH_SHIFT = 0,
+    R100_CRTC_PITCH_MASK = 0x7ffu,
+    R100_CRTC_PITCH_RIGHT_SHIFT = 16,
+    R100_CRTC_PITCH_RIGHT_MASK = 0x7ff0000u,
+};
+
+// R100_CP_RB_CNTL fields
+enum {
+    R100_RB_BUFSZ_SHIFT = 0,
+    R100_RB_BUFSZ_MASK = 0x3fu,
+    R100_RB_BLKSZ_SHIFT = 8,
+    R100_RB_BLKSZ_MASK = 0x3f00u,
+    R100_BUF_SWAP_SHIFT = 16,
+    R100_BUF_SWAP_MASK = 0x30000u,
+    R100_MAX_FETCH_SHIFT = 18,
+    R100_MAX_FETCH_MASK = 0xc0000u,
+    R100_RB_NO_UPDATE = (1u << 27),
+    R100_RB_RPTR_WR_ENA = (1u << 31),
+};
+
+// R100_CP_RB_BASE fields
+enum {
+    R100_RB_BASE_SHIFT = 2,
+    R100_RB_BASE_MASK = 0xfffffffcu,
+};
+
+// R100_CP_RB_WPTR_DELAY fields
+enum {
+    R100_PRE_WRITE_TIMER_SHIFT = 0,
+    R100_PRE_WRITE_TIMER_MASK = 0xfffffffu,
+    R100_PRE_WRITE_LIMIT_SHIFT = 28,
+    R100_PRE_WRITE_LIMIT_MASK = 0xf0000000u,
+};
+
+// R100_CP_RB_RPTR_ADDR fields
+enum {
+    R100_RB_RPTR_SWAP_SHIFT = 0,
+    R100_RB_RPTR_SWAP_MASK = 0x3u,
+    R100_RB_RPTR_ADDR_SHIFT = 2,
+    R100_RB_RPTR_ADDR_MASK = 0xfffffffcu,
+};
+
+// R100_CP_RB_RPTR fields
+enum {
+    R100_RB_RPTR_SHIFT = 0,
+    R100_RB_RPTR_MASK = 0x7fffffu,
+};
+
+// R100_CP_RB_WPTR fields
+enum {
+    R100_RB_WPTR_SHIFT = 0,
+    R100_RB_WPTR_MASK = 0x7fffffu,
+};
+
+// R100_CP_RB_RPTR_WR fields
+enum {
+    R100_RB_RPTR_WR_SHIFT = 0,
+    R100_RB_RPTR_WR_MASK = 0x7fffffu,
+};
+
+// R100_CP_IB_BASE fields
+enum {
+    R100_IB_BASE_SHIFT = 2,
+    R100_IB_BASE_MASK = 0xfffffffcu,
+};
+
+// R100_CP_IB_BUFSZ fields
+enum {
+    R100_IB_BUFSZ_SHIFT = 0,
+    R100_IB_BUFSZ_MASK = 0x7fffffu,
+};
+
+// R100_CP_CSQ_CNTL fields
+enum {
+    R100_CSQ_CNT_PRIMARY_SHIFT = 0,
+    R100_CSQ_CNT_PRIMARY_MASK = 0xffu,
+    R100_CSQ_CNT_INDIRECT_SHIFT = 8,
+    R100_CSQ_CNT_INDIRECT_MASK = 0xff00u,
+    R100_CSQ_MODE_SHIFT = 28,
+    R100_CSQ_MODE_MASK = 0xf0000000u,
+    R100_CSQ_MODE_DISABLED = 0u,
+    R100_CSQ_MODE_PIO = 0x10000000u,
+    R100_CSQ_MODE_BM = 0x20000000u,
+    R100_CSQ_MODE_PIO_INDBM = 0x30000000u,
+    R100_CSQ_MODE_BM_INDBM = 0x40000000u,
+    R100_CSQ_MODE_PIO_INDBM_5 = 0x50000000u,
+    R100_CSQ_MODE_BM_INDBM_6 = 0x60000000u,
+    R100_CSQ_MODE_PIO_INDBM_7 = 0x70000000u,
+    R100_CSQ_MODE_BM_INDBM_8 = 0x80000000u,
+    R100_CSQ_MODE_PIO_INDPIO = 0xf0000000u,
+};
+
+// R100_CP_STAT fields
+enum {
+    R100_MRU_BUSY = (1u << 0),
+    R100_MWU_BUSY = (1u << 1),
+    R100_RSIU_BUSY = (1u << 2),
+    R100_RCIU_BUSY = (1u << 3),
+    R100_CSF_PRIMARY_BUSY = (1u << 9),
+    R100_CSF_INDIRECT_BUSY = (1u << 10),
+    R100_CSQ_PRIMARY_BUSY = (1u << 11),
+    R100_CSQ_INDIRECT_BUSY = (1u << 12),
+    R100_CSI_BUSY = (1u << 13),
+    R100_GUIDMA_BUSY = (1u << 28),
+    R100_CMDSTRM_BUSY = (1u << 30),
+    R100_CP_BUSY = (1u << 31),
+};
+
+// R100_CP_ME_CNTL fields
+enum {
+    R100_ME_STAT_SHIFT = 0,
+    R100_ME_STAT_MASK = 0xffffu,
+    R100_ME_STATMUX_SHIFT = 16,
+    R100_ME_STATMUX_MASK = 0x1f0000u,
+    R100_ME_MODE = (1u << 30),
+    R100_ME_STEP = (1u << 31),
+};
+
+// R100_CP_ME_RAM_ADDR fields
+enum {
+    R100_ME_RAM_ADDR_SHIFT = 0,
+    R100_ME_RAM_ADDR_MASK = 0xffu,
+};
+
+// R100_CP_ME_RAM_RADDR fields
+enum {
+    R100_ME_RAM_RADDR_SHIFT = 0,
+    R100_ME_RAM_RADDR_MASK = 0xffu,
+};
+
+// R100_CP_ME_RAM_DATAH fields
+enum {
+    R100_ME_RAM_DATAH_SHIFT = 0,
+    R100_ME_RAM_DATAH_MASK = 0x3fu,
+};
+
+// R100_CP_ME_RAM_DATAL fields
+enum {
+    R100_ME_RAM_DATAL_SHIFT = 0,
+    R100_ME_RAM_DATAL_MASK = 0xffffffffu,
+};
+
+// R100_CP_CSQ_ADDR fields
+enum {
+    R100_CSQ_ADDR_SHIFT = 2,
+    R100_CSQ_ADDR_MASK = 0x3fcu,
+};
+
+// R100_CP_CSQ_DATA fields
+enum {
+    R100_CSQ_DATA_SHIFT = 0,
+    R100_CSQ_DATA_MASK = 0xffffffffu,
+};
+
+// R100_CP_CSQ_STAT fields
+enum {
+    R100_CSQ_RPTR_PRIMARY_SHIFT = 0,
+    R100_CSQ_RPTR_PRIMARY_MASK = 0xffu,
+    R100_CSQ_WPTR_PRIMARY_SHIFT = 8,
+    R100_CSQ_WPTR_PRIMARY_MASK = 0xff00u,
+    R100_CSQ_RPTR_INDIRECT_SHIFT = 16,
+    R100_CSQ_RPTR_INDIRECT_MASK = 0xff0000u,
+    R100_CSQ_WPTR_INDIRECT_SHIFT = 24,
+    R100_CSQ_WPTR_INDIRECT_MASK = 0xff000000u,
+};
+
+// R100_CP_DEBUG fields
+enum {
+    R100_CP_DEBUG_SHIFT = 0,
+    R100_CP_DEBUG_MASK = 0xffffffffu,
+};
+
+// R100_RBBM_STATUS fields
+enum {
+    R100_CMDFIFO_AVAIL_SHIFT = 0,
+    R100_CMDFIFO_AVAIL_MASK = 0x7fu,
+    R100_HIRQ_ON_RBB = (1u << 8),
+    R100_CPRQ_ON_RBB = (1u << 9),
+    R100_CFRQ_ON_RBB = (1u << 10),
+    R100_HIRQ_IN_RTBUF = (1u << 11),
+    R100_CPRQ_IN_RTBUF = (1u << 12),
+    R100_CFRQ_IN_RTBUF = (1u << 13),
+    R100_CF_PIPE_BUSY = (1u << 14),
+    R100_ENG_EV_BUSY = (1u << 15),
+    R100_CP_CMDSTRM_BUSY = (1u << 16),
+    R100_E2_BUSY = (1u << 17),
+    R100_RB2D_BUSY = (1u << 18),
+    R100_RB3D_BUSY = (1u << 19),
+    R100_SE_BUSY = (1u << 20),
+    R100_RE_BUSY = (1u << 21),
+    R100_TAM_BUSY = (1u << 22),
+    R100_TDM_BUSY = (1u << 23),
+    R100_PB_BUSY = (1u << 24),
+    R100_GUI_ACTIVE = (1u << 31),
+};
+
+// R100_CP_CSQ_APER_PRIMARY fields
+enum {
+    R100_CP_CSQ_APER_PRIMARY_SHIFT = 0,
+    R100_CP_CSQ_APER_PRIMARY_MASK = 0xffffffffu,
+};
+
+// R100_ISYNC_CNTL fields
+enum {
+    R100_ISYNC_ANY2D_IDLE3D = (1u << 0),
+    R100_ISYNC_ANY3D_IDLE2D = (1u << 1),
+    R100_ISYNC_TRIG2D_IDLE3D = (1u << 2),
+    R100_ISYNC_TRIG3D_IDLE2D = (1u << 3),
+    R100_ISYNC_WAIT_IDLEGUI = (1u << 4),
+    R100_ISYNC_CPSCRATCH_IDLEGUI = (1u << 5),
+};
+
+// R100_RB2D_DSTCACHE_CTLSTAT fields
+enum {
+    R100_RB2D_DC_FLUSH_SHIFT = 0,
+    R100_RB2D_DC_FLUSH_MASK = 0x3u,
+    R100_RB2D_DC_FREE_SHIFT = 2,
+    R100_RB2D_DC_FREE_MASK = 0xcu,
+    R100_RB2D_DC_BUSY = (1u << 31),
+    // Aliases
+    R100_RB2D_DC_FLUSH_ALL_SHIFT = 0,
+    R100_RB2D_DC_FLUSH_ALL_MASK = 0xffu,
+};
+
+// R100_SCRATCH_ADDR fields
+enum {
+    R100_SCRATCH_ADDR_SHIFT = 5,
+    R100_SCRATCH_ADDR_MASK = 0xffffffe0u,
+};
+
+// R100_SCRATCH_UMSK fields
+enum {
+    R100_SCRATCH0_EN = (1u << 0),
+    R100_SCRATCH1_EN = (1u << 1),
+    R100_SCRATCH2_EN = (1u << 2),
+    R100_SCRATCH3_EN = (1u << 3),
+    R100_SCRATCH4_EN = (1u << 4),
+    R100_SCRATCH5_EN = (1u << 5),
+    R100_SCRATCH_SWAP_SHIFT = 16,
+    R100_SCRATCH_SWAP_MASK = 0x30000u,
+};
+
+// R100_AIC_CTRL fields
+enum {
+    R100_TRANSLATE_EN = (1u << 0),
+    R100_HW_0_DEBUG = (1u << 1),
+    R100_HW_1_DEBUG = (1u << 2),
+    R100_HW_2_DEBUG = (1u << 3),
+    R100_HW_3_DEBUG = (1u << 4),
+    R100_HW_4_DEBUG = (1u << 5),
+    R100_HW_5_DEBUG = (1u << 6),
+    R100_HW_6_DEBUG = (1u << 7),
+    R100_HW_7_DEBUG = (1u << 8),
+    R100_HW_8_DEBUG = (1u << 9),
+    R100_HW_9_DEBUG = (1u << 10),
+    R100_HW_A_DEBUG = (1u << 11),
+    R100_HW_B_DEBUG = (1u << 12),
+    R100_HW_C_DEBUG = (1u << 13),
+    R100_HW_D_DEBUG = (1u << 14),
+    R100_HW_E_DEBUG = (1u << 15),
+    R100_HW_F_DEBUG = (1u << 16),
+    R100_HW_10_DEBUG = (1u << 17),
+    R100_HW_11_DEBUG = (1u << 18),
+    R100_HW_12_DEBUG = (1u << 19),
+    R100_HW_13_DEBUG = (1u << 20),
+    R100_HW_14_DEBUG = (1u << 21),
+    R100_HW_15_DEBUG = (1u << 22),
+    R100_HW_16_DEBUG = (1u << 23),
+    R100_HW_17_DEBUG = (1u << 24),
+    R100_HW_18_DEBUG = (1u << 25),
+    R100_HW_19_DEBUG = (1u << 26),
+    R100_HW_1A_DEBUG = (1u << 27),
+    R100_HW_1B_DEBUG = (1u << 28),
+    R100_HW_1C_DEBUG = (1u << 29),
+    R100_HW_1D_DEBUG = (1u << 30),
+    R100_HW_1E_DEBUG = (1u << 31),
+};
+
+// R100_AIC_PT_BASE fields
+enum {
+    R100_AIC_PT_BASE_SHIFT = 12,
+    R100_AIC_PT_BASE_MASK = 0xfffff000u,
+};
+
+// R100_AIC_LO_ADDR fields
+enum {
+    R100_AIC_LO_ADDR_SHIFT = 12,
+    R100_AIC_LO_ADDR_MASK = 0xfffff000u,
+};
+
+// R100_AIC_HI_ADDR fields
+enum {
+    R100_AIC_HI_ADDR_SHIFT = 12,
+    R100_AIC_HI_ADDR_MASK = 0xfffff000u,
+};
+
+// ============================================================================
+// Field Value Tables (for REPL display of named values)
+// ============================================================================
+
+static const field_value_t r100_gmc_brush_datatype_values[] = {
+    {"8X8_MONO", 0},
+    {"8X8_MONO_TRANS", 1},
+    {"32X1_MONO", 6},
+    {"32X1_MONO_TRANS", 7},
+    {"8X8_COLOR", 10},
+    {"SOLIDCOLOR", 13},
+    {"SOLIDCOLOR_LINES", 14},
+    {"SOLIDCOLOR_ALT", 15},
+    {NULL, 0}
+};
+
+static const field_value_t r100_gmc_dst_datatype_values[] = {
+    {"PSEUDO_COLOR_8", 2},
+    {"ARGB_1555", 3},
+    {"RGB_565", 4},
+    {"ARGB_8888", 6},
+    {NULL, 0}
+};
+
+static const field_value_t r100_gmc_src_datatype_values[] = {
+    {"MONO", 0},
+    {"MONO_TRANS", 1},
+    {"DST_COLOR", 3},
+    {NULL, 0}
+};
+
+static const field_value_t r100_gmc_rop3_values[] = {
+    {"SRCCOPY", 204},
+    {NULL, 0}
+};
+
+static const field_value_t r100_gmc_src_source_values[] = {
+    {"MEMORY", 2},
+    {"HOST_DATA", 3},
+    {"HOST_DATA_ALIGNED", 4},
+    {NULL, 0}
+};
+
+static const field_value_t r100_dp_dst_datatype_values[] = {
+    {"PSEUDO_COLOR_8", 2},
+    {"ARGB_1555", 3},
+    {"RGB_565", 4},
+    {"ARGB_8888", 6},
+    {NULL, 0}
+};
+
+static const field_value_t r100_dp_brush_datatype_values[] = {
+    {"8X8_MONO", 0},
+    {"8X8_MONO_TRANS", 1},
+    {"32X1_MONO", 6},
+    {"32X1_MONO_TRANS", 7},
+    {"8X8_COLOR", 10},
+    {"SOLIDCOLOR", 13},
+    {"SOLIDCOLOR_LINES", 14},
+    {"SOLIDCOLOR_ALT", 15},
+    {NULL, 0}
+};
+
+static const field_value_t r100_dp_src_datatype_values[] = {
+    {"MONO", 0},
+    {"MONO_TRANS", 1},
+    {"DST_COLOR", 3},
+    {"CLUT_8BPP", 5},
+    {"CLUT_32BPP", 6},
+    {"OBUFFER", 7},
+    {NULL, 0}
+};
+
+static const field_value_t r100_default_tile_values[] = {
+    {"LINEAR", 0},
+    {"TILED", 1},
+    {"MICROTILED", 2},
+    {"TILED_MICROTILED", 3},
+    {NULL, 0}
+};
+
+static const field_value_t r100_crtc_pix_width_values[] = {
+    {"DISABLED", 0},
+    {"4BPP", 1},
+    {"8BPP", 2},
+    {"15BPP", 3},
+    {"16BPP_RGB", 4},
+    {"24BPP", 5},
+    {"32BPP", 6},
+    {"16BPP_ARGB", 7},
+    {"16BPP_AIDX", 8},
+    {NULL, 0}
+};
+
+static const field_value_t r100_crtc_cur_mode_values[] = {
+    {"64X64_MONO", 0},
+    {NULL, 0}
+};
+
+static const field_value_t r100_csq_mode_values[] = {
+    {"DISABLED", 0},
+    {"PIO", 1},
+    {"BM", 2},
+    {"PIO_INDBM", 3},
+    {"BM_INDBM", 4},
+    {"PIO_INDBM_5", 5},
+    {"BM_INDBM_6", 6},
+    {"PIO_INDBM_7", 7},
+    {"BM_INDBM_8", 8},
+    {"PIO_INDPIO", 15},
+    {NULL, 0}
+};
+
+// ============================================================================
+// Field Tables (for REPL display)
+// ============================================================================
+
+static const field_entry_t r100_bus_cntl_fields[] = {
+    {"BUS_DBL_RESYNC", 0, 1, 0, NULL},
+    {"BUS_MSTR_RESET", 1, 1, 0, NULL},
+    {"BUS_FLUSH_BUF", 2, 1, 0, NULL},
+    {"BUS_STOP_REQ_DIS", 3, 1, 0, NULL},
+    {"BUS_READ_COMBINE_EN", 4, 1, 0, NULL},
+    {"BUS_WRT_COMBINE_EN", 5, 1, 0, NULL},
+    {"BUS_MASTER_DIS", 6, 1, 0, NULL},
+    {"BIOS_ROM_WRT_EN", 7, 1, 0, NULL},
+    {"BUS_PREFETCH_MODE", 8, 2, 0, NULL},
+    {"BUS_VGA_PREFETCH_EN", 10, 1, 0, NULL},
+    {"BUS_SGL_READ_DISABLE", 11, 1, 0, NULL},
+    {"BIOS_DIS_ROM", 12, 1, 0, NULL},
+    {"BUS_PCI_READ_RETRY_EN", 13, 1, 0, NULL},
+    {"BUS_AGP_AD_STEPPING_EN", 14, 1, 0, NULL},
+    {"BUS_PCI_WRT_RETRY_EN", 15, 1, 0, NULL},
+    {"BUS_RETRY_WS", 16, 4, 0, NULL},
+    {"BUS_MSTR_RD_MULT", 20, 1, 0, NULL},
+    {"BUS_MSTR_RD_LINE", 21, 1, 0, NULL},
+    {"BUS_SUSPEND", 22, 1, 0, NULL},
+    {"LAT_16X", 23, 1, 0, NULL},
+    {"BUS_RD_DISCARD_EN", 24, 1, 0, NULL},
+    {"ENFRCWRDY", 25, 1, 0, NULL},
+    {"BUS_MSTR_WS", 26, 1, 0, NULL},
+    {"BUS_PARKING_DIS", 27, 1, 0, NULL},
+    {"BUS_MSTR_DISCONNECT_EN", 28, 1, 0, NULL},
+    {"SERR_EN", 29, 1, 0, NULL},
+    {"BUS_READ_BURST", 30, 1, 0, NULL},
+    {"BUS_RDY_READ_DLY", 31, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_grph_buffer_cntl_fields[] = {
+    {"GRPH_START_REQ", 0, 7, 0, NULL},
+    {"GRPH_STOP_REQ", 8, 7, 0, NULL},
+    {"GRPH_CRITICAL_POINT", 16, 7, 0, NULL},
+    {"GRPH_CRITICAL_CNTL", 28, 1, 0, NULL},
+    {"GRPH_BUFFER_SIZE", 29, 1, 0, NULL},
+    {"GRPH_CRITICAL_AT_SOF", 30, 1, 0, NULL},
+    {"GRPH_STOP_CNTL", 31, 1, 0, NULL},
+    {"(reserved)", 7, 1, 0, NULL},
+    {"(reserved)", 15, 1, 0, NULL},
+    {"(reserved)", 23, 5, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_src_pitch_offset_fields[] = {
+    {"SRC_OFFSET", 0, 22, 0, NULL},
+    {"SRC_PITCH", 22, 8, 0, NULL},
+    {"SRC_TILE", 30, 1, 0, NULL},
+    {"(reserved)", 31, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_dst_pitch_offset_fields[] = {
+    {"DST_OFFSET", 0, 22, 0, NULL},
+    {"DST_PITCH", 22, 8, 0, NULL},
+    {"DST_TILE", 30, 2, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_dp_gui_master_cntl_fields[] = {
+    {"GMC_SRC_PITCH_OFFSET_CNTL", 0, 1, 0, NULL},
+    {"GMC_DST_PITCH_OFFSET_CNTL", 1, 1, 0, NULL},
+    {"GMC_SRC_CLIPPING", 2, 1, 0, NULL},
+    {"GMC_DST_CLIPPING", 3, 1, 0, NULL},
+    {"GMC_BRUSH_DATATYPE", 4, 4, 0, r100_gmc_brush_datatype_values},
+    {"GMC_DST_DATATYPE", 8, 4, 0, r100_gmc_dst_datatype_values},
+    {"GMC_SRC_DATATYPE", 12, 2, 0, r100_gmc_src_datatype_values},
+    {"GMC_BYTE_PIX_ORDER", 14, 1, 0, NULL},
+    {"GMC_DEFAULT_SEL", 15, 1, 0, NULL},
+    {"GMC_ROP3", 16, 8, 0, r100_gmc_rop3_values},
+    {"GMC_SRC_SOURCE", 24, 3, 0, r100_gmc_src_source_values},
+    {"GMC_SRC_DATATYPE2", 27, 1, 0, NULL},
+    {"GMC_CLR_CMP_FCN_DIS", 28, 1, 0, NULL},
+    {"GMC_WR_MSK_DIS", 30, 1, 0, NULL},
+    {"(reserved)", 29, 1, 0, NULL},
+    {"(reserved)", 31, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_dp_datatype_fields[] = {
+    {"DP_DST_DATATYPE", 0, 4, 0, r100_dp_dst_datatype_values},
+    {"DP_BRUSH_DATATYPE", 8, 4, 0, r100_dp_brush_datatype_values},
+    {"DP_SRC_DATATYPE", 16, 3, 0, r100_dp_src_datatype_values},
+    {"DP_BYTE_PIX_ORDER", 30, 1, 0, NULL},
+    {"(reserved)", 4, 4, 0, NULL},
+    {"(reserved)", 12, 4, 0, NULL},
+    {"(reserved)", 19, 11, 0, NULL},
+    {"(reserved)", 31, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_default_pitch_offset_fields[] = {
+    {"DEFAULT_OFFSET", 0, 22, 0, NULL},
+    {"DEFAULT_PITCH", 22, 8, 0, NULL},
+    {"DEFAULT_TILE", 30, 2, 0, r100_default_tile_values},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_mc_fb_location_fields[] = {
+    {"MC_FB_START", 0, 16, 0, NULL},
+    {"MC_FB_TOP", 16, 16, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_mc_agp_location_fields[] = {
+    {"MC_AGP_START", 0, 16, 0, NULL},
+    {"MC_AGP_TOP", 16, 16, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_agp_command_fields[] = {
+    {"DATA_RATE", 0, 3, 0, NULL},
+    {"AGP_EN", 8, 1, 0, NULL},
+    {"SBA_EN", 9, 1, 0, NULL},
+    {"RQ_DEPTH", 24, 8, 0, NULL},
+    {"(reserved)", 3, 5, 0, NULL},
+    {"(reserved)", 10, 14, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_config_aper_size_fields[] = {
+    {"APER_SIZE", 24, 4, 0, NULL},
+    {"(reserved)", 0, 24, 0, NULL},
+    {"(reserved)", 28, 4, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_crtc_gen_cntl_fields[] = {
+    {"CRTC_DBL_SCAN_EN", 0, 1, 0, NULL},
+    {"CRTC_INTERLACE_EN", 1, 1, 0, NULL},
+    {"CRTC_C_SYNC_EN", 4, 1, 0, NULL},
+    {"CRTC_PIX_WIDTH", 8, 4, 0, r100_crtc_pix_width_values},
+    {"CRTC_ICON_EN", 15, 1, 0, NULL},
+    {"CRTC_CUR_EN", 16, 1, 0, NULL},
+    {"CRTC_VSTAT_MODE", 17, 2, 0, NULL},
+    {"CRTC_CUR_MODE", 20, 3, 0, r100_crtc_cur_mode_values},
+    {"CRTC_EXT_DISP_EN", 24, 1, 0, NULL},
+    {"CRTC_EN", 25, 1, 0, NULL},
+    {"CRTC_DISP_REQ_EN_B", 26, 1, 0, NULL},
+    {"(reserved)", 2, 2, 0, NULL},
+    {"(reserved)", 5, 3, 0, NULL},
+    {"(reserved)", 12, 3, 0, NULL},
+    {"(reserved)", 19, 1, 0, NULL},
+    {"(reserved)", 23, 1, 0, NULL},
+    {"(reserved)", 27, 5, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_crtc_pitch_fields[] = {
+    {"CRTC_PITCH", 0, 11, 0, NULL},
+    {"CRTC_PITCH_RIGHT", 16, 11, 0, NULL},
+    {"(reserved)", 11, 5, 0, NULL},
+    {"(reserved)", 27, 5, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_rb_cntl_fields[] = {
+    {"RB_BUFSZ", 0, 6, 0, NULL},
+    {"RB_BLKSZ", 8, 6, 0, NULL},
+    {"BUF_SWAP", 16, 2, 0, NULL},
+    {"MAX_FETCH", 18, 2, 0, NULL},
+    {"RB_NO_UPDATE", 27, 1, 0, NULL},
+    {"RB_RPTR_WR_ENA", 31, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_rb_base_fields[] = {
+    {"RB_BASE", 2, 30, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_rb_wptr_delay_fields[] = {
+    {"PRE_WRITE_TIMER", 0, 28, 0, NULL},
+    {"PRE_WRITE_LIMIT", 28, 4, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_rb_rptr_addr_fields[] = {
+    {"RB_RPTR_SWAP", 0, 2, 0, NULL},
+    {"RB_RPTR_ADDR", 2, 30, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_rb_rptr_fields[] = {
+    {"RB_RPTR", 0, 23, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_rb_wptr_fields[] = {
+    {"RB_WPTR", 0, 23, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_rb_rptr_wr_fields[] = {
+    {"RB_RPTR_WR", 0, 23, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_ib_base_fields[] = {
+    {"IB_BASE", 2, 30, 0, NULL},
+    {"(reserved)", 0, 2, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_ib_bufsz_fields[] = {
+    {"IB_BUFSZ", 0, 23, 0, NULL},
+    {"(reserved)", 22, 10, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_csq_cntl_fields[] = {
+    {"CSQ_CNT_PRIMARY", 0, 8, 0, NULL},
+    {"CSQ_CNT_INDIRECT", 8, 8, 0, NULL},
+    {"CSQ_MODE", 28, 4, 0, r100_csq_mode_values},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_stat_fields[] = {
+    {"MRU_BUSY", 0, 1, 0, NULL},
+    {"MWU_BUSY", 1, 1, 0, NULL},
+    {"RSIU_BUSY", 2, 1, 0, NULL},
+    {"RCIU_BUSY", 3, 1, 0, NULL},
+    {"CSF_PRIMARY_BUSY", 9, 1, 0, NULL},
+    {"CSF_INDIRECT_BUSY", 10, 1, 0, NULL},
+    {"CSQ_PRIMARY_BUSY", 11, 1, 0, NULL},
+    {"CSQ_INDIRECT_BUSY", 12, 1, 0, NULL},
+    {"CSI_BUSY", 13, 1, 0, NULL},
+    {"GUIDMA_BUSY", 28, 1, 0, NULL},
+    {"CMDSTRM_BUSY", 30, 1, 0, NULL},
+    {"CP_BUSY", 31, 1, 0, NULL},
+    {"(reserved)", 4, 5, 0, NULL},
+    {"(reserved)", 14, 14, 0, NULL},
+    {"(reserved)", 29, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_me_cntl_fields[] = {
+    {"ME_STAT", 0, 16, 0, NULL},
+    {"ME_STATMUX", 16, 5, 0, NULL},
+    {"ME_MODE", 30, 1, 0, NULL},
+    {"ME_STEP", 31, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_me_ram_addr_fields[] = {
+    {"ME_RAM_ADDR", 0, 8, 0, NULL},
+    {"(reserved)", 8, 24, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_me_ram_raddr_fields[] = {
+    {"ME_RAM_RADDR", 0, 8, 0, NULL},
+    {"(reserved)", 8, 24, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_me_ram_datah_fields[] = {
+    {"ME_RAM_DATAH", 0, 6, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_me_ram_datal_fields[] = {
+    {"ME_RAM_DATAL", 0, 32, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_csq_addr_fields[] = {
+    {"CSQ_ADDR", 2, 8, 0, NULL},
+    {"(reserved)", 0, 2, 0, NULL},
+    {"(reserved)", 10, 22, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_csq_data_fields[] = {
+    {"CSQ_DATA", 0, 32, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_csq_stat_fields[] = {
+    {"CSQ_RPTR_PRIMARY", 0, 8, 0, NULL},
+    {"CSQ_WPTR_PRIMARY", 8, 8, 0, NULL},
+    {"CSQ_RPTR_INDIRECT", 16, 8, 0, NULL},
+    {"CSQ_WPTR_INDIRECT", 24, 8, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_debug_fields[] = {
+    {"CP_DEBUG", 0, 32, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_rbbm_status_fields[] = {
+    {"CMDFIFO_AVAIL", 0, 7, 0, NULL},
+    {"HIRQ_ON_RBB", 8, 1, 0, NULL},
+    {"CPRQ_ON_RBB", 9, 1, 0, NULL},
+    {"CFRQ_ON_RBB", 10, 1, 0, NULL},
+    {"HIRQ_IN_RTBUF", 11, 1, 0, NULL},
+    {"CPRQ_IN_RTBUF", 12, 1, 0, NULL},
+    {"CFRQ_IN_RTBUF", 13, 1, 0, NULL},
+    {"CF_PIPE_BUSY", 14, 1, 0, NULL},
+    {"ENG_EV_BUSY", 15, 1, 0, NULL},
+    {"CP_CMDSTRM_BUSY", 16, 1, 0, NULL},
+    {"E2_BUSY", 17, 1, 0, NULL},
+    {"RB2D_BUSY", 18, 1, 0, NULL},
+    {"RB3D_BUSY", 19, 1, 0, NULL},
+    {"SE_BUSY", 20, 1, 0, NULL},
+    {"RE_BUSY", 21, 1, 0, NULL},
+    {"TAM_BUSY", 22, 1, 0, NULL},
+    {"TDM_BUSY", 23, 1, 0, NULL},
+    {"PB_BUSY", 24, 1, 0, NULL},
+    {"GUI_ACTIVE", 31, 1, 0, NULL},
+    {"(reserved)", 7, 1, 0, NULL},
+    {"(reserved)", 25, 6, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_cp_csq_aper_primary_fields[] = {
+    {"CP_CSQ_APER_PRIMARY", 0, 32, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_isync_cntl_fields[] = {
+    {"ISYNC_ANY2D_IDLE3D", 0, 1, 0, NULL},
+    {"ISYNC_ANY3D_IDLE2D", 1, 1, 0, NULL},
+    {"ISYNC_TRIG2D_IDLE3D", 2, 1, 0, NULL},
+    {"ISYNC_TRIG3D_IDLE2D", 3, 1, 0, NULL},
+    {"ISYNC_WAIT_IDLEGUI", 4, 1, 0, NULL},
+    {"ISYNC_CPSCRATCH_IDLEGUI", 5, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_rb2d_dstcache_ctlstat_fields[] = {
+    {"RB2D_DC_FLUSH", 0, 2, 0, NULL},
+    {"RB2D_DC_FREE", 2, 2, 0, NULL},
+    {"RB2D_DC_BUSY", 31, 1, 0, NULL},
+    {"(reserved)", 3, 28, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_scratch_addr_fields[] = {
+    {"SCRATCH_ADDR", 5, 27, 0, NULL},
+    {"(reserved)", 0, 5, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_scratch_umsk_fields[] = {
+    {"SCRATCH0_EN", 0, 1, 0, NULL},
+    {"SCRATCH1_EN", 1, 1, 0, NULL},
+    {"SCRATCH2_EN", 2, 1, 0, NULL},
+    {"SCRATCH3_EN", 3, 1, 0, NULL},
+    {"SCRATCH4_EN", 4, 1, 0, NULL},
+    {"SCRATCH5_EN", 5, 1, 0, NULL},
+    {"SCRATCH_SWAP", 16, 2, 0, NULL},
+    {"(reserved)", 5, 11, 0, NULL},
+    {"(reserved)", 18, 14, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_aic_ctrl_fields[] = {
+    {"TRANSLATE_EN", 0, 1, 0, NULL},
+    {"HW_0_DEBUG", 1, 1, 0, NULL},
+    {"HW_1_DEBUG", 2, 1, 0, NULL},
+    {"HW_2_DEBUG", 3, 1, 0, NULL},
+    {"HW_3_DEBUG", 4, 1, 0, NULL},
+    {"HW_4_DEBUG", 5, 1, 0, NULL},
+    {"HW_5_DEBUG", 6, 1, 0, NULL},
+    {"HW_6_DEBUG", 7, 1, 0, NULL},
+    {"HW_7_DEBUG", 8, 1, 0, NULL},
+    {"HW_8_DEBUG", 9, 1, 0, NULL},
+    {"HW_9_DEBUG", 10, 1, 0, NULL},
+    {"HW_A_DEBUG", 11, 1, 0, NULL},
+    {"HW_B_DEBUG", 12, 1, 0, NULL},
+    {"HW_C_DEBUG", 13, 1, 0, NULL},
+    {"HW_D_DEBUG", 14, 1, 0, NULL},
+    {"HW_E_DEBUG", 15, 1, 0, NULL},
+    {"HW_F_DEBUG", 16, 1, 0, NULL},
+    {"HW_10_DEBUG", 17, 1, 0, NULL},
+    {"HW_11_DEBUG", 18, 1, 0, NULL},
+    {"HW_12_DEBUG", 19, 1, 0, NULL},
+    {"HW_13_DEBUG", 20, 1, 0, NULL},
+    {"HW_14_DEBUG", 21, 1, 0, NULL},
+    {"HW_15_DEBUG", 22, 1, 0, NULL},
+    {"HW_16_DEBUG", 23, 1, 0, NULL},
+    {"HW_17_DEBUG", 24, 1, 0, NULL},
+    {"HW_18_DEBUG", 25, 1, 0, NULL},
+    {"HW_19_DEBUG", 26, 1, 0, NULL},
+    {"HW_1A_DEBUG", 27, 1, 0, NULL},
+    {"HW_1B_DEBUG", 28, 1, 0, NULL},
+    {"HW_1C_DEBUG", 29, 1, 0, NULL},
+    {"HW_1D_DEBUG", 30, 1, 0, NULL},
+    {"HW_1E_DEBUG", 31, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_aic_pt_base_fields[] = {
+    {"AIC_PT_BASE", 12, 20, 0, NULL},
+    {"(reserved)", 0, 12, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_aic_lo_addr_fields[] = {
+    {"AIC_LO_ADDR", 12, 20, 0, NULL},
+    {"(reserved)", 0, 12, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r100_aic_hi_addr_fields[] = {
+    {"AIC_HI_ADDR", 12, 20, 0, NULL},
+    {"(reserved)", 0, 12, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+// ============================================================================
+// Alias Tables (for REPL display)
+// ============================================================================
+
+static const field_entry_t r100_rb2d_dstcache_ctlstat_aliases[] = {
+    {"RB2D_DC_FLUSH_ALL", 0, 8, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+// ============================================================================
+// Register Offsets
+// ============================================================================
+
+enum {
+    R100_BUS_CNTL = 0x30,
+    R100_GRPH_BUFFER_CNTL = 0x2f0,
+    R100_SRC_PITCH_OFFSET = 0x1428,
+    R100_DST_PITCH_OFFSET = 0x142c,
+    R100_DP_GUI_MASTER_CNTL = 0x146c,
+    R100_DP_DATATYPE = 0x16c4,
+    R100_DEFAULT_PITCH_OFFSET = 0x16e0,
+    R100_DISPLAY_BASE_ADDR = 0x23c,
+    R100_MC_FB_LOCATION = 0x148,
+    R100_MC_AGP_LOCATION = 0x14c,
+    R100_AGP_COMMAND = 0xf60,
+    R100_CONFIG_APER_SIZE = 0x108,
+    R100_CRTC_GEN_CNTL = 0x50,
+    R100_CRTC_PITCH = 0x22c,
+    R100_CP_RB_CNTL = 0x704,
+    R100_CP_RB_BASE = 0x700,
+    R100_CP_RB_WPTR_DELAY = 0x718,
+    R100_CP_RB_RPTR_ADDR = 0x70c,
+    R100_CP_RB_RPTR = 0x710,
+    R100_CP_RB_WPTR = 0x714,
+    R100_CP_RB_RPTR_WR = 0x71c,
+    R100_CP_IB_BASE = 0x738,
+    R100_CP_IB_BUFSZ = 0x73c,
+    R100_CP_CSQ_CNTL = 0x740,
+    R100_CP_STAT = 0x7c0,
+    R100_CP_ME_CNTL = 0x7d0,
+    R100_CP_ME_RAM_ADDR = 0x7d4,
+    R100_CP_ME_RAM_RADDR = 0x7d8,
+    R100_CP_ME_RAM_DATAH = 0x7dc,
+    R100_CP_ME_RAM_DATAL = 0x7e0,
+    R100_CP_CSQ_ADDR = 0x7f0,
+    R100_CP_CSQ_DATA = 0x7f4,
+    R100_CP_CSQ_STAT = 0x7f8,
+    R100_CP_DEBUG = 0x7ec,
+    R100_RBBM_STATUS = 0x1740,
+    R100_CP_CSQ_APER_PRIMARY = 0x1000,
+    R100_ISYNC_CNTL = 0x1724,
+    R100_RB2D_DSTCACHE_CTLSTAT = 0x342c,
+    R100_SCRATCH_ADDR = 0x774,
+    R100_SCRATCH_UMSK = 0x770,
+    R100_AIC_CTRL = 0x1d0,
+    R100_AIC_PT_BASE = 0x1d8,
+    R100_AIC_LO_ADDR = 0x1dc,
+    R100_AIC_HI_ADDR = 0x1e0,
+    R100_VIPH_CONTROL = 0xc40,
+    R100_RE_STIPPLE_ADDR = 0x1cc8,
+    R100_RE_STIPPLE_DATA = 0x1ccc,
+};
+
+// ============================================================================
+// R100_REGISTERS X-macro
+// Used to generate read/write functions, register tables, etc.
+// X(func_name, const_name, offset, flags, fields, aliases)
+// ============================================================================
+
+#define R100_REGISTERS \
+  X(r100_bus_cntl, R100_BUS_CNTL, 0x30, 0, r100_bus_cntl_fields, NULL) \
+  X(r100_grph_buffer_cntl, R100_GRPH_BUFFER_CNTL, 0x2f0, 0, r100_grph_buffer_cntl_fields, NULL) \
+  X(r100_src_pitch_offset, R100_SRC_PITCH_OFFSET, 0x1428, FLAG_NO_READ, r100_src_pitch_offset_fields, NULL) \
+  X(r100_dst_pitch_offset, R100_DST_PITCH_OFFSET, 0x142c, FLAG_NO_READ, r100_dst_pitch_offset_fields, NULL) \
+  X(r100_dp_gui_master_cntl, R100_DP_GUI_MASTER_CNTL, 0x146c, FLAG_NO_READ, r100_dp_gui_master_cntl_fields, NULL) \
+  X(r100_dp_datatype, R100_DP_DATATYPE, 0x16c4, 0, r100_dp_datatype_fields, NULL) \
+  X(r100_default_pitch_offset, R100_DEFAULT_PITCH_OFFSET, 0x16e0, FLAG_SHADOW, r100_default_pitch_offset_fields, NULL) \
+  X(r100_display_base_addr, R100_DISPLAY_BASE_ADDR, 0x23c, FLAG_SHADOW, NULL, NULL) \
+  X(r100_mc_fb_location, R100_MC_FB_LOCATION, 0x148, FLAG_SHADOW, r100_mc_fb_location_fields, NULL) \
+  X(r100_mc_agp_location, R100_MC_AGP_LOCATION, 0x14c, FLAG_SHADOW, r100_mc_agp_location_fields, NULL) \
+  X(r100_agp_command, R100_AGP_COMMAND, 0xf60, 0, r100_agp_command_fields, NULL) \
+  X(r100_config_aper_size, R100_CONFIG_APER_SIZE, 0x108, FLAG_NO_SNAPSHOT, r100_config_aper_size_fields, NULL) \
+  X(r100_crtc_gen_cntl, R100_CRTC_GEN_CNTL, 0x50, 0, r100_crtc_gen_cntl_fields, NULL) \
+  X(r100_crtc_pitch, R100_CRTC_PITCH, 0x22c, FLAG_SHADOW, r100_crtc_pitch_fields, NULL) \
+  X(r100_cp_rb_cntl, R100_CP_RB_CNTL, 0x704, FLAG_NO_SNAPSHOT, r100_cp_rb_cntl_fields, NULL) \
+  X(r100_cp_rb_base, R100_CP_RB_BASE, 0x700, FLAG_NO_SNAPSHOT, r100_cp_rb_base_fields, NULL) \
+  X(r100_cp_rb_wptr_delay, R100_CP_RB_WPTR_DELAY, 0x718, FLAG_NO_SNAPSHOT, r100_cp_rb_wptr_delay_fields, NULL) \
+  X(r100_cp_rb_rptr_addr, R100_CP_RB_RPTR_ADDR, 0x70c, FLAG_NO_SNAPSHOT, r100_cp_rb_rptr_addr_fields, NULL) \
+  X(r100_cp_rb_rptr, R100_CP_RB_RPTR, 0x710, FLAG_NO_SNAPSHOT, r100_cp_rb_rptr_fields, NULL) \
+  X(r100_cp_rb_wptr, R100_CP_RB_WPTR, 0x714, FLAG_NO_SNAPSHOT, r100_cp_rb_wptr_fields, NULL) \
+  X(r100_cp_rb_rptr_wr, R100_CP_RB_RPTR_WR, 0x71c, FLAG_NO_SNAPSHOT, r100_cp_rb_rptr_wr_fields, NULL) \
+  X(r100_cp_ib_base, R100_CP_IB_BASE, 0x738, FLAG_NO_SNAPSHOT, r100_cp_ib_base_fields, NULL) \
+  X(r100_cp_ib_bufsz, R100_CP_IB_BUFSZ, 0x73c, FLAG_NO_SNAPSHOT, r100_cp_ib_bufsz_fields, NULL) \
+  X(r100_cp_csq_cntl, R100_CP_CSQ_CNTL, 0x740, FLAG_NO_SNAPSHOT, r100_cp_csq_cntl_fields, NULL) \
+  X(r100_cp_stat, R100_CP_STAT, 0x7c0, FLAG_NO_WRITE | FLAG_NO_SNAPSHOT, r100_cp_stat_fields, NULL) \
+  X(r100_cp_me_cntl, R100_CP_ME_CNTL, 0x7d0, FLAG_NO_SNAPSHOT, r100_cp_me_cntl_fields, NULL) \
+  X(r100_cp_me_ram_addr, R100_CP_ME_RAM_ADDR, 0x7d4, FLAG_NO_SNAPSHOT, r100_cp_me_ram_addr_fields, NULL) \
+  X(r100_cp_me_ram_raddr, R100_CP_ME_RAM_RADDR, 0x7d8, FLAG_NO_SNAPSHOT, r100_cp_me_ram_raddr_fields, NULL) \
+  X(r100_cp_me_ram_datah, R100_CP_ME_RAM_DATAH, 0x7dc, FLAG_INDIRECT | FLAG_NO_SNAPSHOT, r100_cp_me_ram_datah_fields, NULL) \
+  X(r100_cp_me_ram_datal, R100_CP_ME_RAM_DATAL, 0x7e0, FLAG_READ_SIDE_EFFECTS | FLAG_INDIRECT | FLAG_NO_SNAPSHOT, r100_cp_me_ram_datal_fields, NULL) \
+  X(r100_cp_csq_addr, R100_CP_CSQ_ADDR, 0x7f0, FLAG_NO_READ | FLAG_NO_SNAPSHOT, r100_cp_csq_addr_fields, NULL) \
+  X(r100_cp_csq_data, R100_CP_CSQ_DATA, 0x7f4, FLAG_NO_WRITE | FLAG_NO_SNAPSHOT, r100_cp_csq_data_fields, NULL) \
+  X(r100_cp_csq_stat, R100_CP_CSQ_STAT, 0x7f8, FLAG_NO_WRITE | FLAG_NO_SNAPSHOT, r100_cp_csq_stat_fields, NULL) \
+  X(r100_cp_debug, R100_CP_DEBUG, 0x7ec, FLAG_NO_SNAPSHOT, r100_cp_debug_fields, NULL) \
+  X(r100_rbbm_status, R100_RBBM_STATUS, 0x1740, FLAG_NO_WRITE, r100_rbbm_status_fields, NULL) \
+  X(r100_cp_csq_aper_primary, R100_CP_CSQ_APER_PRIMARY, 0x1000, FLAG_NO_SNAPSHOT, r100_cp_csq_aper_primary_fields, NULL) \
+  X(r100_isync_cntl, R100_ISYNC_CNTL, 0x1724, FLAG_NO_SNAPSHOT, r100_isync_cntl_fields, NULL) \
+  X(r100_rb2d_dstcache_ctlstat, R100_RB2D_DSTCACHE_CTLSTAT, 0x342c, FLAG_NO_SNAPSHOT, r100_rb2d_dstcache_ctlstat_fields, r100_rb2d_dstcache_ctlstat_aliases) \
+  X(r100_scratch_addr, R100_SCRATCH_ADDR, 0x774, 0, r100_scratch_addr_fields, NULL) \
+  X(r100_scratch_umsk, R100_SCRATCH_UMSK, 0x770, 0, r100_scratch_umsk_fields, NULL) \
+  X(r100_aic_ctrl, R100_AIC_CTRL, 0x1d0, 0, r100_aic_ctrl_fields, NULL) \
+  X(r100_aic_pt_base, R100_AIC_PT_BASE, 0x1d8, 0, r100_aic_pt_base_fields, NULL) \
+  X(r100_aic_lo_addr, R100_AIC_LO_ADDR, 0x1dc, 0, r100_aic_lo_addr_fields, NULL) \
+  X(r100_aic_hi_addr, R100_AIC_HI_ADDR, 0x1e0, 0, r100_aic_hi_addr_fields, NULL) \
+  X(r100_viph_control, R100_VIPH_CONTROL, 0xc40, 0, NULL, NULL) \
+  X(r100_re_stipple_addr, R100_RE_STIPPLE_ADDR, 0x1cc8, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r100_re_stipple_data, R100_RE_STIPPLE_DATA, 0x1ccc, FLAG_READ_SIDE_EFFECTS | FLAG_INDIRECT, NULL, NULL)
+
+// ============================================================================
+// Register Accessors
+// ============================================================================
+
+#ifdef ATI_REG_ACCESSORS
+static inline uint32_t rd_r100_bus_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_BUS_CNTL, "r100_bus_cntl"); }
+static inline void wr_r100_bus_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_BUS_CNTL, val, "r100_bus_cntl"); }
+static inline uint32_t rd_r100_grph_buffer_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_GRPH_BUFFER_CNTL, "r100_grph_buffer_cntl"); }
+static inline void wr_r100_grph_buffer_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_GRPH_BUFFER_CNTL, val, "r100_grph_buffer_cntl"); }
+static inline uint32_t rd_r100_src_pitch_offset(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_SRC_PITCH_OFFSET, "r100_src_pitch_offset"); }
+static inline void wr_r100_src_pitch_offset(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_SRC_PITCH_OFFSET, val, "r100_src_pitch_offset"); }
+static inline uint32_t rd_r100_dst_pitch_offset(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_DST_PITCH_OFFSET, "r100_dst_pitch_offset"); }
+static inline void wr_r100_dst_pitch_offset(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_DST_PITCH_OFFSET, val, "r100_dst_pitch_offset"); }
+static inline uint32_t rd_r100_dp_gui_master_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_DP_GUI_MASTER_CNTL, "r100_dp_gui_master_cntl"); }
+static inline void wr_r100_dp_gui_master_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_DP_GUI_MASTER_CNTL, val, "r100_dp_gui_master_cntl"); }
+static inline uint32_t rd_r100_dp_datatype(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_DP_DATATYPE, "r100_dp_datatype"); }
+static inline void wr_r100_dp_datatype(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_DP_DATATYPE, val, "r100_dp_datatype"); }
+static inline uint32_t rd_r100_default_pitch_offset(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_DEFAULT_PITCH_OFFSET, "r100_default_pitch_offset"); }
+static inline void wr_r100_default_pitch_offset(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_DEFAULT_PITCH_OFFSET, val, "r100_default_pitch_offset"); }
+static inline uint32_t rd_r100_display_base_addr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_DISPLAY_BASE_ADDR, "r100_display_base_addr"); }
+static inline void wr_r100_display_base_addr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_DISPLAY_BASE_ADDR, val, "r100_display_base_addr"); }
+static inline uint32_t rd_r100_mc_fb_location(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_MC_FB_LOCATION, "r100_mc_fb_location"); }
+static inline void wr_r100_mc_fb_location(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_MC_FB_LOCATION, val, "r100_mc_fb_location"); }
+static inline uint32_t rd_r100_mc_agp_location(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_MC_AGP_LOCATION, "r100_mc_agp_location"); }
+static inline void wr_r100_mc_agp_location(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_MC_AGP_LOCATION, val, "r100_mc_agp_location"); }
+static inline uint32_t rd_r100_agp_command(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_AGP_COMMAND, "r100_agp_command"); }
+static inline void wr_r100_agp_command(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_AGP_COMMAND, val, "r100_agp_command"); }
+static inline uint32_t rd_r100_config_aper_size(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CONFIG_APER_SIZE, "r100_config_aper_size"); }
+static inline void wr_r100_config_aper_size(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CONFIG_APER_SIZE, val, "r100_config_aper_size"); }
+static inline uint32_t rd_r100_crtc_gen_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CRTC_GEN_CNTL, "r100_crtc_gen_cntl"); }
+static inline void wr_r100_crtc_gen_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CRTC_GEN_CNTL, val, "r100_crtc_gen_cntl"); }
+static inline uint32_t rd_r100_crtc_pitch(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CRTC_PITCH, "r100_crtc_pitch"); }
+static inline void wr_r100_crtc_pitch(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CRTC_PITCH, val, "r100_crtc_pitch"); }
+static inline uint32_t rd_r100_cp_rb_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_RB_CNTL, "r100_cp_rb_cntl"); }
+static inline void wr_r100_cp_rb_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_RB_CNTL, val, "r100_cp_rb_cntl"); }
+static inline uint32_t rd_r100_cp_rb_base(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_RB_BASE, "r100_cp_rb_base"); }
+static inline void wr_r100_cp_rb_base(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_RB_BASE, val, "r100_cp_rb_base"); }
+static inline uint32_t rd_r100_cp_rb_wptr_delay(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_RB_WPTR_DELAY, "r100_cp_rb_wptr_delay"); }
+static inline void wr_r100_cp_rb_wptr_delay(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_RB_WPTR_DELAY, val, "r100_cp_rb_wptr_delay"); }
+static inline uint32_t rd_r100_cp_rb_rptr_addr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_RB_RPTR_ADDR, "r100_cp_rb_rptr_addr"); }
+static inline void wr_r100_cp_rb_rptr_addr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_RB_RPTR_ADDR, val, "r100_cp_rb_rptr_addr"); }
+static inline uint32_t rd_r100_cp_rb_rptr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_RB_RPTR, "r100_cp_rb_rptr"); }
+static inline void wr_r100_cp_rb_rptr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_RB_RPTR, val, "r100_cp_rb_rptr"); }
+static inline uint32_t rd_r100_cp_rb_wptr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_RB_WPTR, "r100_cp_rb_wptr"); }
+static inline void wr_r100_cp_rb_wptr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_RB_WPTR, val, "r100_cp_rb_wptr"); }
+static inline uint32_t rd_r100_cp_rb_rptr_wr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_RB_RPTR_WR, "r100_cp_rb_rptr_wr"); }
+static inline void wr_r100_cp_rb_rptr_wr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_RB_RPTR_WR, val, "r100_cp_rb_rptr_wr"); }
+static inline uint32_t rd_r100_cp_ib_base(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_IB_BASE, "r100_cp_ib_base"); }
+static inline void wr_r100_cp_ib_base(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_IB_BASE, val, "r100_cp_ib_base"); }
+static inline uint32_t rd_r100_cp_ib_bufsz(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_IB_BUFSZ, "r100_cp_ib_bufsz"); }
+static inline void wr_r100_cp_ib_bufsz(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_IB_BUFSZ, val, "r100_cp_ib_bufsz"); }
+static inline uint32_t rd_r100_cp_csq_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_CSQ_CNTL, "r100_cp_csq_cntl"); }
+static inline void wr_r100_cp_csq_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_CSQ_CNTL, val, "r100_cp_csq_cntl"); }
+static inline uint32_t rd_r100_cp_stat(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_STAT, "r100_cp_stat"); }
+static inline void wr_r100_cp_stat(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_STAT, val, "r100_cp_stat"); }
+static inline uint32_t rd_r100_cp_me_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_ME_CNTL, "r100_cp_me_cntl"); }
+static inline void wr_r100_cp_me_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_ME_CNTL, val, "r100_cp_me_cntl"); }
+static inline uint32_t rd_r100_cp_me_ram_addr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_ME_RAM_ADDR, "r100_cp_me_ram_addr"); }
+static inline void wr_r100_cp_me_ram_addr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_ME_RAM_ADDR, val, "r100_cp_me_ram_addr"); }
+static inline uint32_t rd_r100_cp_me_ram_raddr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_ME_RAM_RADDR, "r100_cp_me_ram_raddr"); }
+static inline void wr_r100_cp_me_ram_raddr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_ME_RAM_RADDR, val, "r100_cp_me_ram_raddr"); }
+static inline uint32_t rd_r100_cp_me_ram_datah(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_ME_RAM_DATAH, "r100_cp_me_ram_datah"); }
+static inline void wr_r100_cp_me_ram_datah(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_ME_RAM_DATAH, val, "r100_cp_me_ram_datah"); }
+static inline uint32_t rd_r100_cp_me_ram_datal(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_ME_RAM_DATAL, "r100_cp_me_ram_datal"); }
+static inline void wr_r100_cp_me_ram_datal(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_ME_RAM_DATAL, val, "r100_cp_me_ram_datal"); }
+static inline uint32_t rd_r100_cp_csq_addr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_CSQ_ADDR, "r100_cp_csq_addr"); }
+static inline void wr_r100_cp_csq_addr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_CSQ_ADDR, val, "r100_cp_csq_addr"); }
+static inline uint32_t rd_r100_cp_csq_data(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_CSQ_DATA, "r100_cp_csq_data"); }
+static inline void wr_r100_cp_csq_data(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_CSQ_DATA, val, "r100_cp_csq_data"); }
+static inline uint32_t rd_r100_cp_csq_stat(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_CSQ_STAT, "r100_cp_csq_stat"); }
+static inline void wr_r100_cp_csq_stat(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_CSQ_STAT, val, "r100_cp_csq_stat"); }
+static inline uint32_t rd_r100_cp_debug(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_DEBUG, "r100_cp_debug"); }
+static inline void wr_r100_cp_debug(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_DEBUG, val, "r100_cp_debug"); }
+static inline uint32_t rd_r100_rbbm_status(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_RBBM_STATUS, "r100_rbbm_status"); }
+static inline void wr_r100_rbbm_status(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_RBBM_STATUS, val, "r100_rbbm_status"); }
+static inline uint32_t rd_r100_cp_csq_aper_primary(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_CP_CSQ_APER_PRIMARY, "r100_cp_csq_aper_primary"); }
+static inline void wr_r100_cp_csq_aper_primary(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_CP_CSQ_APER_PRIMARY, val, "r100_cp_csq_aper_primary"); }
+static inline uint32_t rd_r100_isync_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_ISYNC_CNTL, "r100_isync_cntl"); }
+static inline void wr_r100_isync_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_ISYNC_CNTL, val, "r100_isync_cntl"); }
+static inline uint32_t rd_r100_rb2d_dstcache_ctlstat(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_RB2D_DSTCACHE_CTLSTAT, "r100_rb2d_dstcache_ctlstat"); }
+static inline void wr_r100_rb2d_dstcache_ctlstat(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_RB2D_DSTCACHE_CTLSTAT, val, "r100_rb2d_dstcache_ctlstat"); }
+static inline uint32_t rd_r100_scratch_addr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_SCRATCH_ADDR, "r100_scratch_addr"); }
+static inline void wr_r100_scratch_addr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_SCRATCH_ADDR, val, "r100_scratch_addr"); }
+static inline uint32_t rd_r100_scratch_umsk(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_SCRATCH_UMSK, "r100_scratch_umsk"); }
+static inline void wr_r100_scratch_umsk(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_SCRATCH_UMSK, val, "r100_scratch_umsk"); }
+static inline uint32_t rd_r100_aic_ctrl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_AIC_CTRL, "r100_aic_ctrl"); }
+static inline void wr_r100_aic_ctrl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_AIC_CTRL, val, "r100_aic_ctrl"); }
+static inline uint32_t rd_r100_aic_pt_base(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_AIC_PT_BASE, "r100_aic_pt_base"); }
+static inline void wr_r100_aic_pt_base(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_AIC_PT_BASE, val, "r100_aic_pt_base"); }
+static inline uint32_t rd_r100_aic_lo_addr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_AIC_LO_ADDR, "r100_aic_lo_addr"); }
+static inline void wr_r100_aic_lo_addr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_AIC_LO_ADDR, val, "r100_aic_lo_addr"); }
+static inline uint32_t rd_r100_aic_hi_addr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_AIC_HI_ADDR, "r100_aic_hi_addr"); }
+static inline void wr_r100_aic_hi_addr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_AIC_HI_ADDR, val, "r100_aic_hi_addr"); }
+static inline uint32_t rd_r100_viph_control(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_VIPH_CONTROL, "r100_viph_control"); }
+static inline void wr_r100_viph_control(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_VIPH_CONTROL, val, "r100_viph_control"); }
+static inline uint32_t rd_r100_re_stipple_addr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_RE_STIPPLE_ADDR, "r100_re_stipple_addr"); }
+static inline void wr_r100_re_stipple_addr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_RE_STIPPLE_ADDR, val, "r100_re_stipple_addr"); }
+static inline uint32_t rd_r100_re_stipple_data(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R100, R100_RE_STIPPLE_DATA, "r100_re_stipple_data"); }
+static inline void wr_r100_re_stipple_data(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R100, R100_RE_STIPPLE_DATA, val, "r100_re_stipple_data"); }
+#endif // ATI_REG_ACCESSORS
+
+#endif // R100_REGS_GEN_H
\ No newline at end of file
@@ -0,0 +1,772 @@
+// Auto-generated from registers/r128.yaml - DO NOT EDIT
+// Generated by: bin/generate_registers --chip r128 --prefix R128_
+//
+// ATI Rage 128 Pro specific register definitions.
+//
+// Field values are PRE-SHIFTED and can be ORed directly into register values.
+// Example: reg |= R128_GMC_BRUSH_DATATYPE_SOLIDCOLOR | R128_GMC_ROP3_SRCCOPY;
+
+#ifndef R128_REGS_GEN_H
+#define R128_REGS_GEN_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+
+// Note: field_value_t, field_entry_t, and flag enums are defined in common_regs_gen.h
+
+#include "common_regs_gen.h"
+
+
+// ============================================================================
+// Field Constants
+// ============================================================================
+
+// R128_BUS_CNTL fields
+enum {
+    R128_BUS_MASTER_DIS = (1u << 6),
+};
+
+// R128_SRC_PITCH_OFFSET fields
+enum {
+    R128_SRC_OFFSET_SHIFT = 0,
+    R128_SRC_OFFSET_MASK = 0x1fffffu,
+    R128_SRC_PITCH_SHIFT = 21,
+    R128_SRC_PITCH_MASK = 0x7fe00000u,
+    R128_SRC_TILE = (1u << 31),
+};
+
+// R128_DP_GUI_MASTER_CNTL fields
+enum {
+    R128_GMC_SRC_PITCH_OFFSET_CNTL = (1u << 0),
+    R128_GMC_DST_PITCH_OFFSET_CNTL = (1u << 1),
+    R128_GMC_SRC_CLIPPING = (1u << 2),
+    R128_GMC_DST_CLIPPING = (1u << 3),
+    R128_GMC_BRUSH_DATATYPE_SHIFT = 4,
+    R128_GMC_BRUSH_DATATYPE_MASK = 0xf0u,
+    R128_GMC_BRUSH_DATATYPE_8X8_MONO = 0u,
+    R128_GMC_BRUSH_DATATYPE_8X8_MONO_TRANS = 0x10u,
+    R128_GMC_BRUSH_DATATYPE_8X1_MONO = 0x20u,
+    R128_GMC_BRUSH_DATATYPE_8X1_MONO_TRANS = 0x30u,
+    R128_GMC_BRUSH_DATATYPE_1X8_MONO = 0x40u,
+    R128_GMC_BRUSH_DATATYPE_1X8_MONO_TRANS = 0x50u,
+    R128_GMC_BRUSH_DATATYPE_32X1_MONO = 0x60u,
+    R128_GMC_BRUSH_DATATYPE_32X1_MONO_TRANS = 0x70u,
+    R128_GMC_BRUSH_DATATYPE_32X32_MONO = 0x80u,
+    R128_GMC_BRUSH_DATATYPE_32X32_MONO_TRANS = 0x90u,
+    R128_GMC_BRUSH_DATATYPE_8X8_COLOR = 0xa0u,
+    R128_GMC_BRUSH_DATATYPE_8X1_COLOR = 0xb0u,
+    R128_GMC_BRUSH_DATATYPE_1X8_COLOR = 0xc0u,
+    R128_GMC_BRUSH_DATATYPE_SOLIDCOLOR = 0xd0u,
+    R128_GMC_BRUSH_DATATYPE_NONE = 0xf0u,
+    R128_GMC_DST_DATATYPE_SHIFT = 8,
+    R128_GMC_DST_DATATYPE_MASK = 0xf00u,
+    R128_GMC_DST_DATATYPE_PSEUDO_COLOR_8 = 0x200u,
+    R128_GMC_DST_DATATYPE_ARGB_1555 = 0x300u,
+    R128_GMC_DST_DATATYPE_RGB_565 = 0x400u,
+    R128_GMC_DST_DATATYPE_RGB_888 = 0x500u,
+    R128_GMC_DST_DATATYPE_ARGB_8888 = 0x600u,
+    R128_GMC_DST_DATATYPE_RGB_332 = 0x700u,
+    R128_GMC_DST_DATATYPE_Y8_GREYSCALE = 0x800u,
+    R128_GMC_DST_DATATYPE_RGB_8_GREYSCALE = 0x900u,
+    R128_GMC_DST_DATATYPE_YUV_422_VYUY = 0xb00u,
+    R128_GMC_DST_DATATYPE_YUV_422_YVYU = 0xc00u,
+    R128_GMC_DST_DATATYPE_AYUV_444_8888 = 0xe00u,
+    R128_GMC_DST_DATATYPE_ARGB_4444 = 0xf00u,
+    R128_GMC_SRC_DATATYPE_SHIFT = 12,
+    R128_GMC_SRC_DATATYPE_MASK = 0x3000u,
+    R128_GMC_SRC_DATATYPE_MONO = 0u,
+    R128_GMC_SRC_DATATYPE_MONO_TRANS = 0x1000u,
+    R128_GMC_SRC_DATATYPE_DST_COLOR = 0x3000u,
+    R128_GMC_BYTE_PIX_ORDER = (1u << 14),
+    R128_GMC_CONVERSION_TEMP = (1u << 15),
+    R128_GMC_ROP3_SHIFT = 16,
+    R128_GMC_ROP3_MASK = 0xff0000u,
+    R128_GMC_ROP3_SRCCOPY = 0xcc0000u,
+    R128_GMC_SRC_SOURCE_SHIFT = 24,
+    R128_GMC_SRC_SOURCE_MASK = 0x7000000u,
+    R128_GMC_SRC_SOURCE_MEMORY = 0x2000000u,
+    R128_GMC_SRC_SOURCE_HOST_DATA = 0x3000000u,
+    R128_GMC_SRC_SOURCE_HOST_DATA_ALIGNED = 0x4000000u,
+    R128_GMC_3D_FCN_EN = (1u << 27),
+    R128_GMC_CLR_CMP_CNTL_DIS = (1u << 28),
+    R128_GMC_AUX_CLIP_DIS = (1u << 29),
+    R128_GMC_WR_MSK_DIS = (1u << 30),
+    R128_GMC_LD_BRUSH_Y_X = (1u << 31),
+};
+
+// R128_DP_DATATYPE fields
+enum {
+    R128_DP_DST_DATATYPE_SHIFT = 0,
+    R128_DP_DST_DATATYPE_MASK = 0xfu,
+    R128_DP_DST_DATATYPE_PSEUDO_COLOR_8 = 2u,
+    R128_DP_DST_DATATYPE_ARGB_1555 = 3u,
+    R128_DP_DST_DATATYPE_RGB_565 = 4u,
+    R128_DP_DST_DATATYPE_RGB_888 = 5u,
+    R128_DP_DST_DATATYPE_ARGB_8888 = 6u,
+    R128_DP_DST_DATATYPE_RGB_332 = 7u,
+    R128_DP_DST_DATATYPE_Y8_GREYSCALE = 8u,
+    R128_DP_DST_DATATYPE_RGB_8_GREYSCALE = 9u,
+    R128_DP_DST_DATATYPE_YUV_422_VYUY = 0xbu,
+    R128_DP_DST_DATATYPE_YUV_422_YVYU = 0xcu,
+    R128_DP_DST_DATATYPE_AYUV_444_8888 = 0xeu,
+    R128_DP_DST_DATATYPE_ARGB_4444 = 0xfu,
+    R128_DP_BRUSH_DATATYPE_SHIFT = 8,
+    R128_DP_BRUSH_DATATYPE_MASK = 0xf00u,
+    R128_DP_BRUSH_DATATYPE_8X8_MONO = 0u,
+    R128_DP_BRUSH_DATATYPE_8X8_MONO_TRANS = 0x100u,
+    R128_DP_BRUSH_DATATYPE_8X1_MONO = 0x200u,
+    R128_DP_BRUSH_DATATYPE_8X1_MONO_TRANS = 0x300u,
+    R128_DP_BRUSH_DATATYPE_1X8_MONO = 0x400u,
+    R128_DP_BRUSH_DATATYPE_1X8_MONO_TRANS = 0x500u,
+    R128_DP_BRUSH_DATATYPE_32X1_MONO = 0x600u,
+    R128_DP_BRUSH_DATATYPE_32X1_MONO_TRANS = 0x700u,
+    R128_DP_BRUSH_DATATYPE_32X32_MONO = 0x800u,
+    R128_DP_BRUSH_DATATYPE_32X32_MONO_TRANS = 0x900u,
+    R128_DP_BRUSH_DATATYPE_8X8_COLOR = 0xa00u,
+    R128_DP_BRUSH_DATATYPE_8X1_COLOR = 0xb00u,
+    R128_DP_BRUSH_DATATYPE_1X8_COLOR = 0xc00u,
+    R128_DP_BRUSH_DATATYPE_SOLIDCOLOR = 0xd00u,
+    R128_DP_BRUSH_DATATYPE_NONE = 0xf00u,
+    R128_DP_SRC_DATATYPE_SHIFT = 16,
+    R128_DP_SRC_DATATYPE_MASK = 0x30000u,
+    R128_DP_SRC_DATATYPE_MONO = 0u,
+    R128_DP_SRC_DATATYPE_MONO_TRANS = 0x10000u,
+    R128_DP_SRC_DATATYPE_DST_COLOR = 0x30000u,
+    R128_HOST_BIG_ENDIAN_EN = (1u << 29),
+    R128_DP_BYTE_PIX_ORDER = (1u << 30),
+    R128_DP_CONVERSION_TEMP = (1u << 31),
+};
+
+// R128_DEFAULT_OFFSET fields
+enum {
+    R128_DEFAULT_OFFSET_SHIFT = 0,
+    R128_DEFAULT_OFFSET_MASK = 0x3ffffffu,
+};
+
+// R128_DEFAULT_PITCH fields
+enum {
+    R128_DEFAULT_PITCH_SHIFT = 0,
+    R128_DEFAULT_PITCH_MASK = 0x3ffu,
+    R128_DEFAULT_TILE = (1u << 16),
+};
+
+// R128_CRTC_GEN_CNTL fields
+enum {
+    R128_CRTC_DBL_SCAN_EN = (1u << 0),
+    R128_CRTC_INTERLACE_EN = (1u << 1),
+    R128_CRTC_C_SYNC_EN = (1u << 4),
+    R128_CRTC_PIX_WIDTH_SHIFT = 8,
+    R128_CRTC_PIX_WIDTH_MASK = 0x700u,
+    R128_CRTC_PIX_WIDTH_4BPP = 0x100u,
+    R128_CRTC_PIX_WIDTH_8BPP = 0x200u,
+    R128_CRTC_PIX_WIDTH_15BPP = 0x300u,
+    R128_CRTC_PIX_WIDTH_16BPP = 0x400u,
+    R128_CRTC_PIX_WIDTH_24BPP = 0x500u,
+    R128_CRTC_PIX_WIDTH_32BPP = 0x600u,
+    R128_CRTC_CUR_EN = (1u << 16),
+    R128_CRTC_CUR_MODE_SHIFT = 17,
+    R128_CRTC_CUR_MODE_MASK = 0xe0000u,
+    R128_CRTC_CUR_MODE_64X64_MONO = 0u,
+    R128_CRTC_EXT_DISP_EN = (1u << 24),
+    R128_CRTC_EN = (1u << 25),
+    R128_CRTC_DISP_REQ_EN_B = (1u << 26),
+};
+
+// R128_CRTC_PITCH fields
+enum {
+    R128_CRTC_PITCH_SHIFT = 0,
+    R128_CRTC_PITCH_MASK = 0x3ffu,
+};
+
+// R128_PM4_BUFFER_CNTL fields
+enum {
+    R128_PM4_BUFFER_SIZE_L2QW_SHIFT = 0,
+    R128_PM4_BUFFER_SIZE_L2QW_MASK = 0x7ffffffu,
+    R128_PM4_BUFFER_CNTL_NOUPDATE = (1u << 27),
+    R128_PM4_BUFFER_MODE_SHIFT = 28,
+    R128_PM4_BUFFER_MODE_MASK = 0xf0000000u,
+    R128_PM4_BUFFER_MODE_NONPM4 = 0u,
+    R128_PM4_BUFFER_MODE_192PIO = 0x10000000u,
+    R128_PM4_BUFFER_MODE_192BM = 0x20000000u,
+    R128_PM4_BUFFER_MODE_128PIO_64INDBM = 0x30000000u,
+    R128_PM4_BUFFER_MODE_128BM_64INDBM = 0x40000000u,
+    R128_PM4_BUFFER_MODE_64PIO_128INDBM = 0x50000000u,
+    R128_PM4_BUFFER_MODE_64BM_128INDBM = 0x60000000u,
+    R128_PM4_BUFFER_MODE_64PIO_64VCBM_64INDBM = 0x70000000u,
+    R128_PM4_BUFFER_MODE_64BM_64VCBM_64INDBM = 0x80000000u,
+    R128_PM4_BUFFER_MODE_64PIO_64VCPIO_64INDPIO = 0xf0000000u,
+};
+
+// R128_PM4_BUFFER_WM_CNTL fields
+enum {
+    R128_WMA_SHIFT = 0,
+    R128_WMA_MASK = 0xffu,
+    R128_WMB_SHIFT = 8,
+    R128_WMB_MASK = 0xff00u,
+    R128_WMC_SHIFT = 16,
+    R128_WMC_MASK = 0xff0000u,
+    R128_WB_WM_SHIFT = 24,
+    R128_WB_WM_MASK = 0xff000000u,
+};
+
+// R128_PM4_MICRO_CNTL fields
+enum {
+    R128_ME_STAT_SHIFT = 0,
+    R128_ME_STAT_MASK = 0xffffu,
+    R128_ME_STAT_IDLE = 0x3fffu,
+    R128_ME_STAT_MUX_SHIFT = 16,
+    R128_ME_STAT_MUX_MASK = 0x1f0000u,
+    R128_ME_STAT_MUX_PKT_DWORDS_REMAIN = 0u,
+    R128_ME_STAT_MUX_PKT_CURR_REGISTER = 0x10000u,
+    R128_PM4_MICRO_FREERUN = (1u << 30),
+    R128_ME_STEP = (1u << 31),
+};
+
+// R128_PM4_MICROCODE_ADDR fields
+enum {
+    R128_PM4_MICROCODE_ADDR_SHIFT = 0,
+    R128_PM4_MICROCODE_ADDR_MASK = 0xffu,
+};
+
+// R128_PM4_STAT fields
+enum {
+    R128_PM4_FIFOCNT_SHIFT = 0,
+    R128_PM4_FIFOCNT_MASK = 0xfffu,
+    R128_PM4_BUSY = (1u << 16),
+    R128_MICRO_BUSY = (1u << 17),
+    R128_FPU_BUSY = (1u << 18),
+    R128_VC_BUSY = (1u << 19),
+    R128_IDCT_BUSY = (1u << 20),
+    R128_ENG_EV_BUSY = (1u << 21),
+    R128_SETUP_BUSY = (1u << 22),
+    R128_EDGEWALK_BUSY = (1u << 23),
+    R128_ADDRESSING_BUSY = (1u << 24),
+    R128_ENG_3D_BUSY = (1u << 25),
+    R128_ENG_2D_SM_BUSY = (1u << 26),
+    R128_ENG_2D_BUSY = (1u << 27),
+    R128_GUI_WB_BUSY = (1u << 28),
+    R128_CACHE_BUSY = (1u << 29),
+    R128_PM4_GUI_ACTIVE = (1u << 31),
+};
+
+// R128_GUI_STAT fields
+enum {
+    R128_GUI_FIFO_CNT_SHIFT = 0,
+    R128_GUI_FIFO_CNT_MASK = 0xfffu,
+    R128_GUI_ACTIVE = (1u << 31),
+};
+
+// R128_GEN_RESET_CNTL fields
+enum {
+    R128_SOFT_RESET_GUI = (1u << 0),
+};
+
+// R128_PC_NGUI_CTLSTAT fields
+enum {
+    R128_PC_FLUSH_GUI_SHIFT = 0,
+    R128_PC_FLUSH_GUI_MASK = 0x3u,
+    R128_PC_RI_GUI_SHIFT = 2,
+    R128_PC_RI_GUI_MASK = 0xcu,
+    R128_PC_FLUSH_NONGUI_SHIFT = 4,
+    R128_PC_FLUSH_NONGUI_MASK = 0x30u,
+    R128_PC_RI_NONGUI_SHIFT = 6,
+    R128_PC_RI_NONGUI_MASK = 0xc0u,
+    R128_PC_PURGE_GUI = (1u << 8),
+    R128_PC_PURGE_NONGUI = (1u << 9),
+    R128_PC_DIRTY = (1u << 24),
+    R128_PC_PURGE_DOPURGE = (1u << 25),
+    R128_PC_FLUSH_DOFLUSH = (1u << 26),
+    R128_PC_BUSY_INIT = (1u << 27),
+    R128_PC_BUSY_FLUSH = (1u << 28),
+    R128_PC_BUSY_GUI = (1u << 29),
+    R128_PC_BUSY_NGUI = (1u << 30),
+    R128_PC_BUSY = (1u << 31),
+    // Aliases
+    R128_PC_FLUSH_ALL_SHIFT = 0,
+    R128_PC_FLUSH_ALL_MASK = 0xffu,
+};
+
+// ============================================================================
+// Field Value Tables (for REPL display of named values)
+// ============================================================================
+
+static const field_value_t r128_gmc_brush_datatype_values[] = {
+    {"8X8_MONO", 0},
+    {"8X8_MONO_TRANS", 1},
+    {"8X1_MONO", 2},
+    {"8X1_MONO_TRANS", 3},
+    {"1X8_MONO", 4},
+    {"1X8_MONO_TRANS", 5},
+    {"32X1_MONO", 6},
+    {"32X1_MONO_TRANS", 7},
+    {"32X32_MONO", 8},
+    {"32X32_MONO_TRANS", 9},
+    {"8X8_COLOR", 10},
+    {"8X1_COLOR", 11},
+    {"1X8_COLOR", 12},
+    {"SOLIDCOLOR", 13},
+    {"NONE", 15},
+    {NULL, 0}
+};
+
+static const field_value_t r128_gmc_dst_datatype_values[] = {
+    {"PSEUDO_COLOR_8", 2},
+    {"ARGB_1555", 3},
+    {"RGB_565", 4},
+    {"RGB_888", 5},
+    {"ARGB_8888", 6},
+    {"RGB_332", 7},
+    {"Y8_GREYSCALE", 8},
+    {"RGB_8_GREYSCALE", 9},
+    {"YUV_422_VYUY", 11},
+    {"YUV_422_YVYU", 12},
+    {"AYUV_444_8888", 14},
+    {"ARGB_4444", 15},
+    {NULL, 0}
+};
+
+static const field_value_t r128_gmc_src_datatype_values[] = {
+    {"MONO", 0},
+    {"MONO_TRANS", 1},
+    {"DST_COLOR", 3},
+    {NULL, 0}
+};
+
+static const field_value_t r128_gmc_rop3_values[] = {
+    {"SRCCOPY", 204},
+    {NULL, 0}
+};
+
+static const field_value_t r128_gmc_src_source_values[] = {
+    {"MEMORY", 2},
+    {"HOST_DATA", 3},
+    {"HOST_DATA_ALIGNED", 4},
+    {NULL, 0}
+};
+
+static const field_value_t r128_dp_dst_datatype_values[] = {
+    {"PSEUDO_COLOR_8", 2},
+    {"ARGB_1555", 3},
+    {"RGB_565", 4},
+    {"RGB_888", 5},
+    {"ARGB_8888", 6},
+    {"RGB_332", 7},
+    {"Y8_GREYSCALE", 8},
+    {"RGB_8_GREYSCALE", 9},
+    {"YUV_422_VYUY", 11},
+    {"YUV_422_YVYU", 12},
+    {"AYUV_444_8888", 14},
+    {"ARGB_4444", 15},
+    {NULL, 0}
+};
+
+static const field_value_t r128_dp_brush_datatype_values[] = {
+    {"8X8_MONO", 0},
+    {"8X8_MONO_TRANS", 1},
+    {"8X1_MONO", 2},
+    {"8X1_MONO_TRANS", 3},
+    {"1X8_MONO", 4},
+    {"1X8_MONO_TRANS", 5},
+    {"32X1_MONO", 6},
+    {"32X1_MONO_TRANS", 7},
+    {"32X32_MONO", 8},
+    {"32X32_MONO_TRANS", 9},
+    {"8X8_COLOR", 10},
+    {"8X1_COLOR", 11},
+    {"1X8_COLOR", 12},
+    {"SOLIDCOLOR", 13},
+    {"NONE", 15},
+    {NULL, 0}
+};
+
+static const field_value_t r128_dp_src_datatype_values[] = {
+    {"MONO", 0},
+    {"MONO_TRANS", 1},
+    {"DST_COLOR", 3},
+    {NULL, 0}
+};
+
+static const field_value_t r128_crtc_pix_width_values[] = {
+    {"4BPP", 1},
+    {"8BPP", 2},
+    {"15BPP", 3},
+    {"16BPP", 4},
+    {"24BPP", 5},
+    {"32BPP", 6},
+    {NULL, 0}
+};
+
+static const field_value_t r128_crtc_cur_mode_values[] = {
+    {"64X64_MONO", 0},
+    {NULL, 0}
+};
+
+static const field_value_t r128_pm4_buffer_mode_values[] = {
+    {"NONPM4", 0},
+    {"192PIO", 1},
+    {"192BM", 2},
+    {"128PIO_64INDBM", 3},
+    {"128BM_64INDBM", 4},
+    {"64PIO_128INDBM", 5},
+    {"64BM_128INDBM", 6},
+    {"64PIO_64VCBM_64INDBM", 7},
+    {"64BM_64VCBM_64INDBM", 8},
+    {"64PIO_64VCPIO_64INDPIO", 15},
+    {NULL, 0}
+};
+
+static const field_value_t r128_me_stat_values[] = {
+    {"IDLE", 16383},
+    {NULL, 0}
+};
+
+static const field_value_t r128_me_stat_mux_values[] = {
+    {"PKT_DWORDS_REMAIN", 0},
+    {"PKT_CURR_REGISTER", 1},
+    {NULL, 0}
+};
+
+// ============================================================================
+// Field Tables (for REPL display)
+// ============================================================================
+
+static const field_entry_t r128_bus_cntl_fields[] = {
+    {"BUS_MASTER_DIS", 6, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_src_pitch_offset_fields[] = {
+    {"SRC_OFFSET", 0, 21, 0, NULL},
+    {"SRC_PITCH", 21, 10, 0, NULL},
+    {"SRC_TILE", 31, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_dp_gui_master_cntl_fields[] = {
+    {"GMC_SRC_PITCH_OFFSET_CNTL", 0, 1, 0, NULL},
+    {"GMC_DST_PITCH_OFFSET_CNTL", 1, 1, 0, NULL},
+    {"GMC_SRC_CLIPPING", 2, 1, 0, NULL},
+    {"GMC_DST_CLIPPING", 3, 1, 0, NULL},
+    {"GMC_BRUSH_DATATYPE", 4, 4, 0, r128_gmc_brush_datatype_values},
+    {"GMC_DST_DATATYPE", 8, 4, 0, r128_gmc_dst_datatype_values},
+    {"GMC_SRC_DATATYPE", 12, 2, 0, r128_gmc_src_datatype_values},
+    {"GMC_BYTE_PIX_ORDER", 14, 1, 0, NULL},
+    {"GMC_CONVERSION_TEMP", 15, 1, 0, NULL},
+    {"GMC_ROP3", 16, 8, 0, r128_gmc_rop3_values},
+    {"GMC_SRC_SOURCE", 24, 3, 0, r128_gmc_src_source_values},
+    {"GMC_3D_FCN_EN", 27, 1, 0, NULL},
+    {"GMC_CLR_CMP_CNTL_DIS", 28, 1, 0, NULL},
+    {"GMC_AUX_CLIP_DIS", 29, 1, 0, NULL},
+    {"GMC_WR_MSK_DIS", 30, 1, 0, NULL},
+    {"GMC_LD_BRUSH_Y_X", 31, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_dp_datatype_fields[] = {
+    {"DP_DST_DATATYPE", 0, 4, 0, r128_dp_dst_datatype_values},
+    {"DP_BRUSH_DATATYPE", 8, 4, 0, r128_dp_brush_datatype_values},
+    {"DP_SRC_DATATYPE", 16, 2, 0, r128_dp_src_datatype_values},
+    {"HOST_BIG_ENDIAN_EN", 29, 1, 0, NULL},
+    {"DP_BYTE_PIX_ORDER", 30, 1, 0, NULL},
+    {"DP_CONVERSION_TEMP", 31, 1, 0, NULL},
+    {"(reserved)", 4, 4, 0, NULL},
+    {"(reserved)", 12, 4, 0, NULL},
+    {"(reserved)", 18, 11, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_default_offset_fields[] = {
+    {"DEFAULT_OFFSET", 0, 26, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_default_pitch_fields[] = {
+    {"DEFAULT_PITCH", 0, 10, 0, NULL},
+    {"DEFAULT_TILE", 16, 1, 0, NULL},
+    {"(reserved)", 10, 6, 0, NULL},
+    {"(reserved)", 17, 15, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_crtc_gen_cntl_fields[] = {
+    {"CRTC_DBL_SCAN_EN", 0, 1, 0, NULL},
+    {"CRTC_INTERLACE_EN", 1, 1, 0, NULL},
+    {"CRTC_C_SYNC_EN", 4, 1, 0, NULL},
+    {"CRTC_PIX_WIDTH", 8, 3, 0, r128_crtc_pix_width_values},
+    {"CRTC_CUR_EN", 16, 1, 0, NULL},
+    {"CRTC_CUR_MODE", 17, 3, 0, r128_crtc_cur_mode_values},
+    {"CRTC_EXT_DISP_EN", 24, 1, 0, NULL},
+    {"CRTC_EN", 25, 1, 0, NULL},
+    {"CRTC_DISP_REQ_EN_B", 26, 1, 0, NULL},
+    {"(reserved)", 2, 2, 0, NULL},
+    {"(reserved)", 5, 3, 0, NULL},
+    {"(reserved)", 11, 5, 0, NULL},
+    {"(reserved)", 20, 4, 0, NULL},
+    {"(reserved)", 27, 5, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_crtc_pitch_fields[] = {
+    {"CRTC_PITCH", 0, 10, 0, NULL},
+    {"(reserved)", 10, 22, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_pm4_buffer_cntl_fields[] = {
+    {"PM4_BUFFER_SIZE_L2QW", 0, 27, 0, NULL},
+    {"PM4_BUFFER_CNTL_NOUPDATE", 27, 1, 0, NULL},
+    {"PM4_BUFFER_MODE", 28, 4, 0, r128_pm4_buffer_mode_values},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_pm4_buffer_wm_cntl_fields[] = {
+    {"WMA", 0, 8, 0, NULL},
+    {"WMB", 8, 8, 0, NULL},
+    {"WMC", 16, 8, 0, NULL},
+    {"WB_WM", 24, 8, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_pm4_micro_cntl_fields[] = {
+    {"ME_STAT", 0, 16, 0, r128_me_stat_values},
+    {"ME_STAT_MUX", 16, 5, 0, r128_me_stat_mux_values},
+    {"PM4_MICRO_FREERUN", 30, 1, 0, NULL},
+    {"ME_STEP", 31, 1, 0, NULL},
+    {"(unknown)", 21, 9, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_pm4_microcode_addr_fields[] = {
+    {"PM4_MICROCODE_ADDR", 0, 8, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_pm4_stat_fields[] = {
+    {"PM4_FIFOCNT", 0, 12, 0, NULL},
+    {"PM4_BUSY", 16, 1, 0, NULL},
+    {"MICRO_BUSY", 17, 1, 0, NULL},
+    {"FPU_BUSY", 18, 1, 0, NULL},
+    {"VC_BUSY", 19, 1, 0, NULL},
+    {"IDCT_BUSY", 20, 1, 0, NULL},
+    {"ENG_EV_BUSY", 21, 1, 0, NULL},
+    {"SETUP_BUSY", 22, 1, 0, NULL},
+    {"EDGEWALK_BUSY", 23, 1, 0, NULL},
+    {"ADDRESSING_BUSY", 24, 1, 0, NULL},
+    {"ENG_3D_BUSY", 25, 1, 0, NULL},
+    {"ENG_2D_SM_BUSY", 26, 1, 0, NULL},
+    {"ENG_2D_BUSY", 27, 1, 0, NULL},
+    {"GUI_WB_BUSY", 28, 1, 0, NULL},
+    {"CACHE_BUSY", 29, 1, 0, NULL},
+    {"PM4_GUI_ACTIVE", 31, 1, 0, NULL},
+    {"(reserved)", 12, 4, 0, NULL},
+    {"(reserved)", 30, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_gui_stat_fields[] = {
+    {"GUI_FIFO_CNT", 0, 12, 0, NULL},
+    {"PM4_BUSY", 16, 1, 0, NULL},
+    {"MICRO_BUSY", 17, 1, 0, NULL},
+    {"FPU_BUSY", 18, 1, 0, NULL},
+    {"VC_BUSY", 19, 1, 0, NULL},
+    {"IDCT_BUSY", 20, 1, 0, NULL},
+    {"ENG_EV_BUSY", 21, 1, 0, NULL},
+    {"SETUP_BUSY", 22, 1, 0, NULL},
+    {"EDGEWALK_BUSY", 23, 1, 0, NULL},
+    {"ADDRESSING_BUSY", 24, 1, 0, NULL},
+    {"ENG_3D_BUSY", 25, 1, 0, NULL},
+    {"ENG_2D_SM_BUSY", 26, 1, 0, NULL},
+    {"ENG_2D_BUSY", 27, 1, 0, NULL},
+    {"GUI_WB_BUSY", 28, 1, 0, NULL},
+    {"CACHE_BUSY", 29, 1, 0, NULL},
+    {"GUI_ACTIVE", 31, 1, 0, NULL},
+    {"(reserved)", 12, 4, 0, NULL},
+    {"(reserved)", 30, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_gen_reset_cntl_fields[] = {
+    {"SOFT_RESET_GUI", 0, 1, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+static const field_entry_t r128_pc_ngui_ctlstat_fields[] = {
+    {"PC_FLUSH_GUI", 0, 2, 0, NULL},
+    {"PC_RI_GUI", 2, 2, 0, NULL},
+    {"PC_FLUSH_NONGUI", 4, 2, 0, NULL},
+    {"PC_RI_NONGUI", 6, 2, 0, NULL},
+    {"PC_PURGE_GUI", 8, 1, 0, NULL},
+    {"PC_PURGE_NONGUI", 9, 1, 0, NULL},
+    {"PC_DIRTY", 24, 1, 0, NULL},
+    {"PC_PURGE_DOPURGE", 25, 1, 0, NULL},
+    {"PC_FLUSH_DOFLUSH", 26, 1, 0, NULL},
+    {"PC_BUSY_INIT", 27, 1, 0, NULL},
+    {"PC_BUSY_FLUSH", 28, 1, 0, NULL},
+    {"PC_BUSY_GUI", 29, 1, 0, NULL},
+    {"PC_BUSY_NGUI", 30, 1, 0, NULL},
+    {"PC_BUSY", 31, 1, 0, NULL},
+    {"(reserved)", 10, 14, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+// ============================================================================
+// Alias Tables (for REPL display)
+// ============================================================================
+
+static const field_entry_t r128_pc_ngui_ctlstat_aliases[] = {
+    {"PC_FLUSH_ALL", 0, 8, 0, NULL},
+    {NULL, 0, 0, 0, NULL}
+};
+
+// ============================================================================
+// Register Offsets
+// ============================================================================
+
+enum {
+    R128_BUS_CNTL = 0x30,
+    R128_PCI_GART_PAGE = 0x17c,
+    R128_DDA_CONFIG = 0x2e0,
+    R128_DDA_ON_OFF = 0x2e4,
+    R128_SRC_PITCH_OFFSET = 0x1428,
+    R128_DP_GUI_MASTER_CNTL = 0x146c,
+    R128_DP_DATATYPE = 0x16c4,
+    R128_DEFAULT_OFFSET = 0x16e0,
+    R128_DEFAULT_PITCH = 0x16e4,
+    R128_CRTC_GEN_CNTL = 0x50,
+    R128_CRTC_PITCH = 0x22c,
+    R128_PM4_BUFFER_OFFSET = 0x700,
+    R128_PM4_BUFFER_CNTL = 0x704,
+    R128_PM4_BUFFER_WM_CNTL = 0x708,
+    R128_PM4_BUFFER_DL_RPTR_ADDR = 0x70c,
+    R128_PM4_BUFFER_DL_RPTR = 0x710,
+    R128_PM4_BUFFER_DL_WPTR = 0x714,
+    R128_PM4_BUFFER_DL_WPTR_DELAY = 0x718,
+    R128_PM4_BUFFER_ADDR = 0x7f0,
+    R128_PM4_MICRO_CNTL = 0x7fc,
+    R128_PM4_FIFO_DATA_EVEN = 0x1000,
+    R128_PM4_FIFO_DATA_ODD = 0x1004,
+    R128_PM4_MICROCODE_ADDR = 0x7d4,
+    R128_PM4_MICROCODE_RADDR = 0x7d8,
+    R128_PM4_MICROCODE_DATAH = 0x7dc,
+    R128_PM4_MICROCODE_DATAL = 0x7e0,
+    R128_PM4_STAT = 0x7b8,
+    R128_GUI_STAT = 0x1740,
+    R128_GEN_RESET_CNTL = 0xf0,
+    R128_PC_NGUI_CTLSTAT = 0x184,
+    R128_SCALE_3D_CNTL = 0x1a00,
+    R128_VIPH_CONTROL = 0x1d0,
+};
+
+// ============================================================================
+// R128_REGISTERS X-macro
+// Used to generate read/write functions, register tables, etc.
+// X(func_name, const_name, offset, flags, fields, aliases)
+// ============================================================================
+
+#define R128_REGISTERS \
+  X(r128_bus_cntl, R128_BUS_CNTL, 0x30, 0, r128_bus_cntl_fields, NULL) \
+  X(r128_pci_gart_page, R128_PCI_GART_PAGE, 0x17c, 0, NULL, NULL) \
+  X(r128_dda_config, R128_DDA_CONFIG, 0x2e0, FLAG_SHADOW, NULL, NULL) \
+  X(r128_dda_on_off, R128_DDA_ON_OFF, 0x2e4, FLAG_SHADOW, NULL, NULL) \
+  X(r128_src_pitch_offset, R128_SRC_PITCH_OFFSET, 0x1428, FLAG_NO_READ, r128_src_pitch_offset_fields, NULL) \
+  X(r128_dp_gui_master_cntl, R128_DP_GUI_MASTER_CNTL, 0x146c, 0, r128_dp_gui_master_cntl_fields, NULL) \
+  X(r128_dp_datatype, R128_DP_DATATYPE, 0x16c4, 0, r128_dp_datatype_fields, NULL) \
+  X(r128_default_offset, R128_DEFAULT_OFFSET, 0x16e0, FLAG_SHADOW, r128_default_offset_fields, NULL) \
+  X(r128_default_pitch, R128_DEFAULT_PITCH, 0x16e4, FLAG_SHADOW, r128_default_pitch_fields, NULL) \
+  X(r128_crtc_gen_cntl, R128_CRTC_GEN_CNTL, 0x50, 0, r128_crtc_gen_cntl_fields, NULL) \
+  X(r128_crtc_pitch, R128_CRTC_PITCH, 0x22c, FLAG_SHADOW, r128_crtc_pitch_fields, NULL) \
+  X(r128_pm4_buffer_offset, R128_PM4_BUFFER_OFFSET, 0x700, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r128_pm4_buffer_cntl, R128_PM4_BUFFER_CNTL, 0x704, FLAG_NO_SNAPSHOT, r128_pm4_buffer_cntl_fields, NULL) \
+  X(r128_pm4_buffer_wm_cntl, R128_PM4_BUFFER_WM_CNTL, 0x708, FLAG_NO_SNAPSHOT, r128_pm4_buffer_wm_cntl_fields, NULL) \
+  X(r128_pm4_buffer_dl_rptr_addr, R128_PM4_BUFFER_DL_RPTR_ADDR, 0x70c, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r128_pm4_buffer_dl_rptr, R128_PM4_BUFFER_DL_RPTR, 0x710, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r128_pm4_buffer_dl_wptr, R128_PM4_BUFFER_DL_WPTR, 0x714, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r128_pm4_buffer_dl_wptr_delay, R128_PM4_BUFFER_DL_WPTR_DELAY, 0x718, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r128_pm4_buffer_addr, R128_PM4_BUFFER_ADDR, 0x7f0, FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r128_pm4_micro_cntl, R128_PM4_MICRO_CNTL, 0x7fc, FLAG_NO_SNAPSHOT, r128_pm4_micro_cntl_fields, NULL) \
+  X(r128_pm4_fifo_data_even, R128_PM4_FIFO_DATA_EVEN, 0x1000, FLAG_NO_READ | FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r128_pm4_fifo_data_odd, R128_PM4_FIFO_DATA_ODD, 0x1004, FLAG_NO_READ | FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r128_pm4_microcode_addr, R128_PM4_MICROCODE_ADDR, 0x7d4, FLAG_NO_SNAPSHOT, r128_pm4_microcode_addr_fields, NULL) \
+  X(r128_pm4_microcode_raddr, R128_PM4_MICROCODE_RADDR, 0x7d8, FLAG_NO_READ | FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r128_pm4_microcode_datah, R128_PM4_MICROCODE_DATAH, 0x7dc, FLAG_INDIRECT | FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r128_pm4_microcode_datal, R128_PM4_MICROCODE_DATAL, 0x7e0, FLAG_READ_SIDE_EFFECTS | FLAG_INDIRECT | FLAG_NO_SNAPSHOT, NULL, NULL) \
+  X(r128_pm4_stat, R128_PM4_STAT, 0x7b8, FLAG_NO_WRITE, r128_pm4_stat_fields, NULL) \
+  X(r128_gui_stat, R128_GUI_STAT, 0x1740, FLAG_NO_WRITE, r128_gui_stat_fields, NULL) \
+  X(r128_gen_reset_cntl, R128_GEN_RESET_CNTL, 0xf0, FLAG_NO_SNAPSHOT, r128_gen_reset_cntl_fields, NULL) \
+  X(r128_pc_ngui_ctlstat, R128_PC_NGUI_CTLSTAT, 0x184, FLAG_NO_SNAPSHOT, r128_pc_ngui_ctlstat_fields, r128_pc_ngui_ctlstat_aliases) \
+  X(r128_scale_3d_cntl, R128_SCALE_3D_CNTL, 0x1a00, FLAG_SHADOW, NULL, NULL) \
+  X(r128_viph_control, R128_VIPH_CONTROL, 0x1d0, 0, NULL, NULL)
+
+// ============================================================================
+// Register Accessors
+// ============================================================================
+
+#ifdef ATI_REG_ACCESSORS
+static inline uint32_t rd_r128_bus_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_BUS_CNTL, "r128_bus_cntl"); }
+static inline void wr_r128_bus_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_BUS_CNTL, val, "r128_bus_cntl"); }
+static inline uint32_t rd_r128_pci_gart_page(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PCI_GART_PAGE, "r128_pci_gart_page"); }
+static inline void wr_r128_pci_gart_page(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PCI_GART_PAGE, val, "r128_pci_gart_page"); }
+static inline uint32_t rd_r128_dda_config(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_DDA_CONFIG, "r128_dda_config"); }
+static inline void wr_r128_dda_config(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_DDA_CONFIG, val, "r128_dda_config"); }
+static inline uint32_t rd_r128_dda_on_off(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_DDA_ON_OFF, "r128_dda_on_off"); }
+static inline void wr_r128_dda_on_off(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_DDA_ON_OFF, val, "r128_dda_on_off"); }
+static inline uint32_t rd_r128_src_pitch_offset(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_SRC_PITCH_OFFSET, "r128_src_pitch_offset"); }
+static inline void wr_r128_src_pitch_offset(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_SRC_PITCH_OFFSET, val, "r128_src_pitch_offset"); }
+static inline uint32_t rd_r128_dp_gui_master_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_DP_GUI_MASTER_CNTL, "r128_dp_gui_master_cntl"); }
+static inline void wr_r128_dp_gui_master_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_DP_GUI_MASTER_CNTL, val, "r128_dp_gui_master_cntl"); }
+static inline uint32_t rd_r128_dp_datatype(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_DP_DATATYPE, "r128_dp_datatype"); }
+static inline void wr_r128_dp_datatype(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_DP_DATATYPE, val, "r128_dp_datatype"); }
+static inline uint32_t rd_r128_default_offset(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_DEFAULT_OFFSET, "r128_default_offset"); }
+static inline void wr_r128_default_offset(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_DEFAULT_OFFSET, val, "r128_default_offset"); }
+static inline uint32_t rd_r128_default_pitch(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_DEFAULT_PITCH, "r128_default_pitch"); }
+static inline void wr_r128_default_pitch(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_DEFAULT_PITCH, val, "r128_default_pitch"); }
+static inline uint32_t rd_r128_crtc_gen_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_CRTC_GEN_CNTL, "r128_crtc_gen_cntl"); }
+static inline void wr_r128_crtc_gen_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_CRTC_GEN_CNTL, val, "r128_crtc_gen_cntl"); }
+static inline uint32_t rd_r128_crtc_pitch(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_CRTC_PITCH, "r128_crtc_pitch"); }
+static inline void wr_r128_crtc_pitch(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_CRTC_PITCH, val, "r128_crtc_pitch"); }
+static inline uint32_t rd_r128_pm4_buffer_offset(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_BUFFER_OFFSET, "r128_pm4_buffer_offset"); }
+static inline void wr_r128_pm4_buffer_offset(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_BUFFER_OFFSET, val, "r128_pm4_buffer_offset"); }
+static inline uint32_t rd_r128_pm4_buffer_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_BUFFER_CNTL, "r128_pm4_buffer_cntl"); }
+static inline void wr_r128_pm4_buffer_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_BUFFER_CNTL, val, "r128_pm4_buffer_cntl"); }
+static inline uint32_t rd_r128_pm4_buffer_wm_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_BUFFER_WM_CNTL, "r128_pm4_buffer_wm_cntl"); }
+static inline void wr_r128_pm4_buffer_wm_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_BUFFER_WM_CNTL, val, "r128_pm4_buffer_wm_cntl"); }
+static inline uint32_t rd_r128_pm4_buffer_dl_rptr_addr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_BUFFER_DL_RPTR_ADDR, "r128_pm4_buffer_dl_rptr_addr"); }
+static inline void wr_r128_pm4_buffer_dl_rptr_addr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_BUFFER_DL_RPTR_ADDR, val, "r128_pm4_buffer_dl_rptr_addr"); }
+static inline uint32_t rd_r128_pm4_buffer_dl_rptr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_BUFFER_DL_RPTR, "r128_pm4_buffer_dl_rptr"); }
+static inline void wr_r128_pm4_buffer_dl_rptr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_BUFFER_DL_RPTR, val, "r128_pm4_buffer_dl_rptr"); }
+static inline uint32_t rd_r128_pm4_buffer_dl_wptr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_BUFFER_DL_WPTR, "r128_pm4_buffer_dl_wptr"); }
+static inline void wr_r128_pm4_buffer_dl_wptr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_BUFFER_DL_WPTR, val, "r128_pm4_buffer_dl_wptr"); }
+static inline uint32_t rd_r128_pm4_buffer_dl_wptr_delay(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_BUFFER_DL_WPTR_DELAY, "r128_pm4_buffer_dl_wptr_delay"); }
+static inline void wr_r128_pm4_buffer_dl_wptr_delay(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_BUFFER_DL_WPTR_DELAY, val, "r128_pm4_buffer_dl_wptr_delay"); }
+static inline uint32_t rd_r128_pm4_buffer_addr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_BUFFER_ADDR, "r128_pm4_buffer_addr"); }
+static inline void wr_r128_pm4_buffer_addr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_BUFFER_ADDR, val, "r128_pm4_buffer_addr"); }
+static inline uint32_t rd_r128_pm4_micro_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_MICRO_CNTL, "r128_pm4_micro_cntl"); }
+static inline void wr_r128_pm4_micro_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_MICRO_CNTL, val, "r128_pm4_micro_cntl"); }
+static inline uint32_t rd_r128_pm4_fifo_data_even(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_FIFO_DATA_EVEN, "r128_pm4_fifo_data_even"); }
+static inline void wr_r128_pm4_fifo_data_even(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_FIFO_DATA_EVEN, val, "r128_pm4_fifo_data_even"); }
+static inline uint32_t rd_r128_pm4_fifo_data_odd(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_FIFO_DATA_ODD, "r128_pm4_fifo_data_odd"); }
+static inline void wr_r128_pm4_fifo_data_odd(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_FIFO_DATA_ODD, val, "r128_pm4_fifo_data_odd"); }
+static inline uint32_t rd_r128_pm4_microcode_addr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_MICROCODE_ADDR, "r128_pm4_microcode_addr"); }
+static inline void wr_r128_pm4_microcode_addr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_MICROCODE_ADDR, val, "r128_pm4_microcode_addr"); }
+static inline uint32_t rd_r128_pm4_microcode_raddr(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_MICROCODE_RADDR, "r128_pm4_microcode_raddr"); }
+static inline void wr_r128_pm4_microcode_raddr(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_MICROCODE_RADDR, val, "r128_pm4_microcode_raddr"); }
+static inline uint32_t rd_r128_pm4_microcode_datah(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_MICROCODE_DATAH, "r128_pm4_microcode_datah"); }
+static inline void wr_r128_pm4_microcode_datah(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_MICROCODE_DATAH, val, "r128_pm4_microcode_datah"); }
+static inline uint32_t rd_r128_pm4_microcode_datal(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_MICROCODE_DATAL, "r128_pm4_microcode_datal"); }
+static inline void wr_r128_pm4_microcode_datal(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_MICROCODE_DATAL, val, "r128_pm4_microcode_datal"); }
+static inline uint32_t rd_r128_pm4_stat(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PM4_STAT, "r128_pm4_stat"); }
+static inline void wr_r128_pm4_stat(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PM4_STAT, val, "r128_pm4_stat"); }
+static inline uint32_t rd_r128_gui_stat(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_GUI_STAT, "r128_gui_stat"); }
+static inline void wr_r128_gui_stat(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_GUI_STAT, val, "r128_gui_stat"); }
+static inline uint32_t rd_r128_gen_reset_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_GEN_RESET_CNTL, "r128_gen_reset_cntl"); }
+static inline void wr_r128_gen_reset_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_GEN_RESET_CNTL, val, "r128_gen_reset_cntl"); }
+static inline uint32_t rd_r128_pc_ngui_ctlstat(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_PC_NGUI_CTLSTAT, "r128_pc_ngui_ctlstat"); }
+static inline void wr_r128_pc_ngui_ctlstat(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_PC_NGUI_CTLSTAT, val, "r128_pc_ngui_ctlstat"); }
+static inline uint32_t rd_r128_scale_3d_cntl(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_SCALE_3D_CNTL, "r128_scale_3d_cntl"); }
+static inline void wr_r128_scale_3d_cntl(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_SCALE_3D_CNTL, val, "r128_scale_3d_cntl"); }
+static inline uint32_t rd_r128_viph_control(ati_device_t *dev) { return ati_chip_reg_read(dev, CHIP_R128, R128_VIPH_CONTROL, "r128_viph_control"); }
+static inline void wr_r128_viph_control(ati_device_t *dev, uint32_t val) { ati_chip_reg_write(dev, CHIP_R128, R128_VIPH_CONTROL, val, "r128_viph_control"); }
+#endif // ATI_REG_ACCESSORS
+
+#endif // R128_REGS_GEN_H
\ No newline at end of file
@@ -0,0 +1,207 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "snapshot.h"
+
+// Registers whose value can't be captured or replayed as-is
+#define SNAPSHOT_SKIP                                                          \
+    (FLAG_NO_WRITE | FLAG_READ_SIDE_EFFECTS | FLAG_INDIRECT | FLAG_NO_SNAPSHOT)
+
+// Pairs and VRAM dwords handled per pass during a restore
+#define RESTORE_BATCH 64
+
+static inline bool
+bit_test(const uint32_t *bits, uint32_t offset)
+{
+    return bits[offset / 128] & (1u << ((offset / 4) & 31));
+}
+
+static inline void
+bit_set(uint32_t *bits, uint32_t offset)
+{
+    bits[offset / 128] |= 1u << ((offset / 4) & 31);
+}
+
+static void
+note_register(ati_snapshot_t *snap, uint32_t offset, uint32_t flags)
+{
+    if ((flags & SNAPSHOT_SKIP) || offset >= REG_APERTURE_SIZE)
+        return;
+    if (flags & FLAG_NO_READ)
+        bit_set(snap->writeonly, offset);
+    else
+        bit_set(snap->saved, offset);
+}
+
+static void
+build_map(ati_snapshot_t *snap)
+{
+#define X(func_name, const_name, offset, flags, fields, aliases)               \
+    note_register(snap, offset, flags);
+    COMMON_REGISTERS
+    if (snap->family == CHIP_R128) {
+        R128_REGISTERS
+    } else if (snap->family == CHIP_R100) {
+        R100_REGISTERS
+    }
+#undef X
+}
+
+bool
+ati_snapshot_capture(ati_device_t *dev, ati_snapshot_t *snap,
+                     const ati_vram_range_t *ranges, size_t count)
+{
+    memset(snap->saved, 0, sizeof(snap->saved));
+    memset(snap->writeonly, 0, sizeof(snap->writeonly));
+    memset(snap->recorded, 0, sizeof(snap->recorded));
+    snap->family = CHIP_UNKNOWN;
+    snap->range_count = 0;
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++)
+        total += ranges[i].size;
+    if (count > ATI_SNAPSHOT_MAX_RANGES || total > ATI_SNAPSHOT_VRAM_BYTES)
+        return false;
+
+    snap->family = ati_get_chip_family(dev);
+    build_map(snap);
+
+    for (uint32_t offset = 0; offset < REG_APERTURE_SIZE; offset += 4) {
+        if (bit_test(snap->saved, offset))
+            snap->regs[offset / 4] = ati_reg_read(dev, offset);
+    }
+
+    uint32_t *vram = snap->vram;
+    for (size_t i = 0; i < count; i++) {
+        snap->ranges[i] = ranges[i];
+        ati_vram_readback(dev, ranges[i].offset, vram, ranges[i].size);
+        vram += ranges[i].size / 4;
+    }
+    snap->range_count = count;
+    return true;
+}
+
+bool
+ati_snapshot_valid(const ati_snapshot_t *snap)
+{
+    return snap->family != CHIP_UNKNOWN;
+}
+
+void
+ati_snapshot_record(ati_snapshot_t *snap, uint32_t offset, uint32_t value)
+{
+    if (offset >= REG_APERTURE_SIZE || !bit_test(snap->writeonly, offset))
+        return;
+    snap->regs[offset / 4] = value;
+    bit_set(snap->recorded, offset);
+}
+
+// Turned back on after everything else, so the GART and bus mastering only
+// come up once the page table and memory controller setup they use is back
+// in place. Offsets only a family's snapshot has are skipped on the other.
+static const uint32_t restore_last[] = {
+    R100_AIC_CTRL,
+    R128_BUS_CNTL, // Same offset as R100_BUS_CNTL
+};
+#define RESTORE_LAST (sizeof(restore_last) / sizeof(restore_last[0]))
+
+static bool
+restore_late(uint32_t offset)
+{
+    for (size_t i = 0; i < RESTORE_LAST; i++) {
+        if (offset == restore_last[i])
+            return true;
+    }
+    return false;
+}
+
+typedef struct {
+    ati_reg_pair_t pairs[RESTORE_BATCH];
+    size_t n;
+} restore_batch_t;
+
+static void
+restore_flush(ati_device_t *dev, restore_batch_t *batch,
+              ati_snapshot_stats_t *stats)
+{
+    ati_reg_write_batch(dev, batch->pairs, batch->n);
+    stats->regs_written += batch->n;
+    batch->n = 0;
+}
+
+static void
+restore_reg(ati_device_t *dev, const ati_snapshot_t *snap, uint32_t offset,
+            restore_batch_t *batch, ati_snapshot_stats_t *stats)
+{
+    uint32_t value = snap->regs[offset / 4];
+    if (bit_test(snap->saved, offset)) {
+        stats->regs_checked++;
+        if (ati_reg_read(dev, offset) == value)
+            return;
+    } else if (!bit_test(snap->recorded, offset)) {
+        return;
+    }
+
+    batch->pairs[batch->n].offset = offset;
+    batch->pairs[batch->n].value = value;
+    if (++batch->n == RESTORE_BATCH)
+        restore_flush(dev, batch, stats);
+}
+
+static void
+restore_regs(ati_device_t *dev, const ati_snapshot_t *snap,
+             ati_snapshot_stats_t *stats)
+{
+    restore_batch_t batch = {.n = 0};
+
+    for (uint32_t offset = 0; offset < REG_APERTURE_SIZE; offset += 4) {
+        if (!restore_late(offset))
+            restore_reg(dev, snap, offset, &batch, stats);
+    }
+    for (size_t i = 0; i < RESTORE_LAST; i++)
+        restore_reg(dev, snap, restore_last[i], &batch, stats);
+    restore_flush(dev, &batch, stats);
+}
+
+static void
+restore_vram(ati_device_t *dev, const ati_snapshot_t *snap,
+             ati_snapshot_stats_t *stats)
+{
+    uint32_t live[RESTORE_BATCH];
+    const uint32_t *saved = snap->vram;
+
+    for (size_t r = 0; r < snap->range_count; r++) {
+        uint32_t base = snap->ranges[r].offset;
+        uint32_t dwords = snap->ranges[r].size / 4;
+
+        for (uint32_t i = 0; i < dwords; i += RESTORE_BATCH) {
+            uint32_t len = dwords - i < RESTORE_BATCH ? dwords - i
+                                                      : RESTORE_BATCH;
+            ati_vram_readback(dev, base + i * 4, live, len * 4);
+            for (uint32_t j = 0; j < len; j++) {
+                if (live[j] != saved[i + j]) {
+                    ati_vram_write(dev, base + (i + j) * 4, saved[i + j]);
+                    stats->vram_written++;
+                }
+            }
+            stats->vram_checked += len;
+        }
+        saved += dwords;
+    }
+}
+
+void
+ati_snapshot_restore(ati_device_t *dev, const ati_snapshot_t *snap,
+                     ati_snapshot_stats_t *stats)
+{
+    ati_snapshot_stats_t local;
+    if (!stats)
+        stats = &local;
+    memset(stats, 0, sizeof(*stats));
+
+    if (!ati_snapshot_valid(snap) || snap->family != ati_get_chip_family(dev))
+        return;
+
+    // Compare against the hardware, not what the shadow cache last saw
+    ati_shadow_invalidate(dev);
+    restore_regs(dev, snap, stats);
+    restore_vram(dev, snap, stats);
+}
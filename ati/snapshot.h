@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "ati.h"
+
+/* Register and VRAM state snapshots.
+ *
+ * A snapshot holds every register the YAML lets us replay: readable,
+ * writable, no read side effects, not indirect and not flagged
+ * no_snapshot (directly or through its group). Write-only registers can't
+ * be read back, so their values are recorded from the writes the host makes
+ * while a recording is open (see ati_snapshot_record). Selected VRAM ranges
+ * can be kept alongside.
+ *
+ * Restoring reads the live state back and only writes what differs, so
+ * restoring an untouched device costs register reads and no writes.
+ * Recorded write-only registers are always written. The PCI GART and bus
+ * master enables go last, after the page table and memory controller
+ * registers they depend on.
+ */
+
+#define ATI_SNAPSHOT_MAX_RANGES 4
+#define ATI_SNAPSHOT_VRAM_BYTES (64 * 1024)
+#define ATI_SNAPSHOT_WORDS (REG_APERTURE_SIZE / 4 / 32)
+
+typedef struct {
+    uint32_t offset;
+    uint32_t size; // Bytes, a multiple of 4
+} ati_vram_range_t;
+
+typedef struct {
+    ati_chip_family_t family; // CHIP_UNKNOWN until captured
+    uint32_t saved[ATI_SNAPSHOT_WORDS];     // Read back at capture
+    uint32_t writeonly[ATI_SNAPSHOT_WORDS]; // Recordable write-only registers
+    uint32_t recorded[ATI_SNAPSHOT_WORDS];  // Write-only with a recorded value
+    uint32_t regs[REG_APERTURE_SIZE / 4];
+    ati_vram_range_t ranges[ATI_SNAPSHOT_MAX_RANGES];
+    size_t range_count;
+    uint32_t vram[ATI_SNAPSHOT_VRAM_BYTES / 4];
+} ati_snapshot_t;
+
+typedef struct {
+    uint32_t regs_checked;
+    uint32_t regs_written; // Includes the recorded write-only registers
+    uint32_t vram_checked; // Dwords
+    uint32_t vram_written;
+} ati_snapshot_stats_t;
+
+// Capture the registers and VRAM ranges. Fails, leaving the snapshot
+// empty, if the ranges don't fit.
+bool ati_snapshot_capture(ati_device_t *dev, ati_snapshot_t *snap,
+                          const ati_vram_range_t *ranges, size_t count);
+bool ati_snapshot_valid(const ati_snapshot_t *snap);
+// Note a register write. Only write-only registers of a captured snapshot
+// are kept; anything else is ignored.
+void ati_snapshot_record(ati_snapshot_t *snap, uint32_t offset,
+                         uint32_t value);
+// Write back whatever differs. The engine should be idle and the CCE off.
+// stats may be NULL.
+void ati_snapshot_restore(ati_device_t *dev, const ati_snapshot_t *snap,
+                          ati_snapshot_stats_t *stats);
+
+// Each device keeps a baseline for ati_reset_for_test, captured once the
+// mode is set and the engine is up. Recapture after changing the mode.
+// The baseline is registers only. VRAM is out of scope, so restoring it
+// clears the visible framebuffer to black instead; offscreen VRAM is left
+// as the last test had it.
+void ati_capture_test_state(ati_device_t *dev);
+void ati_restore_test_state(ati_device_t *dev, ati_snapshot_stats_t *stats);
+
+#endif
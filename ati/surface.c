@@ -0,0 +1,128 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "surface.h"
+
+static inline uint32_t
+align_up(uint32_t value, uint32_t align)
+{
+    return (value + align - 1) & ~(align - 1);
+}
+
+void
+ati_vram_heap_reset(ati_device_t *dev)
+{
+    ati_vram_heap_t *heap = ati_device_heap(dev);
+    const ati_display_mode_t *mode = ati_get_display_mode(dev);
+    const ati_device_props_t *props = ati_device_props(dev);
+
+    uint32_t end = props->vram_size;
+    if (end == 0 || end > props->vram_aperture)
+        end = props->vram_aperture;
+
+    heap->start = align_up(mode->pitch * mode->height, ATI_SURFACE_ALIGN);
+    heap->end = end & ~(ATI_SURFACE_ALIGN - 1);
+    if (heap->start > heap->end)
+        heap->start = heap->end;
+    heap->count = 0;
+}
+
+uint32_t
+ati_vram_alloc(ati_device_t *dev, uint32_t size, uint32_t align)
+{
+    ati_vram_heap_t *heap = ati_device_heap(dev);
+
+    if (size == 0 || heap->count == ATI_VRAM_HEAP_BLOCKS)
+        return ATI_VRAM_NONE;
+
+    // Try the gap before each block, then the one after the last
+    uint32_t prev_end = heap->start;
+    for (size_t i = 0; i <= heap->count; i++) {
+        uint32_t next = i < heap->count ? heap->used[i].offset : heap->end;
+        uint32_t offset = align_up(prev_end, align);
+        if (offset >= prev_end && offset <= next && next - offset >= size) {
+            for (size_t j = heap->count; j > i; j--)
+                heap->used[j] = heap->used[j - 1];
+            heap->used[i] = (ati_vram_block_t) {offset, size};
+            heap->count++;
+            return offset;
+        }
+        if (i < heap->count)
+            prev_end = heap->used[i].offset + heap->used[i].size;
+    }
+    return ATI_VRAM_NONE;
+}
+
+void
+ati_vram_free(ati_device_t *dev, uint32_t offset)
+{
+    ati_vram_heap_t *heap = ati_device_heap(dev);
+
+    for (size_t i = 0; i < heap->count; i++) {
+        if (heap->used[i].offset != offset)
+            continue;
+        heap->count--;
+        for (; i < heap->count; i++)
+            heap->used[i] = heap->used[i + 1];
+        return;
+    }
+    printf("VRAM free of unallocated offset 0x%x\n", offset);
+}
+
+void
+ati_vram_heap_usage(ati_device_t *dev, uint32_t *free_bytes,
+                    uint32_t *largest)
+{
+    ati_vram_heap_t *heap = ati_device_heap(dev);
+    uint32_t prev_end = heap->start;
+
+    *free_bytes = 0;
+    *largest = 0;
+    for (size_t i = 0; i <= heap->count; i++) {
+        uint32_t next = i < heap->count ? heap->used[i].offset : heap->end;
+        uint32_t gap = next - prev_end;
+        *free_bytes += gap;
+        if (gap > *largest)
+            *largest = gap;
+        if (i < heap->count)
+            prev_end = heap->used[i].offset + heap->used[i].size;
+    }
+}
+
+bool
+ati_surface_alloc(ati_device_t *dev, ati_surface_t *surf, uint32_t width,
+                  uint32_t height, uint32_t bpp)
+{
+    uint32_t pitch = align_up(width * (bpp / 8), ATI_SURFACE_PITCH_ALIGN);
+    uint32_t offset = ati_vram_alloc(dev, pitch * height, ATI_SURFACE_ALIGN);
+
+    if (offset == ATI_VRAM_NONE) {
+        *surf = (ati_surface_t) {0};
+        return false;
+    }
+    *surf = (ati_surface_t) {offset, pitch, width, height, bpp};
+    return true;
+}
+
+void
+ati_surface_free(ati_device_t *dev, ati_surface_t *surf)
+{
+    if (surf->pitch == 0)
+        return;
+    ati_vram_free(dev, surf->offset);
+    *surf = (ati_surface_t) {0};
+}
+
+void
+ati_surface_upload(ati_device_t *dev, const ati_surface_t *surf,
+                   const void *pixels, size_t pitch)
+{
+    ati_vram_upload_rect(dev, surf->offset, surf->pitch, pixels, pitch,
+                         surf->width * (surf->bpp / 8), surf->height);
+}
+
+void
+ati_surface_readback(ati_device_t *dev, const ati_surface_t *surf,
+                     void *pixels, size_t pitch)
+{
+    ati_vram_readback_rect(dev, surf->offset, surf->pitch, pixels, pitch,
+                           surf->width * (surf->bpp / 8), surf->height);
+}
@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#ifndef SURFACE_H
+#define SURFACE_H
+
+#include "ati.h"
+
+/* Offscreen VRAM heap.
+ *
+ * Each device hands out VRAM between the end of the visible framebuffer and
+ * the end of memory (CONFIG_MEMSIZE, capped at the aperture). Blocks are
+ * kept in offset order and placed first-fit. The heap is emptied whenever
+ * the display mode changes and before every test, so a test owns whatever
+ * it allocates until it finishes.
+ *
+ * Surfaces are allocated with engine-friendly layout: offsets aligned to
+ * ATI_SURFACE_ALIGN and pitches to ATI_SURFACE_PITCH_ALIGN, which both the
+ * R128 and R100 pitch/offset formats accept.
+ */
+
+#define ATI_VRAM_HEAP_BLOCKS 32
+#define ATI_SURFACE_ALIGN 1024
+#define ATI_SURFACE_PITCH_ALIGN 64
+#define ATI_VRAM_NONE UINT32_MAX
+
+typedef struct {
+    uint32_t offset;
+    uint32_t size;
+} ati_vram_block_t;
+
+typedef struct {
+    uint32_t start; // First byte past the visible framebuffer, aligned
+    uint32_t end;
+    ati_vram_block_t used[ATI_VRAM_HEAP_BLOCKS]; // Sorted by offset
+    size_t count;
+} ati_vram_heap_t;
+
+// The device's heap, kept in ati.c alongside the rest of its state
+ati_vram_heap_t *ati_device_heap(ati_device_t *dev);
+
+// Free everything and size the heap for the current mode
+void ati_vram_heap_reset(ati_device_t *dev);
+// Returns ATI_VRAM_NONE when no gap is big enough. align is a power of two.
+uint32_t ati_vram_alloc(ati_device_t *dev, uint32_t size, uint32_t align);
+void ati_vram_free(ati_device_t *dev, uint32_t offset);
+// Bytes not allocated, and the largest single gap
+void ati_vram_heap_usage(ati_device_t *dev, uint32_t *free_bytes,
+                         uint32_t *largest);
+
+// Fails, leaving surf zeroed, if the heap is full
+bool ati_surface_alloc(ati_device_t *dev, ati_surface_t *surf, uint32_t width,
+                       uint32_t height, uint32_t bpp);
+void ati_surface_free(ati_device_t *dev, ati_surface_t *surf);
+// Copy packed or strided pixels in and out. pitch is the system RAM one.
+void ati_surface_upload(ati_device_t *dev, const ati_surface_t *surf,
+                        const void *pixels, size_t pitch);
+void ati_surface_readback(ati_device_t *dev, const ati_surface_t *surf,
+                          void *pixels, size_t pitch);
+
+#endif
@@ -0,0 +1,130 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "trace.h"
+
+#ifdef ATI_MMIO_TRACE
+
+_Static_assert((ATI_TRACE_ENTRIES & (ATI_TRACE_ENTRIES - 1)) == 0,
+               "ATI_TRACE_ENTRIES must be a power of two");
+
+ati_trace_buf_t ati_trace_buf __attribute__((aligned(64)));
+uint32_t ati_trace_head;
+
+static const char *trace_labels[ATI_TRACE_MAX_LABELS];
+static uint32_t trace_label_count;
+static bool trace_label_lock; // Marks can come from several test threads
+static uint64_t trace_start_tsc;
+static uint64_t trace_start_ns;
+
+// Marks name a point in the trace (e.g. a test starting). Labels are
+// interned by pointer, so they must be string literals or otherwise live
+// for the life of the program.
+void
+ati_trace_mark(const char *label)
+{
+    uint32_t idx;
+    while (__atomic_test_and_set(&trace_label_lock, __ATOMIC_ACQUIRE))
+        ;
+    for (idx = 0; idx < trace_label_count; idx++) {
+        if (trace_labels[idx] == label)
+            break;
+    }
+    if (idx == trace_label_count && idx < ATI_TRACE_MAX_LABELS)
+        trace_labels[trace_label_count++] = label;
+    __atomic_clear(&trace_label_lock, __ATOMIC_RELEASE);
+    ati_trace_record(TRACE_MARK, 0, idx);
+}
+
+bool
+ati_trace_enabled(void)
+{
+    return true;
+}
+
+void
+ati_trace_clear(void)
+{
+    __atomic_store_n(&ati_trace_head, 0, __ATOMIC_RELAXED);
+    trace_label_count = 0;
+    trace_start_tsc = __builtin_ia32_rdtsc();
+    trace_start_ns = platform_time_ns();
+}
+
+void
+ati_trace_print_status(void)
+{
+    uint32_t head = __atomic_load_n(&ati_trace_head, __ATOMIC_RELAXED);
+    uint32_t count = head < ATI_TRACE_ENTRIES ? head : ATI_TRACE_ENTRIES;
+    uint32_t ms = (uint32_t) ((platform_time_ns() - trace_start_ns) / 1000000);
+
+    printf("MMIO trace: %u/%u entries, %u dropped, %u labels, %u ms since "
+           "clear\n",
+           count, ATI_TRACE_ENTRIES, head - count, trace_label_count, ms);
+}
+
+bool
+ati_trace_dump(const char *filename)
+{
+    ati_trace_header_t *h = &ati_trace_buf.header;
+    uint32_t head = __atomic_load_n(&ati_trace_head, __ATOMIC_RELAXED);
+    uint32_t count = head < ATI_TRACE_ENTRIES ? head : ATI_TRACE_ENTRIES;
+
+    // Labels are packed as consecutive NUL-terminated strings in index order
+    size_t len = 0;
+    for (uint32_t i = 0; i < trace_label_count; i++) {
+        size_t n = strlen(trace_labels[i]) + 1;
+        if (len + n > ATI_TRACE_LABEL_BYTES)
+            break;
+        memcpy(ati_trace_buf.labels + len, trace_labels[i], n);
+        len += n;
+    }
+    memset(ati_trace_buf.labels + len, 0, ATI_TRACE_LABEL_BYTES - len);
+
+    memcpy(h->magic, "ATITRACE", 8);
+    h->version = 1;
+    h->entry_size = sizeof(ati_trace_entry_t);
+    h->capacity = ATI_TRACE_ENTRIES;
+    h->count = count;
+    h->first = (head - count) & (ATI_TRACE_ENTRIES - 1);
+    h->dropped = head - count;
+    h->labels_size = ATI_TRACE_LABEL_BYTES;
+    h->reserved = 0;
+    h->start_tsc = trace_start_tsc;
+    h->start_ns = trace_start_ns;
+    h->end_tsc = __builtin_ia32_rdtsc();
+    h->end_ns = platform_time_ns();
+
+    // Only send the part of the ring that has been written
+    size_t size = sizeof(ati_trace_buf) -
+                  (ATI_TRACE_ENTRIES - count) * sizeof(ati_trace_entry_t);
+    platform_write_file(filename, &ati_trace_buf, size);
+    return true;
+}
+
+#else
+
+bool
+ati_trace_enabled(void)
+{
+    return false;
+}
+
+void
+ati_trace_clear(void)
+{
+}
+
+void
+ati_trace_print_status(void)
+{
+    printf("MMIO tracing is not built in (rebuild with TRACE=1)\n");
+}
+
+bool
+ati_trace_dump(const char *filename)
+{
+    (void) filename;
+    ati_trace_print_status();
+    return false;
+}
+
+#endif
@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "ati.h"
+
+/* MMIO trace ring buffer.
+ *
+ * Built with `make TRACE=1` (defines ATI_MMIO_TRACE), every single-dword
+ * register and VRAM access made through ati_reg_read/ati_reg_write and
+ * ati_vram_read/ati_vram_write is recorded with a TSC timestamp. Bulk
+ * transfers (uploads, readbacks, fills) are not. Without the flag the hooks
+ * expand to nothing.
+ *
+ * The ring keeps the newest ATI_TRACE_ENTRIES records. `trace dump` sends
+ * it over the serial file protocol; bin/trace-decode turns it into text.
+ */
+
+#ifndef ATI_TRACE_ENTRIES
+#define ATI_TRACE_ENTRIES (64 * 1024) // Must be a power of two
+#endif
+#define ATI_TRACE_MAX_LABELS 256
+#define ATI_TRACE_LABEL_BYTES 4096
+
+typedef enum {
+    TRACE_REG_READ = 0,
+    TRACE_REG_WRITE = 1,
+    TRACE_VRAM_READ = 2,
+    TRACE_VRAM_WRITE = 3,
+    TRACE_MARK = 4, // value is a label index
+} ati_trace_op_t;
+
+#define TRACE_OFFSET_MASK 0x0fffffffu
+#define TRACE_OP_SHIFT 28
+
+typedef struct {
+    uint64_t tsc;
+    uint32_t value;
+    uint32_t op_offset; // op in bits 31:28, offset in 27:0
+} ati_trace_entry_t;
+
+// Dump layout: header, label strings, then the raw ring. All fields are
+// little-endian; the decoder unwraps the ring starting at `first`.
+typedef struct {
+    char magic[8]; // "ATITRACE"
+    uint32_t version;
+    uint32_t entry_size;
+    uint32_t capacity;
+    uint32_t count;   // Valid entries
+    uint32_t first;   // Ring index of the oldest entry
+    uint32_t dropped; // Entries overwritten since the last clear
+    uint32_t labels_size;
+    uint32_t reserved;
+    // TSC and platform_time_ns pairs taken at clear and dump, so the
+    // decoder can convert timestamps without knowing the TSC rate
+    uint64_t start_tsc;
+    uint64_t start_ns;
+    uint64_t end_tsc;
+    uint64_t end_ns;
+} ati_trace_header_t;
+
+#ifdef ATI_MMIO_TRACE
+
+// Header, labels and ring sit back to back so a dump is one file record
+typedef struct {
+    ati_trace_header_t header;
+    char labels[ATI_TRACE_LABEL_BYTES];
+    ati_trace_entry_t ring[ATI_TRACE_ENTRIES];
+} ati_trace_buf_t;
+
+extern ati_trace_buf_t ati_trace_buf;
+extern uint32_t ati_trace_head; // Total records since the last clear
+
+// Lock-free: each caller claims a slot with one atomic increment
+static inline void
+ati_trace_record(ati_trace_op_t op, uint32_t offset, uint32_t value)
+{
+    uint32_t i = __atomic_fetch_add(&ati_trace_head, 1, __ATOMIC_RELAXED);
+    ati_trace_entry_t *e = &ati_trace_buf.ring[i & (ATI_TRACE_ENTRIES - 1)];
+    e->tsc = __builtin_ia32_rdtsc();
+    e->value = value;
+    e->op_offset = ((uint32_t) op << TRACE_OP_SHIFT) |
+                   (offset & TRACE_OFFSET_MASK);
+}
+
+#define ATI_TRACE(op, offset, value) ati_trace_record(op, offset, value)
+#define ATI_TRACE_MARK(label) ati_trace_mark(label)
+
+void ati_trace_mark(const char *label);
+
+#else
+
+#define ATI_TRACE(op, offset, value) ((void) 0)
+#define ATI_TRACE_MARK(label) ((void) 0)
+
+#endif
+
+// Available in every build; they report when tracing is compiled out
+bool ati_trace_enabled(void);
+void ati_trace_clear(void);
+void ati_trace_print_status(void);
+bool ati_trace_dump(const char *filename);
+
+#endif
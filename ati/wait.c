@@ -0,0 +1,130 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "wait.h"
+
+// Polls before backing off at all, and the cap on PAUSEs between polls
+// once backing off (2^10 PAUSEs is tens of microseconds)
+#define WAIT_SPIN_POLLS 16
+#define WAIT_MAX_BACKOFF_SHIFT 10
+
+// Sites are registered and updated atomically: cards can be tested from
+// several threads at once
+static ati_wait_site_t *wait_sites;
+
+static inline void
+cpu_relax(void)
+{
+    __asm__ volatile("pause");
+}
+
+void
+ati_wait_begin(ati_wait_t *w, ati_wait_site_t *site, uint32_t timeout_us)
+{
+    if (!__atomic_load_n(&site->registered, __ATOMIC_ACQUIRE) &&
+        !__atomic_exchange_n(&site->registered, true, __ATOMIC_ACQ_REL)) {
+        ati_wait_site_t *head = __atomic_load_n(&wait_sites, __ATOMIC_RELAXED);
+        do {
+            site->next = head;
+        } while (!__atomic_compare_exchange_n(&wait_sites, &head, site, true,
+                                              __ATOMIC_RELEASE,
+                                              __ATOMIC_RELAXED));
+    }
+
+    w->site = site;
+    w->start = platform_time_ns();
+    w->deadline = w->start + (uint64_t) timeout_us * 1000;
+    w->polls = 0;
+    // Assume a poll costs at least a microsecond if time isn't running
+    w->max_polls = timeout_us;
+}
+
+bool
+ati_wait_backoff(ati_wait_t *w)
+{
+    uint32_t polls = w->polls++;
+
+    if (polls >= WAIT_SPIN_POLLS) {
+        uint32_t shift = polls - WAIT_SPIN_POLLS;
+        if (shift > WAIT_MAX_BACKOFF_SHIFT)
+            shift = WAIT_MAX_BACKOFF_SHIFT;
+        for (uint32_t i = 0; i < (1u << shift); i++)
+            cpu_relax();
+    }
+
+    if (w->start == 0)
+        return w->polls < w->max_polls;
+    return platform_time_ns() < w->deadline;
+}
+
+bool
+ati_wait_end(ati_wait_t *w, bool ok)
+{
+    ati_wait_site_t *site = w->site;
+    uint64_t ns = platform_time_ns() - w->start;
+    uint64_t us = ns / 1000;
+
+    uint32_t bucket = 0;
+    while (us && bucket < ATI_WAIT_HIST_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+
+    __atomic_fetch_add(&site->calls, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&site->timeouts, !ok, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&site->total_ns, ns, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&site->hist[bucket], 1, __ATOMIC_RELAXED);
+    uint64_t max = __atomic_load_n(&site->max_ns, __ATOMIC_RELAXED);
+    while (ns > max && !__atomic_compare_exchange_n(&site->max_ns, &max, ns,
+                                                    true, __ATOMIC_RELAXED,
+                                                    __ATOMIC_RELAXED))
+        ;
+    return ok;
+}
+
+void
+ati_wait_stats_reset(void)
+{
+    ati_wait_site_t *sites = __atomic_load_n(&wait_sites, __ATOMIC_ACQUIRE);
+    for (ati_wait_site_t *s = sites; s; s = s->next) {
+        s->calls = 0;
+        s->timeouts = 0;
+        s->total_ns = 0;
+        s->max_ns = 0;
+        for (int i = 0; i < ATI_WAIT_HIST_BUCKETS; i++)
+            s->hist[i] = 0;
+    }
+}
+
+void
+ati_wait_stats_print(void)
+{
+    bool any = false;
+
+    ati_wait_site_t *sites = __atomic_load_n(&wait_sites, __ATOMIC_ACQUIRE);
+    for (ati_wait_site_t *s = sites; s; s = s->next) {
+        if (s->calls == 0)
+            continue;
+        if (!any)
+            printf("%-32s %8s %8s %8s %8s\n", "Wait site", "calls",
+                   "timeouts", "avg us", "max us");
+        any = true;
+
+        printf("%-32s %8u %8u %8u %8u\n", s->name, s->calls, s->timeouts,
+               (uint32_t) (s->total_ns / s->calls / 1000),
+               (uint32_t) (s->max_ns / 1000));
+
+        // Non-empty buckets as "<limit:count", limits in microseconds
+        printf("   ");
+        for (int i = 0; i < ATI_WAIT_HIST_BUCKETS; i++) {
+            if (s->hist[i] == 0)
+                continue;
+            if (i == ATI_WAIT_HIST_BUCKETS - 1)
+                printf(" >=%u:%u", 1u << (i - 1), s->hist[i]);
+            else
+                printf(" <%u:%u", 1u << i, s->hist[i]);
+        }
+        printf("\n");
+    }
+
+    if (!any)
+        printf("No waits recorded\n");
+}
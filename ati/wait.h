@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#ifndef WAIT_H
+#define WAIT_H
+
+#include "ati.h"
+
+/* Deadline-based polling with per-site latency histograms.
+ *
+ * Each polling loop declares a site with ATI_WAIT_SITE, which names it
+ * after the enclosing function. A wait runs against a deadline from
+ * platform_time_ns, backing off from tight polling to PAUSE loops the
+ * longer it takes:
+ *
+ *     ATI_WAIT_SITE(site);
+ *     ati_wait_t w;
+ *     ati_wait_begin(&w, &site, ATI_WAIT_ENGINE_US);
+ *     do {
+ *         if (done)
+ *             return ati_wait_end(&w, true);
+ *     } while (ati_wait_backoff(&w));
+ *     ati_wait_end(&w, false);
+ *
+ * Every finished wait lands in its site's histogram; `waits` at the
+ * console prints them.
+ */
+
+#define ATI_WAIT_ENGINE_US 1000000 // FIFO, engine idle and cache flushes
+#define ATI_WAIT_CCE_US 2000000    // CCE idle, which includes queued packets
+
+// Bucket 0 is under 1 us, bucket i covers [2^(i-1), 2^i) us and the last
+// bucket takes everything longer
+#define ATI_WAIT_HIST_BUCKETS 22
+
+typedef struct ati_wait_site {
+    const char *name;
+    uint32_t calls;
+    uint32_t timeouts;
+    uint64_t total_ns;
+    uint64_t max_ns;
+    uint32_t hist[ATI_WAIT_HIST_BUCKETS];
+    bool registered;
+    struct ati_wait_site *next;
+} ati_wait_site_t;
+
+#define ATI_WAIT_SITE(var) static ati_wait_site_t var = {.name = __func__}
+
+typedef struct {
+    ati_wait_site_t *site;
+    uint64_t start;
+    uint64_t deadline;
+    uint32_t polls;
+    uint32_t max_polls; // Fallback bound when no clock is available
+} ati_wait_t;
+
+void ati_wait_begin(ati_wait_t *w, ati_wait_site_t *site, uint32_t timeout_us);
+// Pause before the next poll. Returns false once the deadline has passed.
+bool ati_wait_backoff(ati_wait_t *w);
+// Record the wait in its site's histogram. Returns ok.
+bool ati_wait_end(ati_wait_t *w, bool ok);
+
+void ati_wait_stats_print(void);
+void ati_wait_stats_reset(void);
+
+#endif
@@ -0,0 +1,58 @@
+# frozen_string_literal: true
+
+# Geometry of framebuffer dumps. Dumps hold packed rows of the visible area,
+# so the decoded size alone identifies the display mode (no two modes share a
+# size). Offscreen surfaces need their geometry given explicitly.
+
+module Screen
+  # Resolutions and depths of the firmware's display modes (ati_display_modes)
+  RESOLUTIONS = [[640, 480], [1024, 768], [1280, 1024]].freeze
+  DEPTHS = [32, 24, 16, 8].freeze
+
+  # [width, height, bpp] of a dump of this many bytes, or nil if no mode
+  # matches
+  def self.geometry(bytesize)
+    RESOLUTIONS.product(DEPTHS).each do |(w, h), bpp|
+      return [w, h, bpp] if w * h * bpp / 8 == bytesize
+    end
+    nil
+  end
+
+  # Parses "WxHxBPP"; nil if malformed or the depth is unsupported
+  def self.parse_geometry(text)
+    m = /\A(\d+)x(\d+)x(\d+)\z/.match(text)
+    return nil unless m
+
+    geom = m.captures.map(&:to_i)
+    DEPTHS.include?(geom[2]) ? geom : nil
+  end
+
+  # Expands packed pixels to BGRA 8888 (0xAARRGGBB in little-endian memory
+  # order, as the 32 bpp framebuffer holds them):
+  #   24 bpp - 0xRRGGBB, three bytes per pixel
+  #   16 bpp - RGB 565, replicated up to 8 bits per channel
+  #    8 bpp - palette index, shown through the linear palette the firmware
+  #            loads, so as grey
+  def self.to_bgra(raw, bpp)
+    case bpp
+    when 32
+      raw
+    when 24
+      raw.unpack('C*').each_slice(3).map { |bgr| bgr << 0xFF }.flatten.pack('C*')
+    when 16
+      raw.unpack('v*').map { |p| rgb565_to_bgra(p) }.join
+    when 8
+      raw.unpack('C*').map { |i| [i, i, i, 0xFF].pack('C4') }.join
+    else
+      raise ArgumentError, "unsupported depth #{bpp}"
+    end
+  end
+
+  def self.rgb565_to_bgra(pixel)
+    r = (pixel >> 11) & 0x1F
+    g = (pixel >> 5) & 0x3F
+    b = pixel & 0x1F
+    [(b << 3) | (b >> 2), (g << 2) | (g >> 4), (r << 3) | (r >> 2), 0xFF].pack('C4')
+  end
+  private_class_method :rgb565_to_bgra
+end
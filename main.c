@@ -5,6 +5,8 @@
 // IWYU pragma: end_exports
 
 #include "ati/ati.h"
+#include "ati/snapshot.h"
+#include "ati/trace.h"
 #include "tests/test.h"
 #include "tests/error.h"
 #include "repl/repl.h"
@@ -21,6 +23,17 @@ typedef struct {
 static test_case_t tests[MAX_TESTS];
 static int test_count = 0;
 
+// Set while several cards run their suites at once; result lines are then
+// printed whole and prefixed with the card
+static bool parallel_run;
+
+typedef struct {
+    ati_device_t *dev;
+    int ran;
+    int failed;
+    int skipped;
+} suite_result_t;
+
 void
 register_test_internal(const char *id, const char *display_name,
                        bool (*func)(ati_device_t *), ati_chip_family_t chips)
@@ -36,51 +49,72 @@ register_test_internal(const char *id, const char *display_name,
     test_count += 1;
 }
 
-static void
+static bool
 run_test(ati_device_t *dev, const test_case_t *test)
 {
+    ATI_TRACE_MARK(test->id);
     ati_reset_for_test(dev);
-    printf("  %s ... ", test->display_name);
-    fflush(stdout);
-    if (test->func(dev)) {
-        printf(GREEN "ok" RESET "\n");
+    ati_reg_stats_reset(dev);
+    if (!parallel_run) {
+        printf("  %s ... ", test->display_name);
+        fflush(stdout);
+    }
+    bool ok = test->func(dev);
+    if (parallel_run) {
+        printf("  [card%d %s] %s ... %s\n", ati_device_index(dev),
+               ati_device_location(dev), test->display_name,
+               ok ? GREEN "ok" RESET : RED "FAILED" RESET);
+    } else {
+        printf(ok ? GREEN "ok" RESET "\n" : RED "FAILED" RESET "\n");
+    }
+    if (ok) {
         error_clear();
     } else {
-        printf(RED "FAILED" RESET "\n");
         error_flush();
         error_flush_dump(dev);
     }
+    report_reg_stats(dev, parallel_run);
+    return ok;
 }
 
-void
-run_all_tests(ati_device_t *dev)
+static void
+run_suite(suite_result_t *res)
 {
+    ati_device_t *dev = res->dev;
     ati_chip_family_t family = ati_get_chip_family(dev);
-    int skipped = 0;
-    int ran = 0;
-
-    printf("\nRunning tests for %s...\n", ati_chip_family_name(family));
 
     for (int i = 0; i < test_count; i++) {
         // Check if test is compatible with current chip
         if (!(tests[i].chips & family)) {
-            skipped++;
+            res->skipped++;
             continue;
         }
-        run_test(dev, &tests[i]);
-        ran++;
+        res->failed += !run_test(dev, &tests[i]);
+        res->ran++;
     }
+}
+
+void
+run_all_tests(ati_device_t *dev)
+{
+    suite_result_t res = {.dev = dev};
+
+    printf("\nRunning tests for %s...\n",
+           ati_chip_family_name(ati_get_chip_family(dev)));
 
-    printf("\nRan %d tests", ran);
-    if (skipped > 0) {
-        printf(" (%d skipped - incompatible chip)", skipped);
+    run_suite(&res);
+
+    printf("\nRan %d tests", res.ran);
+    if (res.skipped > 0) {
+        printf(" (%d skipped - incompatible chip)", res.skipped);
     }
     printf("\n");
 }
 
-void
-run_test_by_name(ati_device_t *dev, char *name)
+static bool
+run_named_test(suite_result_t *res, const char *name)
 {
+    ati_device_t *dev = res->dev;
     ati_chip_family_t family = ati_get_chip_family(dev);
 
     for (int i = 0; i < test_count; i++) {
@@ -93,13 +127,24 @@ run_test_by_name(ati_device_t *dev, char *name)
                        ((tests[i].chips & CHIP_R128) && (tests[i].chips & CHIP_R100)) ? "/" : "",
                        (tests[i].chips & CHIP_R100) ? "R100" : "",
                        ati_chip_family_name(family));
-                return;
+                res->skipped++;
+                return true;
             }
-            run_test(dev, &tests[i]);
-            return;
+            res->failed += !run_test(dev, &tests[i]);
+            res->ran++;
+            return true;
         }
     }
-    printf("Unknown test: %s\n", name);
+    return false;
+}
+
+void
+run_test_by_name(ati_device_t *dev, char *name)
+{
+    suite_result_t res = {.dev = dev};
+
+    if (!run_named_test(&res, name))
+        printf("Unknown test: %s\n", name);
 }
 
 void
@@ -121,7 +166,51 @@ list_tests(void)
     }
 }
 
+// ============================================================================
+// Multi-Card Runs
+// ============================================================================
+
+static platform_t *platform;
+
+// Bring one card up and run the tests named on the command line, or all of
+// them. Each card runs on its own thread on Linux.
+static void
+run_card(void *arg)
+{
+    suite_result_t *res = arg;
+
+    ati_set_display_mode(res->dev, ATI_DEFAULT_MODE);
+    ati_init_gui_engine(res->dev);
+    ati_capture_test_state(res->dev);
+
+    if (platform->argc > 0) {
+        for (int i = 0; i < platform->argc; i++) {
+            if (!run_named_test(res, platform->argv[i]) && !parallel_run)
+                printf("Unknown test: %s\n", platform->argv[i]);
+        }
+    } else {
+        run_suite(res);
+    }
+}
+
+static void
+print_card_summary(const suite_result_t *res)
+{
+    ati_device_t *dev = res->dev;
+
+    printf("  card%d %s %-6s %d ran, ", ati_device_index(dev),
+           ati_device_location(dev),
+           ati_chip_family_name(ati_get_chip_family(dev)), res->ran);
+    if (res->failed)
+        printf(RED "%d failed" RESET, res->failed);
+    else
+        printf(GREEN "0 failed" RESET);
+    printf(", %d skipped\n", res->skipped);
+}
+
 extern void register_clipping_tests(void);
+extern void register_cce_tests(void);
+extern void register_surface_tests(void);
 
 extern void register_r128_pitch_offset_cntl_tests(void);
 extern void register_r128_host_data_tests(void);
@@ -140,6 +229,8 @@ register_all_tests(void)
 {
     /* Common */
     register_clipping_tests();
+    register_cce_tests();
+    register_surface_tests();
 
     /* R128 */
     register_r128_pitch_offset_cntl_tests();
@@ -159,25 +250,58 @@ register_all_tests(void)
 int
 main(int argc, char **argv)
 {
-    platform_t *platform = platform_init(argc, argv);
-    ati_device_t *dev = ati_device_init(platform->pci_dev);
+    platform = platform_init(argc, argv);
+    ati_trace_clear();
 
-    ati_set_display_mode(dev);
-    ati_init_gui_engine(dev);
+    // With several cards installed, anything that isn't an R128 or R100
+    // (e.g. the onboard display) is left alone
+    suite_result_t results[PLATFORM_MAX_DEVICES] = {0};
+    void *args[PLATFORM_MAX_DEVICES];
+    int count = 0;
+    for (int i = 0; i < platform->num_devices; i++) {
+        if (platform->num_devices > 1 &&
+            !ati_device_supported(platform->pci_devs[i]))
+            continue;
+        results[count].dev = ati_device_init(platform->pci_devs[i]);
+        if (!results[count].dev)
+            continue;
+        args[count] = &results[count];
+        count++;
+    }
+    if (count == 0) {
+        fprintf(stderr, "No supported ATI card found\n");
+        exit(1);
+    }
 
     register_all_tests();
 
-    if (platform->argc > 0) {
-        for (int i = 0; i < platform->argc; i++) {
-            run_test_by_name(dev, platform->argv[i]);
+    if (count == 1) {
+        if (platform->argc == 0)
+            printf("\nRunning tests for %s...\n",
+                   ati_chip_family_name(ati_get_chip_family(results[0].dev)));
+        run_card(&results[0]);
+        if (platform->argc == 0) {
+            printf("\nRan %d tests", results[0].ran);
+            if (results[0].skipped > 0)
+                printf(" (%d skipped - incompatible chip)", results[0].skipped);
+            printf("\n");
         }
     } else {
-        run_all_tests(dev);
+        printf("\nRunning tests on %d cards...\n", count);
+        parallel_run = true;
+        platform_run_parallel(run_card, args, count);
+        parallel_run = false;
+
+        printf("\nSummary:\n");
+        for (int i = 0; i < count; i++)
+            print_card_summary(&results[i]);
     }
 
-    repl(dev);
+    // The console drives the first card
+    repl(results[0].dev);
 
-    ati_device_destroy(dev);
+    for (int i = 0; i < count; i++)
+        ati_device_destroy(results[i].dev);
     platform_destroy(platform);
     return 0;
 }
@@ -26,6 +26,9 @@
 #define PCI_COMMAND_IO       0x01     // Enable I/O Space
 #define PCI_COMMAND_MEMORY   0x02     // Enable Memory Space
 #define PCI_COMMAND_MASTER   0x04     // Enable Bus Mastering
+
+// BAR bit 0: the BAR decodes I/O space rather than memory
+#define PCI_BAR_IO           0x01
 // clang-format on
 
 #define NUM_BARS 8
@@ -37,6 +40,7 @@ struct platform_pci_device {
     uint16_t vendor_id;
     uint16_t device_id;
     uint32_t bar[NUM_BARS];
+    uint16_t io_base; // Port of the opened I/O BAR
 };
 
 #define FATAL                                                                  \
@@ -67,6 +71,14 @@ outb(uint16_t port, uint8_t val)
     __asm__ volatile("outb %0, %1" : : "a"(val), "Nd"(port));
 }
 
+static inline uint8_t
+inb(uint16_t port)
+{
+    uint8_t ret;
+    __asm__ volatile("inb %1, %0" : "=a"(ret) : "Nd"(port));
+    return ret;
+}
+
 void
 outw(uint16_t port, uint16_t val)
 {
@@ -164,6 +176,8 @@ find_device(platform_pci_device_t *dev)
                     dev->device_id = device_id;
                     dev->bar[0] =
                         pci_config_read32(bus, device, function, PCI_BAR0);
+                    dev->bar[1] =
+                        pci_config_read32(bus, device, function, PCI_BAR1);
                     dev->bar[2] =
                         pci_config_read32(bus, device, function, PCI_BAR2);
                     return 1;
@@ -209,6 +223,12 @@ platform_pci_destroy(platform_pci_device_t *dev)
     return;
 }
 
+void
+platform_pci_get_location(platform_pci_device_t *dev, char *buf, size_t len)
+{
+    snprintf(buf, len, "%02x:%02x.%d", dev->bus, dev->device, dev->function);
+}
+
 void
 platform_pci_get_name(platform_pci_device_t *dev, char *buf, size_t len)
 {
@@ -247,6 +267,16 @@ platform_pci_map_bar(platform_pci_device_t *dev, int bar_idx)
     return (void *) (uintptr_t) (dev->bar[bar_idx] & ~0xful);
 }
 
+void *
+platform_pci_map_bar_wc(platform_pci_device_t *dev, int bar_idx)
+{
+    // Paging is off and we don't touch the MTRRs, so the aperture is
+    // whatever the firmware left it as (normally UC).
+    (void) dev;
+    (void) bar_idx;
+    return NULL;
+}
+
 void
 platform_pci_unmap_bar(platform_pci_device_t *dev, void *addr, int bar_idx)
 {
@@ -271,6 +301,29 @@ platform_pci_get_bar_size(platform_pci_device_t *dev, int bar_idx)
     return ~size_mask + 1;
 }
 
+bool
+platform_pci_open_io(platform_pci_device_t *dev, int bar_idx)
+{
+    uint32_t bar = dev->bar[bar_idx];
+    if (!(bar & PCI_BAR_IO))
+        return false;
+    dev->io_base = bar & 0xfffc;
+    return true;
+}
+
+uint32_t
+platform_pci_io_read32(platform_pci_device_t *dev, uint32_t offset)
+{
+    return inl(dev->io_base + offset);
+}
+
+void
+platform_pci_io_write32(platform_pci_device_t *dev, uint32_t offset,
+                        uint32_t value)
+{
+    outl(dev->io_base + offset, value);
+}
+
 uint16_t
 platform_pci_get_device_id(platform_pci_device_t *dev)
 {
@@ -286,44 +339,17 @@ typedef struct {
 
 extern const fixture_entry_t fixture_registry[];
 
-// 32MB buffer for decompressed fixtures (in BSS, doesn't bloat ELF)
-#define FIXTURE_BUFFER_SIZE (32 * 1024 * 1024)
-static uint8_t fixture_buffer[FIXTURE_BUFFER_SIZE];
-
-// RLE decode: 0xFF <count> <byte> for runs, raw bytes otherwise
-static size_t
-rle_decode(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_max)
-{
-    const uint8_t *src_end = src + src_len;
-    uint8_t *dst_start = dst;
-    uint8_t *dst_end = dst + dst_max;
-
-    while (src < src_end && dst < dst_end) {
-        if (*src == 0xFF) {
-            if (src + 2 >= src_end)
-                break;  // Incomplete escape sequence
-            uint8_t count = src[1];
-            uint8_t value = src[2];
-            src += 3;
-            while (count-- && dst < dst_end)
-                *dst++ = value;
-        } else {
-            *dst++ = *src++;
-        }
-    }
-
-    return dst - dst_start;
-}
-
+// Fixtures are handed out still RLE compressed, straight from .rodata.
+// The framebuffer compare walks the token stream directly.
 const uint8_t *
-platform_get_fixture(const char *name, size_t *size_out)
+platform_get_fixture(const char *name, size_t *size_out,
+                     fixture_encoding_t *encoding_out)
 {
     for (int i = 0; fixture_registry[i].name != NULL; i++) {
         if (strcmp(fixture_registry[i].name, name) == 0) {
-            size_t compressed_size = fixture_registry[i].end - fixture_registry[i].start;
-            *size_out = rle_decode(fixture_registry[i].start, compressed_size,
-                                   fixture_buffer, FIXTURE_BUFFER_SIZE);
-            return fixture_buffer;
+            *size_out = fixture_registry[i].end - fixture_registry[i].start;
+            *encoding_out = FIXTURE_RLE;
+            return fixture_registry[i].start;
         }
     }
     *size_out = 0;
@@ -333,7 +359,7 @@ platform_get_fixture(const char *name, size_t *size_out)
 void
 platform_free_fixture(const uint8_t *data)
 {
-    // No-op for baremetal - data is in static buffer
+    // No-op for baremetal - data lives in .rodata
     (void) data;
 }
 
@@ -450,6 +476,103 @@ fgets(char *s, int size, FILE *stream)
     return s;
 }
 
+// 64-bit unsigned division helpers. We link with -nostdlib so libgcc isn't
+// available, but gcc emits calls to these for uint64_t '/' and '%' on i386.
+uint64_t
+__udivmoddi4(uint64_t num, uint64_t den, uint64_t *rem)
+{
+    uint64_t quot = 0;
+    uint64_t bit = 1;
+
+    if (den == 0) {
+        if (rem)
+            *rem = 0;
+        return 0;
+    }
+
+    while (den < num && !(den & (1ull << 63))) {
+        den <<= 1;
+        bit <<= 1;
+    }
+    while (bit) {
+        if (num >= den) {
+            num -= den;
+            quot |= bit;
+        }
+        den >>= 1;
+        bit >>= 1;
+    }
+
+    if (rem)
+        *rem = num;
+    return quot;
+}
+
+uint64_t
+__udivdi3(uint64_t num, uint64_t den)
+{
+    return __udivmoddi4(num, den, NULL);
+}
+
+uint64_t
+__umoddi3(uint64_t num, uint64_t den)
+{
+    uint64_t rem;
+    __udivmoddi4(num, den, &rem);
+    return rem;
+}
+
+// Timekeeping: the TSC is calibrated once at boot against PIT channel 2
+#define PIT_CH2_DATA    0x42
+#define PIT_MODE        0x43
+#define PIT_CH2_GATE    0x61
+#define PIT_HZ          1193182
+#define TSC_CALIB_MS    10
+
+static uint64_t tsc_hz;
+
+static inline uint64_t
+rdtsc(void)
+{
+    uint32_t lo, hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t) hi << 32) | lo;
+}
+
+static void
+tsc_calibrate(void)
+{
+    uint16_t count = PIT_HZ * TSC_CALIB_MS / 1000;
+
+    // Gate channel 2 on, speaker off, then one-shot (mode 0) countdown.
+    // OUT2 (port 0x61 bit 5) goes high when the count reaches zero.
+    outb(PIT_CH2_GATE, (inb(PIT_CH2_GATE) & ~0x02) | 0x01);
+    outb(PIT_MODE, 0xB0);  // channel 2, lo/hi byte, mode 0, binary
+    outb(PIT_CH2_DATA, count & 0xff);
+    outb(PIT_CH2_DATA, count >> 8);
+
+    uint64_t start = rdtsc();
+    while (!(inb(PIT_CH2_GATE) & 0x20))
+        ;
+    uint64_t end = rdtsc();
+
+    tsc_hz = (end - start) * (1000 / TSC_CALIB_MS);
+}
+
+uint64_t
+platform_time_ns(void)
+{
+    uint64_t tsc = rdtsc();
+
+    if (tsc_hz == 0)
+        return 0;
+
+    // Split so tsc * 1e9 doesn't overflow
+    uint64_t sec = tsc / tsc_hz;
+    uint64_t rem = tsc % tsc_hz;
+    return sec * 1000000000ull + rem * 1000000000ull / tsc_hz;
+}
+
 // Multiboot v1 information structure
 struct multiboot_info {
     uint32_t flags;
@@ -509,17 +632,28 @@ platform_init(int argc, char **argv)
 
     serial_init();
     init_printf(NULL, serial_putc);
+    tsc_calibrate();
 
     // Args already parsed by platform_init_args() called from boot.S
     platform.argc = g_argc - 1; // Remove kernel name to match linux argc count
     platform.argv = &g_argv[1]; // Skip the kernel name
 
-    // Initialize PCI device
+    // Initialize PCI device. Only the first ATI card is used on baremetal.
     platform.pci_dev = platform_pci_init_internal();
+    platform.pci_devs[0] = platform.pci_dev;
+    platform.num_devices = 1;
 
     return &platform;
 }
 
+void
+platform_run_parallel(void (*fn)(void *), void **args, int count)
+{
+    // No threads: run them one after another
+    for (int i = 0; i < count; i++)
+        fn(args[i]);
+}
+
 void
 platform_init_args(uint32_t magic, struct multiboot_info *mbi)
 {
@@ -7,6 +7,9 @@
 // IWYU pragma: end_exports
 #include <stdint.h>
 
+/* Single-threaded: per-thread state is just global */
+#define PLATFORM_THREAD_LOCAL
+
 /* Minimal libc replacement declarations */
 typedef void FILE;
 #define stdin ((FILE *) 0)
@@ -1,11 +1,15 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
+#define _DEFAULT_SOURCE  // usleep, clock_gettime
+
 #include <errno.h>
 #include <fcntl.h>
 #include <pci/pci.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "../platform.h"
@@ -13,6 +17,7 @@
 struct platform_pci_device {
     struct pci_access *pacc;
     struct pci_dev *pci_dev;
+    int io_fd; // sysfs resource file of the opened I/O BAR, or -1
 };
 
 #define FATAL                                                                  \
@@ -22,21 +27,46 @@ struct platform_pci_device {
         exit(1);                                                               \
     } while (0)
 
-struct pci_dev *
-find_device(struct pci_access *pacc)
+// One libpci handle is shared by every device; it's released in
+// platform_destroy
+static struct pci_access *g_pacc;
+
+static int
+pci_location_cmp(const struct pci_dev *a, const struct pci_dev *b)
+{
+    if (a->domain != b->domain)
+        return a->domain < b->domain ? -1 : 1;
+    if (a->bus != b->bus)
+        return a->bus < b->bus ? -1 : 1;
+    if (a->dev != b->dev)
+        return a->dev < b->dev ? -1 : 1;
+    return a->func - b->func;
+}
+
+// Collect every ATI device, up to max. libpci lists devices in reverse
+// bus order, so they're sorted by location to give stable card numbers.
+static int
+find_devices(struct pci_access *pacc, struct pci_dev **out, int max)
 {
     struct pci_dev *dev;
+    int count = 0;
 
     pci_init(pacc);
     pci_scan_bus(pacc);
 
-    for (dev = pacc->devices; dev; dev = dev->next) {
-        if (dev->vendor_id == ATI_VENDOR_ID) {
-            return dev;
+    for (dev = pacc->devices; dev && count < max; dev = dev->next) {
+        if (dev->vendor_id != ATI_VENDOR_ID)
+            continue;
+
+        int i = count++;
+        while (i > 0 && pci_location_cmp(out[i - 1], dev) > 0) {
+            out[i] = out[i - 1];
+            i--;
         }
+        out[i] = dev;
     }
 
-    return NULL;
+    return count;
 }
 
 void
@@ -46,60 +76,99 @@ platform_pci_get_name(platform_pci_device_t *dev, char *buf, size_t len)
                     dev->pci_dev->vendor_id, dev->pci_dev->device_id);
 }
 
-static platform_pci_device_t *
-platform_pci_init_internal(void)
+void
+platform_pci_get_location(platform_pci_device_t *dev, char *buf, size_t len)
 {
-    platform_pci_device_t *dev = malloc(sizeof(platform_pci_device_t));
-    if (!dev)
-        FATAL;
+    struct pci_dev *pci = dev->pci_dev;
+    snprintf(buf, len, "%04x:%02x:%02x.%d", pci->domain, pci->bus, pci->dev,
+             pci->func);
+}
+
+static int
+platform_pci_init_internal(platform_pci_device_t **out, int max)
+{
+    struct pci_dev *found[PLATFORM_MAX_DEVICES];
 
-    dev->pacc = pci_alloc();
-    if (!dev->pacc)
+    g_pacc = pci_alloc();
+    if (!g_pacc)
         FATAL;
 
-    dev->pci_dev = find_device(dev->pacc);
-    if (!dev->pci_dev)
+    if (max > PLATFORM_MAX_DEVICES)
+        max = PLATFORM_MAX_DEVICES;
+    int count = find_devices(g_pacc, found, max);
+    if (count == 0)
         FATAL;
 
-    return dev;
+    for (int i = 0; i < count; i++) {
+        platform_pci_device_t *dev = malloc(sizeof(platform_pci_device_t));
+        if (!dev)
+            FATAL;
+        dev->pacc = g_pacc;
+        dev->pci_dev = found[i];
+        dev->io_fd = -1;
+        out[i] = dev;
+    }
+
+    return count;
 }
 
 void
 platform_pci_destroy(platform_pci_device_t *dev)
 {
-    if (!dev)
-        return;
-    if (dev->pacc)
-        pci_cleanup(dev->pacc);
+    if (dev->io_fd != -1)
+        close(dev->io_fd);
     free(dev);
 }
 
-void *
-platform_pci_map_bar(platform_pci_device_t *dev, int bar_idx)
+// sysfs path of a BAR's resource file
+static void
+resource_path(platform_pci_device_t *dev, int bar_idx, const char *suffix,
+              char *buf, size_t len)
 {
     struct pci_dev *pci = dev->pci_dev;
-    char pci_loc[32];
-    sprintf(pci_loc, "%04x:%02x:%02x.%d", pci->domain, pci->bus, pci->dev,
-            pci->func);
-
-    char base_path[256];
-    sprintf(base_path, "/sys/bus/pci/devices/%s", pci_loc);
+    snprintf(buf, len, "/sys/bus/pci/devices/%04x:%02x:%02x.%d/resource%d%s",
+             pci->domain, pci->bus, pci->dev, pci->func, bar_idx, suffix);
+}
 
+// mmap a sysfs resource file for the BAR. Returns NULL if the file can't be
+// opened (e.g. resourceN_wc only exists for prefetchable BARs).
+static void *
+map_resource(platform_pci_device_t *dev, int bar_idx, const char *suffix,
+             int flags)
+{
+    struct pci_dev *pci = dev->pci_dev;
     char bar_path[512];
-    sprintf(bar_path, "%s/resource%d", base_path, bar_idx);
+    resource_path(dev, bar_idx, suffix, bar_path, sizeof(bar_path));
 
-    int bar_fd = open(bar_path, O_RDWR | O_SYNC);
+    int bar_fd = open(bar_path, O_RDWR | flags);
     if (bar_fd == -1)
-        FATAL;
+        return NULL;
 
     void *bar = mmap(NULL, pci->size[bar_idx], PROT_READ | PROT_WRITE,
                      MAP_SHARED, bar_fd, 0);
+    close(bar_fd);
     if (bar == (void *) -1)
         FATAL;
 
     return bar;
 }
 
+void *
+platform_pci_map_bar(platform_pci_device_t *dev, int bar_idx)
+{
+    void *bar = map_resource(dev, bar_idx, "", O_SYNC);
+    if (!bar)
+        FATAL;
+
+    return bar;
+}
+
+void *
+platform_pci_map_bar_wc(platform_pci_device_t *dev, int bar_idx)
+{
+    return map_resource(dev, bar_idx, "_wc", 0);
+}
+
 void
 platform_pci_unmap_bar(platform_pci_device_t *dev, void *addr, int bar_idx)
 {
@@ -112,18 +181,50 @@ platform_pci_get_bar_size(platform_pci_device_t *dev, int bar_idx)
     return dev->pci_dev->size[bar_idx];
 }
 
+// The kernel services reads and writes of an I/O BAR's resource file as
+// port accesses of the same width, so each dword is one pread/pwrite
+bool
+platform_pci_open_io(platform_pci_device_t *dev, int bar_idx)
+{
+    if (dev->io_fd != -1)
+        return true;
+    if (!(dev->pci_dev->base_addr[bar_idx] & PCI_BASE_ADDRESS_SPACE_IO))
+        return false;
+
+    char path[512];
+    resource_path(dev, bar_idx, "", path, sizeof(path));
+    dev->io_fd = open(path, O_RDWR);
+    return dev->io_fd != -1;
+}
+
+uint32_t
+platform_pci_io_read32(platform_pci_device_t *dev, uint32_t offset)
+{
+    uint32_t value = 0xffffffff;
+    if (pread(dev->io_fd, &value, 4, offset) != 4)
+        fprintf(stderr, "I/O read at 0x%x failed: %s\n", offset,
+                strerror(errno));
+    return value;
+}
+
+void
+platform_pci_io_write32(platform_pci_device_t *dev, uint32_t offset,
+                        uint32_t value)
+{
+    if (pwrite(dev->io_fd, &value, 4, offset) != 4)
+        fprintf(stderr, "I/O write at 0x%x failed: %s\n", offset,
+                strerror(errno));
+}
+
 uint16_t
 platform_pci_get_device_id(platform_pci_device_t *dev)
 {
     return dev->pci_dev->device_id;
 }
 
-const uint8_t *
-platform_get_fixture(const char *name, size_t *size_out)
+static uint8_t *
+read_whole_file(const char *path, size_t *size_out)
 {
-    char path[512];
-    snprintf(path, sizeof(path), "fixtures/%s.bin", name);
-
     FILE *f = fopen(path, "rb");
     if (!f) {
         *size_out = 0;
@@ -157,6 +258,29 @@ platform_get_fixture(const char *name, size_t *size_out)
     return data;
 }
 
+const uint8_t *
+platform_get_fixture(const char *name, size_t *size_out,
+                     fixture_encoding_t *encoding_out)
+{
+    char path[512];
+    uint8_t *data;
+
+    // Prefer a raw dump if one exists, otherwise use the RLE fixture as-is
+    snprintf(path, sizeof(path), "fixtures/%s.bin", name);
+    if ((data = read_whole_file(path, size_out))) {
+        *encoding_out = FIXTURE_RAW;
+        return data;
+    }
+
+    snprintf(path, sizeof(path), "fixtures/%s.rle", name);
+    if ((data = read_whole_file(path, size_out))) {
+        *encoding_out = FIXTURE_RLE;
+        return data;
+    }
+
+    return NULL;
+}
+
 void
 platform_free_fixture(const uint8_t *data)
 {
@@ -191,8 +315,10 @@ platform_init(int argc, char **argv)
     platform.argc = argc > 1 ? argc - 1 : 0;
     platform.argv = argc > 1 ? &argv[1] : NULL;
 
-    // Initialize PCI device
-    platform.pci_dev = platform_pci_init_internal();
+    // Initialize PCI devices
+    platform.num_devices =
+        platform_pci_init_internal(platform.pci_devs, PLATFORM_MAX_DEVICES);
+    platform.pci_dev = platform.pci_devs[0];
 
     return &platform;
 }
@@ -200,8 +326,48 @@ platform_init(int argc, char **argv)
 void
 platform_destroy(platform_t *platform)
 {
-    // Nothing to do on Linux
     (void) platform;
+    if (g_pacc)
+        pci_cleanup(g_pacc);
+    g_pacc = NULL;
+}
+
+typedef struct {
+    void (*fn)(void *);
+    void *arg;
+} thread_start_t;
+
+static void *
+thread_main(void *p)
+{
+    thread_start_t *start = p;
+    start->fn(start->arg);
+    return NULL;
+}
+
+void
+platform_run_parallel(void (*fn)(void *), void **args, int count)
+{
+    pthread_t threads[PLATFORM_MAX_DEVICES];
+    thread_start_t starts[PLATFORM_MAX_DEVICES];
+    int started = 0;
+
+    for (int i = 0; i < count; i++) {
+        // Past the thread limit, or if a thread can't be created, the work
+        // runs on the calling thread instead
+        if (started < PLATFORM_MAX_DEVICES) {
+            starts[started] = (thread_start_t) {fn, args[i]};
+            if (pthread_create(&threads[started], NULL, thread_main,
+                               &starts[started]) == 0) {
+                started++;
+                continue;
+            }
+        }
+        fn(args[i]);
+    }
+
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
 }
 
 void
@@ -217,4 +383,12 @@ udelay(unsigned int us)
     usleep(us);
 }
 
+uint64_t
+platform_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
 
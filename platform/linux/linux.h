@@ -8,4 +8,6 @@
 #include <strings.h>
 #include <errno.h>
 
+#define PLATFORM_THREAD_LOCAL __thread
+
 #endif
@@ -18,11 +18,15 @@
 
 typedef struct platform_pci_device platform_pci_device_t;
 
+#define PLATFORM_MAX_DEVICES 8
+
 /* Platform state - everything needed from platform initialization */
 typedef struct {
     int argc;
     char **argv;
-    platform_pci_device_t *pci_dev;
+    platform_pci_device_t *pci_dev; // First ATI device, same as pci_devs[0]
+    platform_pci_device_t *pci_devs[PLATFORM_MAX_DEVICES];
+    int num_devices;
 } platform_t;
 
 platform_t *platform_init(int argc, char **argv);
@@ -30,18 +34,45 @@ void platform_destroy(platform_t *platform);
 void platform_reboot(void);
 void platform_pci_destroy(platform_pci_device_t *dev);
 void platform_pci_get_name(platform_pci_device_t *dev, char *buf, size_t len);
+/* Bus location as "bus:dev.fn" (with a domain prefix on Linux) */
+void platform_pci_get_location(platform_pci_device_t *dev, char *buf,
+                               size_t len);
 
 void *platform_pci_map_bar(platform_pci_device_t *dev, int bar_idx);
+/* Map a prefetchable BAR write-combined. Returns NULL when the platform
+ * can't provide a WC mapping; callers fall back to platform_pci_map_bar(). */
+void *platform_pci_map_bar_wc(platform_pci_device_t *dev, int bar_idx);
 void platform_pci_unmap_bar(platform_pci_device_t *dev, void *addr,
                             int bar_idx);
 size_t platform_pci_get_bar_size(platform_pci_device_t *dev, int bar_idx);
+/* Port I/O through an I/O-space BAR. platform_pci_open_io returns false when
+ * the BAR isn't I/O space or the platform can't reach it; the accessors may
+ * only be used after it succeeds. Offsets are relative to the BAR. */
+bool platform_pci_open_io(platform_pci_device_t *dev, int bar_idx);
+uint32_t platform_pci_io_read32(platform_pci_device_t *dev, uint32_t offset);
+void platform_pci_io_write32(platform_pci_device_t *dev, uint32_t offset,
+                             uint32_t value);
 uint16_t platform_pci_get_device_id(platform_pci_device_t *dev);
 
+/* Run fn(args[i]) for every i, one thread each, and wait for all of them.
+ * Platforms without threads run them in order on the calling thread.
+ * PLATFORM_THREAD_LOCAL marks state that must be private to each. */
+void platform_run_parallel(void (*fn)(void *), void **args, int count);
+
 /* Timing */
 void udelay(unsigned int us);
+uint64_t platform_time_ns(void);  // Monotonic, arbitrary epoch
+
+/* Fixture access - abstracted from filesystem.
+ * Fixtures are returned in the encoding they are stored in; RLE fixtures
+ * (0xFF <count> <byte> for runs, raw bytes otherwise) are not decoded. */
+typedef enum {
+    FIXTURE_RAW,
+    FIXTURE_RLE,
+} fixture_encoding_t;
 
-/* Fixture access - abstracted from filesystem */
-const uint8_t *platform_get_fixture(const char *name, size_t *size_out);
+const uint8_t *platform_get_fixture(const char *name, size_t *size_out,
+                                    fixture_encoding_t *encoding_out);
 void platform_free_fixture(const uint8_t *data);
 
 /* File I/O - for Linux platform only */
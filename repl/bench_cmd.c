@@ -0,0 +1,593 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "bench_cmd.h"
+#include "../ati/cce.h"
+#include "../ati/r100_ib.h"
+#include "../ati/r100_ring.h"
+#include "../ati/r128_ring.h"
+#include "repl.h"
+
+typedef enum {
+    BENCH_CMD_VRAM,
+    BENCH_CMD_REGS,
+    BENCH_CMD_CCE,
+    BENCH_CMD_IB,
+    BENCH_CMD_UNKNOWN
+} bench_cmd_t;
+
+// clang-format off
+static const struct {
+    const char *name;
+    bench_cmd_t cmd;
+    const char *usage;
+    const char *desc;
+} bench_cmd_table[] = {
+    {"vram",   BENCH_CMD_VRAM,    "[kb]",  "VRAM aperture bandwidth (UC and WC)"},
+    {"regs",   BENCH_CMD_REGS,    "[n]",   "register latency per access backend"},
+    {"cce",    BENCH_CMD_CCE,     "[kdw]", "CCE packet throughput, PIO vs ring"},
+    {"ib",     BENCH_CMD_IB,      "[kdw]", "R100 indirect buffer throughput by size"},
+    {NULL,     BENCH_CMD_UNKNOWN, NULL,    NULL}
+};
+// clang-format on
+
+// System RAM side of every transfer. Static so it works on baremetal too.
+#define BENCH_BUF_SIZE (1024 * 1024)
+static uint8_t bench_buf[BENCH_BUF_SIZE] __attribute__((aligned(64)));
+
+static bench_cmd_t
+lookup_bench_cmd(const char *name)
+{
+    for (int i = 0; bench_cmd_table[i].name != NULL; i++) {
+        if (strcmp(name, bench_cmd_table[i].name) == 0)
+            return bench_cmd_table[i].cmd;
+    }
+    return BENCH_CMD_UNKNOWN;
+}
+
+// Print a transfer rate in MB/s (10^6 bytes) with one decimal place
+static void
+print_rate(const char *label, size_t bytes, uint64_t ns)
+{
+    uint32_t tenths = ns ? (uint32_t) ((uint64_t) bytes * 10000 / ns) : 0;
+    printf("  %-18s %6u.%u MB/s\n", label, tenths / 10, tenths % 10);
+}
+
+// ============================================================================
+// VRAM Aperture Bandwidth
+// ============================================================================
+
+// Refill the source pattern, or check it came back intact
+static size_t
+bench_pattern(bool check, size_t size)
+{
+    size_t bad = 0;
+    for (size_t i = 0; i < size; i += 4) {
+        uint32_t val = 0xA5000000 | i;
+        uint32_t got;
+        if (!check) {
+            __builtin_memcpy(bench_buf + i, &val, 4);
+            continue;
+        }
+        __builtin_memcpy(&got, bench_buf + i, 4);
+        if (got != val)
+            bad++;
+    }
+    return bad;
+}
+
+// Upload, readback and fill at one transfer width
+static void
+bench_vram_width(ati_device_t *dev, ati_vram_width_t width, uint32_t offset,
+                 size_t size)
+{
+    char label[32];
+    uint64_t start;
+
+    ati_vram_set_copy_width(dev, width);
+
+    // The trailing read can't complete until the posted writes have landed
+    bench_pattern(false, size);
+    start = platform_time_ns();
+    ati_vram_upload(dev, offset, bench_buf, size);
+    (void) ati_vram_read(dev, offset + size - 4);
+    snprintf(label, sizeof(label), "upload (%s)", ati_vram_width_name(width));
+    print_rate(label, size, platform_time_ns() - start);
+
+    __builtin_memset(bench_buf, 0, size);
+    start = platform_time_ns();
+    ati_vram_readback(dev, offset, bench_buf, size);
+    snprintf(label, sizeof(label), "readback (%s)", ati_vram_width_name(width));
+    print_rate(label, size, platform_time_ns() - start);
+
+    size_t bad = bench_pattern(true, size);
+    if (bad)
+        printf("  WARNING: %zu dwords read back wrong\n", bad);
+
+    start = platform_time_ns();
+    ati_vram_set(dev, offset, 0, size);
+    (void) ati_vram_read(dev, offset + size - 4);
+    snprintf(label, sizeof(label), "set (%s)", ati_vram_width_name(width));
+    print_rate(label, size, platform_time_ns() - start);
+}
+
+static void
+bench_vram_pass(ati_device_t *dev, uint32_t offset, size_t size)
+{
+    volatile uint32_t sink = 0;
+    uint64_t start;
+
+    printf("%s:\n", ati_vram_is_write_combining(dev) ? "Write-combined"
+                                                     : "Uncached");
+
+    for (int w = ATI_VRAM_DWORD; w <= (int) ati_vram_widest(); w++)
+        bench_vram_width(dev, (ati_vram_width_t) w, offset, size);
+    ati_vram_set_copy_width(dev, ati_vram_widest());
+
+    start = platform_time_ns();
+    for (size_t i = 0; i < size; i += 4)
+        sink += ati_vram_read(dev, offset + i);
+    print_rate("read (single)", size, platform_time_ns() - start);
+    (void) sink;
+}
+
+static void
+bench_vram(ati_device_t *dev, int argc, char **args)
+{
+    uint32_t kb = BENCH_BUF_SIZE / 1024;
+    if (argc >= 3 && (parse_int(args[2], &kb) != 0 || kb == 0)) {
+        printf("Usage: bench vram [kb]\n");
+        return;
+    }
+
+    // Work past the visible framebuffer so the screen isn't disturbed
+    const ati_display_mode_t *mode = ati_get_display_mode(dev);
+    uint32_t offset = mode->pitch * mode->height;
+    size_t size = (size_t) kb * 1024;
+    if (size > BENCH_BUF_SIZE)
+        size = BENCH_BUF_SIZE;
+    if (offset + size > ati_vram_aperture_size(dev)) {
+        printf("Transfer doesn't fit in the VRAM aperture\n");
+        return;
+    }
+
+    printf("Transfer size: %zu KB at VRAM offset 0x%x\n", size / 1024, offset);
+
+    bool was_wc = ati_vram_is_write_combining(dev);
+    ati_wait_for_idle(dev);
+
+    ati_vram_set_write_combining(dev, false);
+    bench_vram_pass(dev, offset, size);
+
+    if (ati_vram_set_write_combining(dev, true))
+        bench_vram_pass(dev, offset, size);
+    else
+        printf("Write-combined: mapping not available on this platform\n");
+
+    ati_vram_set_write_combining(dev, was_wc);
+}
+
+// ============================================================================
+// Register Access Backends
+// ============================================================================
+// BIOS_0_SCRATCH sits in the I/O BAR's directly decoded range and
+// GUI_SCRATCH_REG0 doesn't, so the two show the I/O backend's direct and
+// indexed paths. GUI_SCRATCH_REG0 goes through the GUI FIFO, so its writes
+// are batched to stay within the free slots.
+
+#define BENCH_REGS_DEFAULT 10000
+#define BENCH_REGS_BATCH 16
+
+// Per-access latency and the rate it implies
+static void
+print_ops(const char *label, uint32_t count, uint64_t ns)
+{
+    uint32_t per = count ? (uint32_t) (ns / count) : 0;
+    uint32_t kops = ns ? (uint32_t) ((uint64_t) count * 1000000 / ns) : 0;
+    printf("  %-24s %6u ns %8u k/s\n", label, per, kops);
+}
+
+static void
+bench_regs_backend(ati_device_t *dev, uint32_t count)
+{
+    volatile uint32_t sink = 0;
+    ati_reg_pair_t batch[BENCH_REGS_BATCH];
+    uint64_t start;
+
+    printf("%s:\n", ati_reg_backend_name(ati_reg_get_backend(dev)));
+
+    start = platform_time_ns();
+    for (uint32_t i = 0; i < count; i++)
+        sink += rd_bios_0_scratch(dev);
+    print_ops("read BIOS_0_SCRATCH", count, platform_time_ns() - start);
+
+    start = platform_time_ns();
+    for (uint32_t i = 0; i < count; i++)
+        sink += rd_gui_scratch_reg0(dev);
+    print_ops("read GUI_SCRATCH_REG0", count, platform_time_ns() - start);
+
+    start = platform_time_ns();
+    for (uint32_t i = 0; i < count; i++)
+        wr_bios_0_scratch(dev, i);
+    sink += rd_bios_0_scratch(dev);
+    print_ops("write BIOS_0_SCRATCH", count, platform_time_ns() - start);
+
+    start = platform_time_ns();
+    for (uint32_t i = 0; i < count; i += BENCH_REGS_BATCH) {
+        for (uint32_t j = 0; j < BENCH_REGS_BATCH; j++)
+            batch[j] = (ati_reg_pair_t) {GUI_SCRATCH_REG0, i + j};
+        ati_reg_write_batch(dev, batch, BENCH_REGS_BATCH);
+    }
+    ati_wait_for_idle(dev);
+    print_ops("write GUI_SCRATCH_REG0", count, platform_time_ns() - start);
+    (void) sink;
+}
+
+// Write through the backend under test, read back over MMIO
+static void
+bench_regs_verify(ati_device_t *dev, ati_reg_backend_t backend)
+{
+    static const uint32_t regs[] = {BIOS_0_SCRATCH, GUI_SCRATCH_REG0};
+
+    for (size_t i = 0; i < sizeof(regs) / sizeof(regs[0]); i++) {
+        uint32_t val = 0x5a000000 | (backend << 16) | regs[i];
+        ati_reg_set_backend(dev, backend);
+        ati_reg_write(dev, regs[i], val);
+        ati_wait_for_idle(dev);
+        ati_reg_set_backend(dev, ATI_REG_MMIO);
+        uint32_t got = ati_reg_read(dev, regs[i]);
+        if (got != val) {
+            printf("  WARNING: 0x%04x wrote 0x%08x, read 0x%08x\n", regs[i],
+                   val, got);
+        }
+    }
+}
+
+static void
+bench_regs(ati_device_t *dev, int argc, char **args)
+{
+    static const ati_reg_backend_t backends[] = {
+        ATI_REG_MMIO, ATI_REG_IO, ATI_REG_INDIRECT};
+    uint32_t count = BENCH_REGS_DEFAULT;
+    if (argc >= 3 && (parse_int(args[2], &count) != 0 || count == 0)) {
+        printf("Usage: bench regs [n]\n");
+        return;
+    }
+    count = (count + BENCH_REGS_BATCH - 1) / BENCH_REGS_BATCH *
+            BENCH_REGS_BATCH;
+
+    printf("Accesses per test: %u\n", count);
+
+    // The scratch registers are shadow-cacheable; time the hardware instead
+    ati_reg_backend_t was = ati_reg_get_backend(dev);
+    bool shadow = ati_shadow_is_enabled(dev);
+    ati_shadow_enable(dev, false);
+    ati_wait_for_idle(dev);
+    uint32_t bios0 = rd_bios_0_scratch(dev);
+    uint32_t gui0 = rd_gui_scratch_reg0(dev);
+
+    for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); i++) {
+        if (!ati_reg_set_backend(dev, backends[i])) {
+            printf("%s: not available on this device\n",
+                   ati_reg_backend_name(backends[i]));
+            continue;
+        }
+        bench_regs_backend(dev, count);
+        bench_regs_verify(dev, backends[i]);
+    }
+
+    ati_reg_set_backend(dev, ATI_REG_MMIO);
+    wr_bios_0_scratch(dev, bios0);
+    wr_gui_scratch_reg0(dev, gui0);
+    ati_wait_for_idle(dev);
+    ati_reg_set_backend(dev, was);
+    ati_shadow_enable(dev, shadow);
+}
+
+// ============================================================================
+// CCE Packet Submission
+// ============================================================================
+// The same stream of type-0 packets goes through each submission path. Each
+// packet writes BIOS_0..2_SCRATCH with values that count up, so the last
+// packet's values show the whole stream was executed.
+
+#define BENCH_CCE_DEFAULT_KDW 64
+#define BENCH_CCE_PKT_DWORDS 4
+
+static uint32_t *
+bench_cce_stream(size_t packets)
+{
+    cce_stream_t s;
+    cce_stream_init(&s, (uint32_t *) bench_buf, BENCH_BUF_SIZE / 4);
+    for (uint32_t i = 0; i < packets; i++)
+        CCE_EMIT0(&s, BIOS_0_SCRATCH, 0xc0000000 | i, 0xd0000000 | i,
+                  0xe0000000 | i);
+    return s.buf;
+}
+
+// Dword and packet rates and the bandwidth they imply
+static void
+print_dwords(const char *label, size_t dwords, uint64_t ns)
+{
+    uint32_t kdw = ns ? (uint32_t) ((uint64_t) dwords * 1000000 / ns) : 0;
+    uint32_t kpkt = kdw / BENCH_CCE_PKT_DWORDS;
+    uint32_t tenths = ns ? (uint32_t) ((uint64_t) dwords * 40000 / ns) : 0;
+    printf("  %-18s %8u kdw/s %7u kpkt/s %6u.%u MB/s\n", label, kdw, kpkt,
+           tenths / 10, tenths % 10);
+}
+
+static void
+bench_cce_check(ati_device_t *dev, size_t packets)
+{
+    uint32_t last = packets - 1;
+    uint32_t got = rd_bios_0_scratch(dev);
+    if (got != (0xc0000000 | last))
+        printf("  WARNING: BIOS_0_SCRATCH is 0x%08x, expected 0x%08x\n", got,
+               0xc0000000 | last);
+}
+
+static void
+bench_cce_pio(ati_device_t *dev, const uint32_t *stream, size_t packets)
+{
+    uint32_t mode = ati_get_chip_family(dev) == CHIP_R128
+                        ? R128_PM4_BUFFER_MODE_192PIO
+                        : R100_CSQ_MODE_PIO;
+    size_t dwords = packets * BENCH_CCE_PKT_DWORDS;
+
+    ati_cce_pio_stats_t *stats = ati_device_pio_stats(dev);
+    ati_cce_pio_stats_t before = *stats;
+
+    ati_init_cce_engine(dev, mode);
+    uint64_t start = platform_time_ns();
+    ati_send_packet(dev, (uint32_t *) stream, dwords);
+    ati_cce_wait_for_idle(dev);
+    print_dwords("pio", dwords, platform_time_ns() - start);
+    ati_stop_cce_engine(dev);
+    printf("  %u FIFO status reads, %u stalls\n", stats->polls - before.polls,
+           stats->stalls - before.stalls);
+    bench_cce_check(dev, packets);
+}
+
+// Only bare metal can hand the GART bus addresses for the rings
+#ifdef PLATFORM_BAREMETAL
+static void
+bench_cce_r128_ring(ati_device_t *dev, const uint32_t *stream,
+                    size_t packets)
+{
+    ati_r128_ring_t ring;
+    size_t dwords = packets * BENCH_CCE_PKT_DWORDS;
+
+    if (!ati_r128_ring_init(dev, &ring, R128_RING_MAX_L2QW))
+        return;
+    uint64_t start = platform_time_ns();
+    bool ok = ati_r128_ring_submit(&ring, stream, dwords) &&
+              ati_r128_ring_wait_idle(&ring);
+    uint64_t ns = platform_time_ns() - start;
+    ati_r128_ring_fini(&ring);
+
+    if (!ok) {
+        printf("  ring: CCE stopped fetching\n");
+        return;
+    }
+    print_dwords("ring", dwords, ns);
+    printf("  %u commits, %u wraps, %u waits for space, rptr %s\n",
+           ring.commits, ring.wraps, ring.space_waits,
+           ring.wb_ok ? "written back" : "read over MMIO");
+    bench_cce_check(dev, packets);
+}
+
+static void
+print_r100_ring_stats(const ati_r100_ring_t *ring)
+{
+    printf("  %u WPTR writes, %u wraps, %u pad dwords, %u waits for space, "
+           "rptr %s\n",
+           ring->wptr_writes, ring->wraps, ring->pad_dwords, ring->space_waits,
+           ring->wb_ok ? "written back" : "read over MMIO");
+}
+
+// One pass copying the stream in with ati_r100_ring_submit, one building
+// each packet in place in a ring reservation
+static void
+bench_cce_r100_ring(ati_device_t *dev, const uint32_t *stream,
+                    size_t packets)
+{
+    ati_r100_ring_config_t config = ATI_R100_RING_DEFAULT_CONFIG;
+    ati_r100_ring_t ring;
+    size_t dwords = packets * BENCH_CCE_PKT_DWORDS;
+
+    config.size_l2qw = R100_RING_MAX_L2QW;
+    if (!ati_r100_ring_init(dev, &ring, &config))
+        return;
+    uint64_t start = platform_time_ns();
+    bool ok = ati_r100_ring_submit(&ring, stream, dwords) &&
+              ati_r100_ring_wait_idle(&ring);
+    uint64_t ns = platform_time_ns() - start;
+    ati_r100_ring_fini(&ring);
+
+    if (!ok) {
+        printf("  ring submit: CP stopped fetching\n");
+        return;
+    }
+    print_dwords("ring submit", dwords, ns);
+    print_r100_ring_stats(&ring);
+    bench_cce_check(dev, packets);
+
+    if (!ati_r100_ring_init(dev, &ring, &config))
+        return;
+    start = platform_time_ns();
+    for (uint32_t i = 0; i < packets; i++) {
+        cce_stream_t s;
+        if (!ati_r100_ring_begin(&ring, &s, BENCH_CCE_PKT_DWORDS)) {
+            ok = false;
+            break;
+        }
+        CCE_EMIT0(&s, BIOS_0_SCRATCH, 0xc0000000 | i, 0xd0000000 | i,
+                  0xe0000000 | i);
+        ati_r100_ring_end(&ring, &s);
+    }
+    ok = ok && ati_r100_ring_wait_idle(&ring);
+    ns = platform_time_ns() - start;
+    ati_r100_ring_fini(&ring);
+
+    if (!ok) {
+        printf("  ring reserve: CP stopped fetching\n");
+        return;
+    }
+    print_dwords("ring reserve", dwords, ns);
+    print_r100_ring_stats(&ring);
+    bench_cce_check(dev, packets);
+}
+#endif
+
+// Stream size from the optional kdw argument, capped to the buffer
+static bool
+bench_cce_packets(int argc, char **args, const char *usage, size_t *packets)
+{
+    uint32_t kdw = BENCH_CCE_DEFAULT_KDW;
+    if (argc >= 3 && (parse_int(args[2], &kdw) != 0 || kdw == 0)) {
+        printf("Usage: %s [kdw]\n", usage);
+        return false;
+    }
+
+    *packets = (size_t) kdw * 1024 / BENCH_CCE_PKT_DWORDS;
+    if (*packets * BENCH_CCE_PKT_DWORDS * 4 > BENCH_BUF_SIZE)
+        *packets = BENCH_BUF_SIZE / 4 / BENCH_CCE_PKT_DWORDS;
+    printf("Stream: %zu packets, %zu KB\n", *packets,
+           *packets * BENCH_CCE_PKT_DWORDS * 4 / 1024);
+    return true;
+}
+
+static void
+bench_cce(ati_device_t *dev, int argc, char **args)
+{
+    size_t packets;
+    if (!bench_cce_packets(argc, args, "bench cce", &packets))
+        return;
+    const uint32_t *stream = bench_cce_stream(packets);
+
+    ati_wait_for_idle(dev);
+    uint32_t scratch[3] = {rd_bios_0_scratch(dev), rd_bios_1_scratch(dev),
+                           rd_bios_2_scratch(dev)};
+
+    bench_cce_pio(dev, stream, packets);
+#ifdef PLATFORM_BAREMETAL
+    if (ati_get_chip_family(dev) == CHIP_R128)
+        bench_cce_r128_ring(dev, stream, packets);
+    else
+        bench_cce_r100_ring(dev, stream, packets);
+#else
+    printf("  ring: bare metal only\n");
+#endif
+
+    wr_bios_0_scratch(dev, scratch[0]);
+    wr_bios_1_scratch(dev, scratch[1]);
+    wr_bios_2_scratch(dev, scratch[2]);
+}
+
+// The same stream split into indirect buffers of each size, chained from
+// a ring whose write pointer only moves every half ring or at the end
+static void
+bench_ib(ati_device_t *dev, int argc, char **args)
+{
+    static const uint32_t sizes[] = {16, 64, 256, 1024, 4096, 16384};
+
+    if (ati_get_chip_family(dev) != CHIP_R100) {
+        printf("Indirect buffers are R100 only\n");
+        return;
+    }
+#ifndef PLATFORM_BAREMETAL
+    // They're pointers into gart_mem, which isn't bus addressable here
+    printf("Indirect buffers are bare metal only\n");
+    return;
+#endif
+    size_t packets;
+    if (!bench_cce_packets(argc, args, "bench ib", &packets))
+        return;
+    const uint32_t *stream = bench_cce_stream(packets);
+    size_t dwords = packets * BENCH_CCE_PKT_DWORDS;
+
+    ati_wait_for_idle(dev);
+    uint32_t scratch[3] = {rd_bios_0_scratch(dev), rd_bios_1_scratch(dev),
+                           rd_bios_2_scratch(dev)};
+
+    ati_r100_ring_config_t config = ATI_R100_RING_DEFAULT_CONFIG;
+    config.wptr_batch = UINT32_MAX;
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        ati_r100_ring_t ring;
+        ati_r100_ib_pool_t pool;
+
+        if (!ati_r100_ring_init(dev, &ring, &config))
+            break;
+        ati_r100_ib_pool_init(&pool, &ring);
+        uint64_t start = platform_time_ns();
+        bool ok = ati_r100_ib_submit_stream(&pool, stream, dwords, sizes[i]) &&
+                  ati_r100_ib_wait_idle(&pool);
+        uint64_t ns = platform_time_ns() - start;
+        ati_r100_ib_pool_fini(&pool);
+        ati_r100_ring_fini(&ring);
+
+        char label[24];
+        snprintf(label, sizeof(label), "ib %u dw", sizes[i]);
+        if (!ok) {
+            printf("  %s: CP stopped executing\n", label);
+            break;
+        }
+        print_dwords(label, dwords, ns);
+        printf("  %u IBs, %u WPTR writes, %u waits for pool space\n",
+               pool.submitted, ring.wptr_writes, pool.pool_waits);
+        bench_cce_check(dev, packets);
+    }
+
+    wr_bios_0_scratch(dev, scratch[0]);
+    wr_bios_1_scratch(dev, scratch[1]);
+    wr_bios_2_scratch(dev, scratch[2]);
+}
+
+// Public functions
+
+void
+bench_cmd_help(void)
+{
+    for (int i = 0; bench_cmd_table[i].name != NULL; i++) {
+        // Print command name (bold)
+        printf("  \x1b[1m%-8s\x1b[0m", bench_cmd_table[i].name);
+
+        // Print usage args (colored) or padding
+        if (bench_cmd_table[i].usage) {
+            print_usage_colored(bench_cmd_table[i].usage);
+            int len = strlen(bench_cmd_table[i].usage);
+            for (int j = len; j < 22; j++)
+                printf(" ");
+        } else {
+            printf("%-22s", "");
+        }
+
+        // Print description
+        printf("\x1b[90m\xe2\x80\xba\x1b[0m %s\n", bench_cmd_table[i].desc);
+    }
+}
+
+void
+cmd_bench(ati_device_t *dev, int argc, char **args)
+{
+    if (argc < 2) {
+        bench_cmd_help();
+        return;
+    }
+
+    switch (lookup_bench_cmd(args[1])) {
+    case BENCH_CMD_VRAM:
+        bench_vram(dev, argc, args);
+        break;
+    case BENCH_CMD_REGS:
+        bench_regs(dev, argc, args);
+        break;
+    case BENCH_CMD_CCE:
+        bench_cce(dev, argc, args);
+        break;
+    case BENCH_CMD_IB:
+        bench_ib(dev, argc, args);
+        break;
+    case BENCH_CMD_UNKNOWN:
+        printf("Unknown bench command: %s\n", args[1]);
+        break;
+    }
+}
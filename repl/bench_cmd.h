@@ -0,0 +1,10 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#ifndef BENCH_CMD_H
+#define BENCH_CMD_H
+
+#include "../ati/ati.h"
+
+void cmd_bench(ati_device_t *dev, int argc, char **args);
+void bench_cmd_help(void);
+
+#endif
@@ -11,6 +11,7 @@ typedef enum {
     CCE_CMD_DUMP,
     CCE_CMD_R,
     CCE_CMD_W,
+    CCE_CMD_STATS,
     CCE_CMD_UNKNOWN
 } cce_cmd_t;
 
@@ -25,12 +26,13 @@ static const struct {
     const char *usage;
     const char *desc;
 } cce_cmd_table[] = {
-    {"init",    CCE_CMD_INIT,    NULL,              "full CCE init (load + mode + start)"},
+    {"init",    CCE_CMD_INIT,    NULL,              "CCE init (load if changed + mode + start)"},
     {"start",   CCE_CMD_START,   NULL,              "start microengine"},
     {"stop",    CCE_CMD_STOP,    NULL,              "stop microengine"},
     {"dump",    CCE_CMD_DUMP,    NULL,              "dump all 256 instructions"},
     {"r",       CCE_CMD_R,       "<addr> [count]",  "read instruction(s) (0-255)"},
     {"w",       CCE_CMD_W,       "<addr> <h> <l>",  "write instruction"},
+    {"stats",   CCE_CMD_STATS,   "[reset]",         "PIO rate, FIFO stalls, microcode loads"},
     {NULL,      CCE_CMD_UNKNOWN, NULL,              NULL}
 };
 // clang-format on
@@ -192,9 +194,9 @@ cce_write(ati_device_t *dev, int argc, char **args)
 
     // Read back to verify
     uint64_t test = 0;
+    ati_read_microcode(dev, addr, &test);
     uint32_t read_high = test >> 32;
     uint32_t read_low = test;
-    ati_read_microcode(dev, addr, &test);
 
     // Check for mismatch
     if (high != read_high || low != read_low) {
@@ -213,6 +215,31 @@ cce_write(ati_device_t *dev, int argc, char **args)
     }
 }
 
+static void
+cce_stats(ati_device_t *dev, int argc, char **args)
+{
+    ati_cce_pio_stats_t *stats = ati_device_pio_stats(dev);
+    ati_microcode_state_t *ucode = ati_device_microcode(dev);
+
+    if (argc >= 3 && strcmp(args[2], "reset") == 0) {
+        *stats = (ati_cce_pio_stats_t) {0};
+        ucode->loads = ucode->skips = ucode->mismatches = 0;
+        return;
+    }
+
+    uint32_t rate = stats->ns ? (uint32_t) (stats->dwords * 1000000 /
+                                            stats->ns)
+                              : 0;
+    printf("PIO: %u kdw in %u ms, %u kdw/s\n",
+           (uint32_t) (stats->dwords / 1024),
+           (uint32_t) (stats->ns / 1000000), rate);
+    printf("  %u FIFO status reads, %u stalls\n", stats->polls,
+           stats->stalls);
+    printf("Microcode: %s, %u loads, %u skipped, %u readback mismatches\n",
+           ucode->valid ? "resident" : "unknown", ucode->loads, ucode->skips,
+           ucode->mismatches);
+}
+
 // Public functions
 void
 cce_cmd_help(void)
@@ -263,6 +290,9 @@ cmd_cce(ati_device_t *dev, int argc, char **args)
     case CCE_CMD_W:
         cce_write(dev, argc, args);
         break;
+    case CCE_CMD_STATS:
+        cce_stats(dev, argc, args);
+        break;
     case CCE_CMD_UNKNOWN:
         printf("Unknown cce command: %s\n", args[1]);
         break;
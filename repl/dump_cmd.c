@@ -15,7 +15,7 @@ static const struct {
     const char *usage;
     const char *desc;
 } dump_cmd_table[] = {
-    {"screen", DUMP_CMD_SCREEN, "[filename]", "dump visible framebuffer (640x480x4)"},
+    {"screen", DUMP_CMD_SCREEN, "[filename]", "dump visible framebuffer (current mode)"},
     {"vram",   DUMP_CMD_VRAM,   "[filename]", "dump full VRAM"},
     {NULL,     DUMP_CMD_UNKNOWN, NULL,        NULL}
 };
@@ -39,63 +39,80 @@ lookup_pkt_cmd(const char *name)
 
 // Subcommand handlers
 static void
-pkt_0(ati_device_t *dev, int argc, char **args)
+pkt_0_send(ati_device_t *dev, int argc, char **args, pkt_cmd_t cmd,
+           uint32_t flags)
 {
     int addr;
-    uint32_t packet[16];
-    uint32_t dwords = 1;
+    uint32_t values[15];
+    uint32_t count = 0;
+    uint32_t buf[16];
+    cce_stream_t s;
 
-    if (argc < 4 || (addr = parse_reg(dev, args[2])) == -1) {
-        print_usage_colored(pkt_cmd_table[PKT_CMD_0].usage);
+    if (argc < 4 || argc - 3 > 15 || (addr = parse_reg(dev, args[2])) == -1) {
+        print_usage_colored(pkt_cmd_table[cmd].usage);
         return;
     }
 
     for (int i = 3; i < argc; i++) {
-        if (parse_int(args[i], &packet[i - 2]) == -1) {
-            print_usage_colored(pkt_cmd_table[PKT_CMD_0].usage);
+        if (parse_int(args[i], &values[count++]) == -1) {
+            print_usage_colored(pkt_cmd_table[cmd].usage);
+            return;
         }
-        dwords += 1;
     }
 
-    packet[0] = CCE_PKT0(addr, dwords - 1);
+    cce_stream_init(&s, buf, 16);
+    cce_emit_pkt0_data(&s, addr, flags, values, count);
+    ati_send_stream(dev, &s);
+}
 
-    ati_send_packet(dev, packet, dwords);
+static void
+pkt_0(ati_device_t *dev, int argc, char **args)
+{
+    pkt_0_send(dev, argc, args, PKT_CMD_0, 0);
 }
 
 static void
 pkt_0_one(ati_device_t *dev, int argc, char **args)
 {
-    int addr;
-    uint32_t packet[16];
-    uint32_t dwords = 1;
-
-    if (argc < 4 || (addr = parse_reg(dev, args[2])) == -1) {
-        print_usage_colored(pkt_cmd_table[PKT_CMD_0].usage);
-        return;
-    }
-
-    for (int i = 3; i < argc; i++) {
-        if (parse_int(args[i], &packet[i - 2]) == -1) {
-            print_usage_colored(pkt_cmd_table[PKT_CMD_0].usage);
-        }
-        dwords += 1;
-    }
-
-    packet[0] = CCE_PKT0_ONE(addr, dwords - 1);
-
-    ati_send_packet(dev, packet, dwords);
+    pkt_0_send(dev, argc, args, PKT_CMD_0_ONE, CCE_PACKET0_ONE_REG);
 }
 
 static void
 pkt_1(ati_device_t *dev, int argc, char **args)
 {
+    int reg0, reg1;
+    uint32_t val0, val1;
+    uint32_t buf[3];
+    cce_stream_t s;
+
+    if (argc < 6 || (reg0 = parse_reg(dev, args[2])) == -1 ||
+        parse_int(args[3], &val0) == -1 ||
+        (reg1 = parse_reg(dev, args[4])) == -1 ||
+        parse_int(args[5], &val1) == -1) {
+        print_usage_colored(pkt_cmd_table[PKT_CMD_1].usage);
+        return;
+    }
+    if (reg0 >= CCE_PKT1_REG_LIMIT || reg1 >= CCE_PKT1_REG_LIMIT) {
+        printf("Type 1 packets only reach registers below 0x%x\n",
+               CCE_PKT1_REG_LIMIT);
+        return;
+    }
+
+    cce_stream_init(&s, buf, 3);
+    cce_emit_pkt1(&s, reg0, val0, reg1, val1);
+    ati_send_stream(dev, &s);
 }
 
 static void
 pkt_2(ati_device_t *dev)
 {
-}
+    uint32_t buf[1];
+    cce_stream_t s;
 
+    cce_stream_init(&s, buf, 1);
+    cce_emit_pkt2(&s);
+    ati_send_stream(dev, &s);
+}
 
 void
 pkt_cmd_help(void)
@@ -4,6 +4,10 @@
 #include "pkt_cmd.h"
 #include "../tests/test.h"
 #include "dump_cmd.h"
+#include "bench_cmd.h"
+#include "trace_cmd.h"
+#include "../ati/snapshot.h"
+#include "../ati/wait.h"
 #include "../platform/platform.h"
 
 // ANSI color codes
@@ -63,9 +67,11 @@ typedef enum {
     CMD_W,
     CMD_VR,
     CMD_VW,
+    CMD_VS,
     CMD_PR,
     CMD_PW,
     CMD_CLR,
+    CMD_MODE,
     CMD_MR,
     CMD_T,
     CMD_TL,
@@ -73,6 +79,9 @@ typedef enum {
     CMD_PKT,
     CMD_REGS,
     CMD_DUMP,
+    CMD_BENCH,
+    CMD_TRACE,
+    CMD_WAITS,
     CMD_HELP,
     CMD_UNKNOWN
 } cmd_t;
@@ -85,22 +94,27 @@ static const struct {
     const char *desc;
 } cmd_table[] = {
     {"reboot",   CMD_REBOOT,   NULL,                     "reboot system (baremetal)"},
-    {"info",     CMD_INFO,     NULL,                     "display system info"},
+    {"info",     CMD_INFO,     "[probe]",                "display system info (probe: re-read layout)"},
     {"r",        CMD_R,        "<addr|reg>",             "register read"},
     {"rx",       CMD_RX,       "<addr|reg>",             "register read (expanded)"},
     {"w",        CMD_W,        "<addr|reg> <val>",       "register write"},
     {"vr",       CMD_VR,       "<offset> [count]",       "vram read"},
     {"vw",       CMD_VW,       "<offset> <val> [count]", "vram write"},
+    {"vs",       CMD_VS,       "<pat,...> [start] [end]", "vram search (pat = val[/mask])"},
     {"pr",       CMD_PR,       "<pixel> [count]",        "pixel read"},
     {"pw",       CMD_PW,       "<pixel> <val> [count]",  "pixel write"},
     {"clr",      CMD_CLR,      "[color]",                "clear the screen"},
+    {"mode",     CMD_MODE,     "[WxHxBPP]",              "list or set the display mode"},
     {"mr",       CMD_MR,       "<addr> [count]",         "system memory read"},
     {"t",        CMD_T,        "[test_name]",            "run test(s)"},
     {"tl",       CMD_TL,       NULL,                     "list tests"},
     {"cce",      CMD_CCE,      "<cmd>",                  "CCE control (init/start/stop/r/w)"},
     {"pkt",      CMD_PKT,      "<type>",                 "Send packet"},
-    {"regs",     CMD_REGS,     "<save|diff> [all]",      "register snapshot/diff (all=full aperture)"},
+    {"regs",     CMD_REGS,     "<cmd>",                  "registers (save/diff/restore/hot/shadow/backend)"},
     {"dump",     CMD_DUMP,     "<cmd>",                  "dump data (screen/vram)"},
+    {"bench",    CMD_BENCH,    "<cmd>",                  "benchmarks (vram/regs/cce/ib)"},
+    {"trace",    CMD_TRACE,    "<cmd>",                  "MMIO trace (status/clear/dump)"},
+    {"waits",    CMD_WAITS,    "[reset]",                "wait latency histograms"},
     {"help",     CMD_HELP,     NULL,                     NULL},
     {"?",        CMD_HELP,     NULL,                     NULL},
     {NULL,       CMD_UNKNOWN,  NULL,                     NULL}
@@ -225,6 +239,10 @@ print_flags(uint8_t flags)
         printf(C_CYAN "%sno-write" C_RESET, first ? "" : ", ");
         first = false;
     }
+    if (flags & FLAG_SHADOW) {
+        printf(C_GREEN "%sshadow" C_RESET, first ? "" : ", ");
+        first = false;
+    }
 
     printf("]");
     return true;
@@ -690,6 +708,14 @@ cmd_help(int argc, char **args)
             dump_cmd_help();
             return;
         }
+        if (strcmp(args[1], "bench") == 0) {
+            bench_cmd_help();
+            return;
+        }
+        if (strcmp(args[1], "trace") == 0) {
+            trace_cmd_help();
+            return;
+        }
         printf("Unknown help topic: %s\n", args[1]);
         return;
     }
@@ -830,6 +856,75 @@ cmd_vram_write(ati_device_t *dev, int argc, char **args)
     }
 }
 
+// Parse "val[/mask]" into a needle. Modifies the string in place.
+static int
+parse_needle(char *s, ati_vram_needle_t *out)
+{
+    char *slash = s;
+    while (*slash && *slash != '/')
+        slash++;
+
+    out->mask = 0xffffffff;
+    if (*slash == '/') {
+        *slash = '\0';
+        if (parse_int(slash + 1, &out->mask) != 0)
+            return -1;
+    }
+    return parse_int(s, &out->value);
+}
+
+#define VS_MAX_HITS 256
+
+static void
+cmd_vram_search(ati_device_t *dev, int argc, char **args)
+{
+    ati_vram_needle_t needles[VRAM_SEARCH_MAX_NEEDLES];
+    uint32_t hits[VS_MAX_HITS];
+    uint32_t start = 0, end = ati_vram_aperture_size(dev);
+    size_t count = 0;
+
+    if (argc < 2) {
+        print_usage(CMD_VS);
+        return;
+    }
+
+    // Needles are a comma-separated list in the first argument
+    char *p = args[1];
+    while (*p) {
+        char *tok = p;
+        while (*p && *p != ',')
+            p++;
+        if (*p == ',')
+            *p++ = '\0';
+        if (count == VRAM_SEARCH_MAX_NEEDLES) {
+            printf("At most %d needles\n", VRAM_SEARCH_MAX_NEEDLES);
+            return;
+        }
+        if (parse_needle(tok, &needles[count++]) != 0) {
+            print_usage(CMD_VS);
+            return;
+        }
+    }
+    if (count == 0 || (argc >= 3 && parse_int(args[2], &start) != 0) ||
+        (argc >= 4 && parse_int(args[3], &end) != 0)) {
+        print_usage(CMD_VS);
+        return;
+    }
+
+    uint64_t t0 = platform_time_ns();
+    size_t n = ati_vram_search_range(dev, needles, count, start, end, hits,
+                                     VS_MAX_HITS);
+    uint32_t ms = (uint32_t) ((platform_time_ns() - t0) / 1000000);
+
+    for (size_t i = 0; i < n; i++)
+        print_mem(hits[i], ati_vram_read(dev, hits[i]), ':');
+    if (n == VS_MAX_HITS)
+        printf("Stopped after %d hits; continue from 0x%x\n", VS_MAX_HITS,
+               hits[n - 1] + 4);
+    else
+        printf("%zu hits in %u ms\n", n, ms);
+}
+
 static void
 cmd_pixel_read(ati_device_t *dev, int argc, char **args)
 {
@@ -899,6 +994,50 @@ cmd_clr(ati_device_t *dev, int argc, char **args)
     ati_screen_clear(dev, color);
 }
 
+// info [probe]: device summary from the properties cached at init, or
+// probe them again first and report what moved
+static void
+cmd_info(ati_device_t *dev, int argc, char **args)
+{
+    if (argc >= 2) {
+        if (strcmp(args[1], "probe") != 0) {
+            print_usage(CMD_INFO);
+            return;
+        }
+        if (!ati_device_reprobe(dev))
+            printf("Layout unchanged\n");
+        printf("\n");
+    }
+    ati_print_info(dev);
+}
+
+// mode [name]: list display modes, or switch to one and clear the screen
+static void
+cmd_mode(ati_device_t *dev, int argc, char **args)
+{
+    const ati_display_mode_t *cur = ati_get_display_mode(dev);
+
+    if (argc < 2) {
+        for (int i = 0; ati_display_modes[i].name != NULL; i++) {
+            const ati_display_mode_t *m = &ati_display_modes[i];
+            printf("  %s%-12s" C_RESET " pitch %4u, %3u.%03u MHz\n",
+                   m == cur ? C_VALUE : "", m->name, m->pitch,
+                   m->pixel_clock_khz / 1000, m->pixel_clock_khz % 1000);
+        }
+        return;
+    }
+
+    const ati_display_mode_t *mode = ati_find_display_mode(args[1]);
+    if (!mode) {
+        printf("Unknown mode: %s\n", args[1]);
+        return;
+    }
+    ati_set_display_mode(dev, mode);
+    ati_init_gui_engine(dev);
+    ati_screen_clear(dev, 0);
+    ati_capture_test_state(dev);
+}
+
 static void
 cmd_mem_read(int argc, char **args)
 {
@@ -1089,6 +1228,201 @@ regs_diff_all(ati_device_t *dev)
     }
 }
 
+// Hot-register report: the registers with the most MMIO accesses since the
+// counters were last reset (run_test resets them before every test)
+#define REG_STATS_DEFAULT_TOP 10
+#define REG_STATS_MAX_TOP 64
+
+#ifndef ATI_HOT_REGS
+#define ATI_HOT_REGS 5
+#endif
+// Room for one line of the table, colour codes included
+#define REG_STATS_LINE 128
+
+// Rows printed after each test, 0 = off. Set at build time with
+// make HOT_REGS=n and changed at the console with `regs hot on/off`.
+static int reg_stats_per_test = ATI_HOT_REGS;
+
+// The whole table goes into one buffer so that cards running their suites
+// in parallel print theirs in one piece
+static void
+format_reg_stats(ati_device_t *dev, int top_n, const char *label, char *buf,
+                 size_t size)
+{
+    uint32_t total_reads = 0, total_writes = 0;
+    uint32_t top[REG_STATS_MAX_TOP], top_count[REG_STATS_MAX_TOP];
+    int n = 0;
+
+    if (top_n < 0 || top_n > REG_STATS_MAX_TOP)
+        top_n = REG_STATS_MAX_TOP;
+
+    // Insertion into a short sorted list; the aperture is only 2048 dwords
+    for (uint32_t offset = 0; offset < REG_APERTURE_SIZE; offset += 4) {
+        uint32_t rd, wr;
+        ati_reg_stats_get(dev, offset, &rd, &wr);
+        total_reads += rd;
+        total_writes += wr;
+        if (rd + wr == 0)
+            continue;
+        int i = n < top_n ? n++ : top_n;
+        while (i > 0 && top_count[i - 1] < rd + wr) {
+            if (i < top_n) {
+                top[i] = top[i - 1];
+                top_count[i] = top_count[i - 1];
+            }
+            i--;
+        }
+        if (i < top_n) {
+            top[i] = offset;
+            top_count[i] = rd + wr;
+        }
+    }
+
+    size_t len = snprintf(buf, size,
+                          C_DIM "    %sMMIO: %u reads, %u writes" C_RESET "\n",
+                          label, total_reads, total_writes);
+    for (int i = 0; i < n && len < size; i++) {
+        const reg_entry_t *reg =
+            get_chip_reg_table(dev) ? lookup_reg_by_addr(dev, top[i]) : NULL;
+        uint32_t rd, wr;
+        ati_reg_stats_get(dev, top[i], &rd, &wr);
+        len += snprintf(buf + len, size - len,
+                        "    " C_REG_NAME "%-28s" C_RESET " " C_REG_ADDR
+                        "0x%04x" C_RESET "  rd " C_VALUE "%8u" C_RESET
+                        "  wr " C_VALUE "%8u" C_RESET "\n",
+                        reg ? reg->name : "?", top[i], rd, wr);
+    }
+}
+
+void
+print_reg_stats(ati_device_t *dev, int top_n)
+{
+    char buf[(REG_STATS_MAX_TOP + 1) * REG_STATS_LINE];
+    format_reg_stats(dev, top_n, "", buf, sizeof(buf));
+    printf("%s", buf);
+}
+
+void
+report_reg_stats(ati_device_t *dev, bool tagged)
+{
+    char buf[(REG_STATS_MAX_TOP + 1) * REG_STATS_LINE];
+    char label[64] = "";
+
+    if (reg_stats_per_test <= 0)
+        return;
+    if (tagged) {
+        snprintf(label, sizeof(label), "[card%d %s] ", ati_device_index(dev),
+                 ati_device_location(dev));
+    }
+    format_reg_stats(dev, reg_stats_per_test, label, buf, sizeof(buf));
+    printf("%s", buf);
+}
+
+static void
+regs_hot(ati_device_t *dev, int argc, char **args)
+{
+    uint32_t top_n = REG_STATS_DEFAULT_TOP;
+
+    if (argc >= 3 && strcmp(args[2], "on") == 0) {
+        if (argc >= 4 && parse_int(args[3], &top_n) != 0)
+            top_n = REG_STATS_DEFAULT_TOP;
+        if (top_n > REG_STATS_MAX_TOP)
+            top_n = REG_STATS_MAX_TOP;
+        reg_stats_per_test = top_n;
+        printf("Reporting top %u registers after each test\n", top_n);
+        return;
+    }
+    if (argc >= 3 && strcmp(args[2], "off") == 0) {
+        reg_stats_per_test = 0;
+        return;
+    }
+    if (argc >= 3 && parse_int(args[2], &top_n) != 0) {
+        print_usage(CMD_REGS);
+        return;
+    }
+    print_reg_stats(dev, top_n);
+}
+
+// waits [reset]: per-site wait latency histograms
+static void
+cmd_waits(int argc, char **args)
+{
+    if (argc >= 2 && strcmp(args[1], "reset") == 0) {
+        ati_wait_stats_reset();
+        return;
+    }
+    if (argc >= 2) {
+        print_usage(CMD_WAITS);
+        return;
+    }
+    ati_wait_stats_print();
+}
+
+// regs shadow [on|off|reset]: control the shadow register cache
+static void
+regs_shadow(ati_device_t *dev, int argc, char **args)
+{
+    if (argc >= 3) {
+        if (strcmp(args[2], "on") == 0) {
+            ati_shadow_enable(dev, true);
+        } else if (strcmp(args[2], "off") == 0) {
+            ati_shadow_enable(dev, false);
+        } else if (strcmp(args[2], "reset") == 0) {
+            ati_shadow_reset_stats(dev);
+        } else {
+            printf("Usage: regs shadow [on|off|reset]\n");
+            return;
+        }
+    }
+
+    ati_shadow_stats_t st;
+    ati_shadow_get_stats(dev, &st);
+    printf("Shadow cache %s\n", ati_shadow_is_enabled(dev) ? "on" : "off");
+    printf("  reads:  %u hits, %u misses\n", st.read_hits, st.read_misses);
+    printf("  writes: %u dropped, %u written\n", st.write_drops, st.writes);
+}
+
+// regs backend [mmio|io|indirect]: choose how registers are reached
+static void
+regs_backend(ati_device_t *dev, int argc, char **args)
+{
+    static const ati_reg_backend_t backends[] = {
+        ATI_REG_MMIO, ATI_REG_IO, ATI_REG_INDIRECT};
+
+    if (argc >= 3) {
+        size_t i;
+        for (i = 0; i < sizeof(backends) / sizeof(backends[0]); i++) {
+            if (strcmp(args[2], ati_reg_backend_name(backends[i])) == 0)
+                break;
+        }
+        if (i == sizeof(backends) / sizeof(backends[0])) {
+            printf("Usage: regs backend [mmio|io|indirect]\n");
+            return;
+        }
+        if (!ati_reg_set_backend(dev, backends[i])) {
+            printf("No usable I/O BAR on this device\n");
+            return;
+        }
+    }
+    printf("Register backend: %s\n",
+           ati_reg_backend_name(ati_reg_get_backend(dev)));
+}
+
+// regs restore: put back the state tests start from, black screen included
+static void
+regs_restore(ati_device_t *dev)
+{
+    ati_snapshot_stats_t st;
+
+    ati_wait_for_idle(dev);
+    ati_restore_test_state(dev, &st);
+    printf("Registers: %u checked, %u written\n", st.regs_checked,
+           st.regs_written);
+    if (st.vram_checked)
+        printf("VRAM: %u dwords checked, %u written\n", st.vram_checked,
+               st.vram_written);
+}
+
 static void
 cmd_regs(ati_device_t *dev, int argc, char **args)
 {
@@ -1109,6 +1443,14 @@ cmd_regs(ati_device_t *dev, int argc, char **args)
             regs_diff_all(dev);
         else
             regs_diff(dev);
+    } else if (strcmp(args[1], "hot") == 0) {
+        regs_hot(dev, argc, args);
+    } else if (strcmp(args[1], "shadow") == 0) {
+        regs_shadow(dev, argc, args);
+    } else if (strcmp(args[1], "restore") == 0) {
+        regs_restore(dev);
+    } else if (strcmp(args[1], "backend") == 0) {
+        regs_backend(dev, argc, args);
     } else {
         print_usage(CMD_REGS);
     }
@@ -1157,7 +1499,7 @@ repl(ati_device_t *dev)
             cmd_reboot();
             break;
         case CMD_INFO:
-            ati_print_info(dev);
+            cmd_info(dev, argc, args);
             break;
         case CMD_R:
             cmd_reg_read(dev, argc, args);
@@ -1174,6 +1516,9 @@ repl(ati_device_t *dev)
         case CMD_VW:
             cmd_vram_write(dev, argc, args);
             break;
+        case CMD_VS:
+            cmd_vram_search(dev, argc, args);
+            break;
         case CMD_PR:
             cmd_pixel_read(dev, argc, args);
             break;
@@ -1183,6 +1528,9 @@ repl(ati_device_t *dev)
         case CMD_CLR:
             cmd_clr(dev, argc, args);
             break;
+        case CMD_MODE:
+            cmd_mode(dev, argc, args);
+            break;
         case CMD_MR:
             cmd_mem_read(argc, args);
             break;
@@ -1204,6 +1552,15 @@ repl(ati_device_t *dev)
         case CMD_DUMP:
             cmd_dump(dev, argc, args);
             break;
+        case CMD_BENCH:
+            cmd_bench(dev, argc, args);
+            break;
+        case CMD_TRACE:
+            cmd_trace(dev, argc, args);
+            break;
+        case CMD_WAITS:
+            cmd_waits(argc, args);
+            break;
         case CMD_HELP:
             cmd_help(argc, args);
             break;
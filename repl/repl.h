@@ -7,6 +7,12 @@
 
 void repl(ati_device_t *dev);
 
+// Per-register MMIO access report (see ati_reg_stats_get)
+void print_reg_stats(ati_device_t *dev, int top_n);
+// After each test unless built with HOT_REGS=0 or turned off at the console;
+// tagged adds the card to the summary line for parallel runs
+void report_reg_stats(ati_device_t *dev, bool tagged);
+
 // Parsing utilities
 int parse_hex(const char *s, uint32_t *out);
 int parse_int(const char *s, uint32_t *out);
@@ -0,0 +1,85 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "trace_cmd.h"
+#include "repl.h"
+#include "../ati/trace.h"
+
+typedef enum {
+    TRACE_CMD_STATUS,
+    TRACE_CMD_CLEAR,
+    TRACE_CMD_DUMP,
+    TRACE_CMD_UNKNOWN
+} trace_cmd_t;
+
+// clang-format off
+static const struct {
+    const char *name;
+    trace_cmd_t cmd;
+    const char *usage;
+    const char *desc;
+} trace_cmd_table[] = {
+    {"status", TRACE_CMD_STATUS,  NULL,         "show ring buffer fill level"},
+    {"clear",  TRACE_CMD_CLEAR,   NULL,         "discard recorded entries"},
+    {"dump",   TRACE_CMD_DUMP,    "[filename]", "send the trace (decode with bin/trace-decode)"},
+    {NULL,     TRACE_CMD_UNKNOWN, NULL,         NULL}
+};
+// clang-format on
+
+static trace_cmd_t
+lookup_trace_cmd(const char *name)
+{
+    for (int i = 0; trace_cmd_table[i].name != NULL; i++) {
+        if (strcmp(name, trace_cmd_table[i].name) == 0)
+            return trace_cmd_table[i].cmd;
+    }
+    return TRACE_CMD_UNKNOWN;
+}
+
+// Public functions
+
+void
+trace_cmd_help(void)
+{
+    for (int i = 0; trace_cmd_table[i].name != NULL; i++) {
+        // Print command name (bold)
+        printf("  \x1b[1m%-8s\x1b[0m", trace_cmd_table[i].name);
+
+        // Print usage args (colored) or padding
+        if (trace_cmd_table[i].usage) {
+            print_usage_colored(trace_cmd_table[i].usage);
+            int len = strlen(trace_cmd_table[i].usage);
+            for (int j = len; j < 22; j++)
+                printf(" ");
+        } else {
+            printf("%-22s", "");
+        }
+
+        // Print description
+        printf("\x1b[90m\xe2\x80\xba\x1b[0m %s\n", trace_cmd_table[i].desc);
+    }
+}
+
+void
+cmd_trace(ati_device_t *dev, int argc, char **args)
+{
+    (void) dev;
+
+    if (argc < 2) {
+        trace_cmd_help();
+        return;
+    }
+
+    switch (lookup_trace_cmd(args[1])) {
+    case TRACE_CMD_STATUS:
+        ati_trace_print_status();
+        break;
+    case TRACE_CMD_CLEAR:
+        ati_trace_clear();
+        break;
+    case TRACE_CMD_DUMP:
+        ati_trace_dump(argc >= 3 ? args[2] : "mmio_trace.rle");
+        break;
+    case TRACE_CMD_UNKNOWN:
+        printf("Unknown trace command: %s\n", args[1]);
+        break;
+    }
+}
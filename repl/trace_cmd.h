@@ -0,0 +1,10 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#ifndef TRACE_CMD_H
+#define TRACE_CMD_H
+
+#include "../ati/ati.h"
+
+void cmd_trace(ati_device_t *dev, int argc, char **args);
+void trace_cmd_help(void);
+
+#endif
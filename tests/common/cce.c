@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "../../ati/ati.h"
+#include "../../ati/cce.h"
+#include "../test.h"
+
+// Many times either command FIFO, so submission has to wait for room
+#define PIO_STREAM_DWORDS 2048
+
+bool
+test_pio_fifo_credits(ati_device_t *dev)
+{
+    bool r128 = ati_get_chip_family(dev) == CHIP_R128;
+    uint32_t fifo_depth = r128 ? 192 : 64;
+    ati_cce_pio_stats_t *stats = ati_device_pio_stats(dev);
+    uint32_t buf[PIO_STREAM_DWORDS];
+    cce_stream_t s;
+
+    cce_stream_init(&s, buf, PIO_STREAM_DWORDS);
+    for (uint32_t i = 0; i < PIO_STREAM_DWORDS / 4; i++)
+        CCE_EMIT0(&s, BIOS_0_SCRATCH, 0xc0000000 | i, 0xd0000000 | i,
+                  0xe0000000 | i);
+    ASSERT_EQ(s.dwords, PIO_STREAM_DWORDS);
+
+    ati_init_cce_engine(dev, r128 ? R128_PM4_BUFFER_MODE_192PIO
+                                  : R100_CSQ_MODE_PIO);
+    ati_cce_pio_stats_t before = *stats;
+    ASSERT_TRUE(ati_send_stream(dev, &s));
+    ati_cce_wait_for_idle(dev);
+    ati_stop_cce_engine(dev);
+
+    // Nothing was dropped on a full FIFO
+    ASSERT_EQ(rd_bios_0_scratch(dev), 0xc00001ff);
+    ASSERT_EQ(rd_bios_1_scratch(dev), 0xd00001ff);
+    ASSERT_EQ(rd_bios_2_scratch(dev), 0xe00001ff);
+    ASSERT_EQ(stats->dwords - before.dwords, PIO_STREAM_DWORDS);
+    // The status register is read once per FIFO's worth, plus once more
+    // for every time it filled up, not once per dword
+    uint32_t polls = stats->polls - before.polls;
+    uint32_t stalls = stats->stalls - before.stalls;
+    ASSERT_TRUE(polls <= PIO_STREAM_DWORDS / fifo_depth + 1 + stalls);
+
+    return true;
+}
+
+bool
+test_packet_encoding(ati_device_t *dev)
+{
+    ati_cce_pio_stats_t *stats = ati_device_pio_stats(dev);
+    uint32_t buf[4];
+    cce_stream_t s;
+
+    cce_stream_init(&s, buf, 4);
+    CCE_EMIT1(&s, BIOS_0_SCRATCH, 0x11111111, BIOS_1_SCRATCH, 0x22222222);
+    ASSERT_EQ(s.dwords, 3);
+    ASSERT_EQ(buf[0], 0x40002804);
+    ASSERT_EQ(buf[1], 0x11111111);
+    ASSERT_EQ(buf[2], 0x22222222);
+    ASSERT_TRUE(!s.overflow);
+
+    // A register only known at run time is checked as it's emitted
+    volatile uint32_t far_reg = CCE_PKT1_REG_LIMIT;
+    cce_stream_init(&s, buf, 4);
+    CCE_EMIT1(&s, far_reg, 0, BIOS_0_SCRATCH, 0);
+    ASSERT_EQ(s.dwords, 0);
+    ASSERT_TRUE(s.overflow);
+
+    cce_stream_init(&s, buf, 4);
+    CCE_EMIT3(&s, CCE_NOP, 0x33333333, 0x44444444);
+    ASSERT_EQ(s.dwords, 3);
+    ASSERT_EQ(buf[0], 0xc0011000);
+    ASSERT_EQ(cce_packet_dwords(buf[0]), 3);
+    ASSERT_TRUE(!s.overflow);
+
+    // The second packet doesn't fit, so the whole stream is refused
+    CCE_EMIT3(&s, CCE_NOP, 0x55555555, 0x66666666);
+    ASSERT_EQ(s.dwords, 3);
+    ASSERT_TRUE(s.overflow);
+    uint64_t dwords = stats->dwords;
+    ASSERT_TRUE(!ati_send_stream(dev, &s));
+    ASSERT_TRUE(stats->dwords == dwords);
+
+    return true;
+}
+
+void
+register_cce_tests(void)
+{
+    REGISTER_TEST(test_pio_fifo_credits, "pio fifo credits");
+    REGISTER_TEST(test_packet_encoding, "packet encoding");
+}
@@ -0,0 +1,103 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#include "../../ati/ati.h"
+#include "../../ati/surface.h"
+#include "../test.h"
+
+#define HEAP_BLOCK 4096
+
+bool
+test_vram_heap(ati_device_t *dev)
+{
+    uint32_t empty, free_bytes, largest;
+    uint32_t block[3];
+
+    // Every test starts with the heap empty
+    ati_vram_heap_usage(dev, &empty, &largest);
+    ASSERT_EQ(largest, empty);
+    ASSERT_TRUE(empty >= 8 * HEAP_BLOCK);
+
+    for (int i = 0; i < 3; i++) {
+        block[i] = ati_vram_alloc(dev, HEAP_BLOCK, ATI_SURFACE_ALIGN);
+        ASSERT_NEQ(block[i], ATI_VRAM_NONE);
+        ASSERT_EQ(block[i] & (ATI_SURFACE_ALIGN - 1), 0);
+    }
+    ASSERT_EQ(block[1], block[0] + HEAP_BLOCK);
+    ASSERT_EQ(block[2], block[1] + HEAP_BLOCK);
+
+    // Freeing the middle block leaves a hole smaller than the tail
+    ati_vram_free(dev, block[1]);
+    ati_vram_heap_usage(dev, &free_bytes, &largest);
+    ASSERT_EQ(free_bytes, empty - 2 * HEAP_BLOCK);
+    ASSERT_EQ(largest, empty - 3 * HEAP_BLOCK);
+
+    // First fit skips the hole for anything bigger and reuses it otherwise
+    uint32_t big = ati_vram_alloc(dev, 2 * HEAP_BLOCK, ATI_SURFACE_ALIGN);
+    ASSERT_EQ(big, block[2] + HEAP_BLOCK);
+    uint32_t small = ati_vram_alloc(dev, HEAP_BLOCK / 2, ATI_SURFACE_ALIGN);
+    ASSERT_EQ(small, block[1]);
+    uint32_t rest = ati_vram_alloc(dev, HEAP_BLOCK / 2, HEAP_BLOCK);
+    ASSERT_NEQ(rest, ATI_VRAM_NONE);
+    ASSERT_EQ(rest & (HEAP_BLOCK - 1), 0);
+    ati_vram_heap_usage(dev, &free_bytes, &largest);
+    ASSERT_EQ(free_bytes, empty - 5 * HEAP_BLOCK);
+
+    // Nothing larger than the free space, and nothing past the block table
+    ASSERT_EQ(ati_vram_alloc(dev, empty, 1), ATI_VRAM_NONE);
+    ati_vram_heap_reset(dev);
+    for (int i = 0; i < ATI_VRAM_HEAP_BLOCKS; i++)
+        ASSERT_NEQ(ati_vram_alloc(dev, 64, 64), ATI_VRAM_NONE);
+    ASSERT_EQ(ati_vram_alloc(dev, 64, 64), ATI_VRAM_NONE);
+
+    ati_vram_heap_reset(dev);
+    ati_vram_heap_usage(dev, &free_bytes, &largest);
+    ASSERT_EQ(free_bytes, empty);
+
+    return true;
+}
+
+bool
+test_surface_round_trip(ati_device_t *dev)
+{
+    enum { W = 20, H = 8 };
+    static uint32_t pixels[H][W];
+    static uint32_t out[H][W];
+    ati_surface_t a, b, wide;
+
+    for (int y = 0; y < H; y++)
+        for (int x = 0; x < W; x++)
+            pixels[y][x] = 0xff000000 | (y << 16) | (x << 8) | (x ^ y);
+
+    // 80 byte rows are padded out to the pitch alignment
+    ASSERT_TRUE(ati_surface_alloc(dev, &a, W, H, 32));
+    ASSERT_EQ(a.pitch, 128);
+    ASSERT_TRUE(ati_surface_alloc(dev, &b, W, H, 32));
+    ASSERT_TRUE(b.offset >= a.offset + a.pitch * H);
+
+    ati_surface_upload(dev, &a, pixels, sizeof(pixels[0]));
+    ASSERT_TRUE(ati_surface_fill(dev, &b, 0));
+    ASSERT_TRUE(ati_surface_blit(dev, &b, 0, 0, &a, 0, 0, W, H));
+    ati_surface_readback(dev, &b, out, sizeof(out[0]));
+    for (int y = 0; y < H; y++)
+        for (int x = 0; x < W; x++)
+            ASSERT_EQ(out[y][x], pixels[y][x]);
+
+    // Non-grey 24 bpp fills go through the staging buffer a row at a time
+    ASSERT_TRUE(ati_surface_alloc(dev, &wide, 32768, 1, 24));
+    ASSERT_TRUE(!ati_surface_fill(dev, &wide, 0x123456));
+
+    ati_surface_free(dev, &wide);
+    ati_surface_free(dev, &b);
+    ati_surface_free(dev, &a);
+    uint32_t free_bytes, largest;
+    ati_vram_heap_usage(dev, &free_bytes, &largest);
+    ASSERT_EQ(free_bytes, largest);
+
+    return true;
+}
+
+void
+register_surface_tests(void)
+{
+    REGISTER_TEST(test_vram_heap, "vram heap");
+    REGISTER_TEST(test_surface_round_trip, "surface round trip");
+}
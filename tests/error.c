@@ -8,10 +8,12 @@
 #define ERROR_BUF_SIZE 4096
 #define RECORD_GROUP_SEP "\x1d" // Group Separator — delimits error records
 
-static char error_buf[ERROR_BUF_SIZE];
-static size_t error_len;
+// Per thread, so cards tested in parallel keep their failures apart
+static PLATFORM_THREAD_LOCAL char error_buf[ERROR_BUF_SIZE];
+static PLATFORM_THREAD_LOCAL size_t error_len;
 
-static char pending_dump_path[256];
+static PLATFORM_THREAD_LOCAL char pending_dump_path[256];
+static PLATFORM_THREAD_LOCAL ati_surface_t pending_dump_surf;
 
 void
 error_printf(const char *fmt, ...)
@@ -49,9 +51,10 @@ error_clear(void)
 }
 
 void
-error_set_pending_dump(const char *path)
+error_set_pending_dump(const char *path, const ati_surface_t *surf)
 {
     snprintf(pending_dump_path, sizeof(pending_dump_path), "%s", path);
+    pending_dump_surf = *surf;
 }
 
 void
@@ -60,6 +63,6 @@ error_flush_dump(ati_device_t *dev)
     if (pending_dump_path[0] == '\0')
         return;
 
-    ati_screen_dump(dev, pending_dump_path);
+    ati_surface_dump(dev, &pending_dump_surf, pending_dump_path);
     pending_dump_path[0] = '\0';
 }
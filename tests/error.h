@@ -22,11 +22,11 @@ void error_flush(void);
 /* Clear the error buffer without printing. */
 void error_clear(void);
 
-/* Schedule a screen dump to be sent after the error block.
- * The dump is deferred so it appears after the error markers. */
-void error_set_pending_dump(const char *path);
+/* Schedule a dump of surf (usually the screen) to be sent after the error
+ * block. The dump is deferred so it appears after the error markers. */
+void error_set_pending_dump(const char *path, const ati_surface_t *surf);
 
-/* Send the pending screen dump if one was scheduled, then clear it. */
+/* Send the pending dump if one was scheduled, then clear it. */
 void error_flush_dump(ati_device_t *dev);
 
 #endif
@@ -2,8 +2,12 @@
 #include "../../ati/cce.h"
 #include "../../ati/r100_cce.h"
 #include "../../ati/r100_mc.h"
+#include "../../ati/r100_ib.h"
+#include "../../ati/r100_ring.h"
 #include "../test.h"
 
+// Shared by every device like gart_mem, so only written back to under the
+// GART claim
 static volatile uint32_t mem[1024] __attribute__((aligned(0x08000000)));
 
 bool test_r100_cce_pio(ati_device_t *dev) {
@@ -316,6 +320,7 @@ bool test_r100_ring_buffer_setup(ati_device_t *dev) {
     ati_init_cce_engine(dev, R100_CSQ_MODE_BM);
     ati_r100_cce_wait_for_idle(dev);
     uint32_t gart_addr = ati_r100_init_pci_gart(dev);
+    ASSERT_NEQ(gart_addr, 0);
     ati_r100_cce_wait_for_idle(dev);
 
     // Place the ring buffer at the beginning of the gart
@@ -395,6 +400,7 @@ test_r100_indirect_buffer(ati_device_t *dev) {
     ati_init_cce_engine(dev, R100_CSQ_MODE_PIO_INDBM);
     ati_r100_cce_wait_for_idle(dev);
     uint32_t gart_addr = ati_r100_init_pci_gart(dev);
+    ASSERT_NEQ(gart_addr, 0);
     ati_r100_cce_wait_for_idle(dev);
 
     ASSERT_EQ(rd_bios_0_scratch(dev), 0);
@@ -418,6 +424,179 @@ test_r100_indirect_buffer(ati_device_t *dev) {
     return true;
 }
 
+// The ring and its writeback live in gart_mem, which only has a bus address
+// under bare metal's identity mapping
+#ifdef PLATFORM_BAREMETAL
+bool
+test_r100_cp_ring(ati_device_t *dev)
+{
+    // The smallest ring, publishing every commit
+    const ati_r100_ring_config_t config = {4, 0, 0};
+    ati_r100_ring_t ring;
+
+    wr_bios_0_scratch(dev, 0);
+    wr_bios_1_scratch(dev, 0);
+    wr_bios_2_scratch(dev, 0);
+
+    ASSERT_TRUE(ati_r100_ring_init(dev, &ring, &config));
+    ASSERT_EQ(ring.size, 32);
+
+    // Ten 3-dword packets leave 2 dwords before the end, so the eleventh
+    // reservation pads them out and starts again at 0
+    for (uint32_t i = 0; i < 12; i++) {
+        uint32_t *pkt = ati_r100_ring_reserve(&ring, 3);
+        ASSERT_TRUE(pkt != NULL);
+        pkt[0] = CCE_PKT0(BIOS_0_SCRATCH, 2);
+        pkt[1] = 0xcafe0000 | i;
+        pkt[2] = 0xbeef0000 | i;
+        ati_r100_ring_commit(&ring, 3);
+    }
+    ASSERT_EQ(ring.wraps, 1);
+    ASSERT_EQ(ring.pad_dwords, 2);
+    ASSERT_EQ(ring.wptr, 6);
+
+    // Waiting flushes, which pads to the 16-dword writeback block
+    ASSERT_TRUE(ati_r100_ring_wait_idle(&ring));
+    ASSERT_EQ(ring.wptr, 16);
+    ASSERT_EQ(ring.pad_dwords, 12);
+    ASSERT_EQ(ati_r100_ring_rptr(&ring), 16);
+    ASSERT_EQ(rd_bios_0_scratch(dev), 0xcafe000b);
+    ASSERT_EQ(rd_bios_1_scratch(dev), 0xbeef000b);
+
+    // A stream bigger than the ring is fed in as the CP drains
+    uint32_t stream[48];
+    for (uint32_t i = 0; i < 48; i += 2) {
+        stream[i] = CCE_PKT0(BIOS_2_SCRATCH, 1);
+        stream[i + 1] = 0x13370000 | i;
+    }
+    ASSERT_TRUE(ati_r100_ring_submit(&ring, stream, 48));
+    uint64_t mark = ati_r100_ring_mark(&ring);
+    ASSERT_EQ(mark, 96);
+    ASSERT_TRUE(ati_r100_ring_wait(&ring, mark));
+    ASSERT_TRUE(ati_r100_ring_done(&ring, mark));
+    ASSERT_EQ(rd_bios_2_scratch(dev), 0x1337002e);
+
+    ati_r100_ring_fini(&ring);
+    return true;
+}
+#endif
+
+// The pool, its fence and the ring are in gart_mem, and IB addresses are
+// pointers into it, so this only works with bare metal's identity mapping
+#ifdef PLATFORM_BAREMETAL
+// Bigger than the pool, so buffers have to be recycled to get through it
+static uint32_t ib_stream[64 * 1024];
+
+bool
+test_r100_ib_pool(ati_device_t *dev)
+{
+    const ati_r100_ring_config_t config = ATI_R100_RING_DEFAULT_CONFIG;
+    ati_r100_ring_t ring;
+    ati_r100_ib_pool_t pool;
+    cce_stream_t ib;
+
+    wr_bios_0_scratch(dev, 0);
+    wr_bios_1_scratch(dev, 0);
+    wr_bios_2_scratch(dev, 0);
+
+    ASSERT_TRUE(ati_r100_ring_init(dev, &ring, &config));
+    ati_r100_ib_pool_init(&pool, &ring);
+    ASSERT_TRUE(ati_r100_ib_done(&pool, 0));
+
+    // Buffers are padded to 16 dwords and packed back to back
+    uint32_t seq = 0;
+    for (uint32_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(ati_r100_ib_alloc(&pool, 3, &ib));
+        ASSERT_EQ(ib.size, 16);
+        ASSERT_TRUE(ib.buf == (uint32_t *) &gart_mem[R100_IB_POOL_PAGE *
+                                                     1024 + i * 16]);
+        CCE_EMIT0(&ib, BIOS_0_SCRATCH, 0xcafe0000 | i, 0xbeef0000 | i);
+        seq = ati_r100_ib_submit(&pool, &ib);
+        ASSERT_EQ(seq, i + 1);
+    }
+    ASSERT_EQ(pool.pad_dwords, 39);
+    ASSERT_TRUE(ati_r100_ib_wait(&pool, seq));
+    ASSERT_EQ(rd_bios_0_scratch(dev), 0xcafe0002);
+    ASSERT_EQ(rd_bios_1_scratch(dev), 0xbeef0002);
+
+    // Only one buffer can be out at a time
+    ASSERT_TRUE(ati_r100_ib_alloc(&pool, 16, &ib));
+    ASSERT_TRUE(!ati_r100_ib_alloc(&pool, 16, &ib));
+    cce_emit_pkt2(&ib);
+    ASSERT_EQ(ati_r100_ib_submit(&pool, &ib), 4);
+
+    // An overflowed buffer is refused, and its space reused
+    ASSERT_TRUE(ati_r100_ib_alloc(&pool, 16, &ib));
+    uint32_t *body = cce_emit_pkt3(&ib, CCE_NOP, 16);
+    ASSERT_TRUE(body == NULL && ib.overflow);
+    ASSERT_EQ(ati_r100_ib_submit(&pool, &ib), 0);
+
+    // A stream cut into 4 KB buffers wraps the pool
+    size_t dwords = sizeof(ib_stream) / sizeof(ib_stream[0]);
+    for (uint32_t i = 0; i < dwords; i += 2) {
+        ib_stream[i] = CCE_PKT0(BIOS_2_SCRATCH, 1);
+        ib_stream[i + 1] = 0x13370000 | i;
+    }
+    ASSERT_TRUE(ati_r100_ib_submit_stream(&pool, ib_stream, dwords, 1024));
+    ASSERT_TRUE(ati_r100_ib_wait_idle(&pool));
+    ASSERT_EQ(rd_bios_2_scratch(dev), 0x1337fffe);
+    ASSERT_EQ(pool.submitted, 4 + 64);
+    ASSERT_EQ(pool.recycled, pool.submitted);
+    ASSERT_EQ(pool.count, 0);
+    // Fences came back through the writeback, not register polls
+    ASSERT_TRUE(pool.wb_ok);
+    ASSERT_TRUE(pool.mmio_polls <= 4);
+
+    // A packet bigger than the buffers is refused
+    ib_stream[0] = CCE_PKT0(BIOS_2_SCRATCH, 32);
+    ASSERT_TRUE(!ati_r100_ib_submit_stream(&pool, ib_stream, 33, 16));
+
+    ati_r100_ib_pool_fini(&pool);
+    ati_r100_ring_fini(&ring);
+    return true;
+}
+#endif
+
+// A second init finds the microcode resident and skips the upload; an edit
+// to the instruction RAM makes the next one reload it
+bool
+test_r100_microcode_residency(ati_device_t *dev)
+{
+    ati_microcode_state_t *ucode = ati_device_microcode(dev);
+
+    ati_init_cce_engine(dev, R100_CSQ_MODE_PIO);
+    ASSERT_TRUE(ucode->valid);
+    uint32_t loads = ucode->loads;
+    uint32_t skips = ucode->skips;
+
+    ati_init_cce_engine(dev, R100_CSQ_MODE_PIO);
+    ASSERT_EQ(ucode->loads, loads);
+    ASSERT_EQ(ucode->skips, skips + 1);
+
+    // Still runs packets
+    uint32_t packet[] = {CCE_PKT0(BIOS_0_SCRATCH, 1), 0x600dc0de};
+    ati_send_packet(dev, packet, 2);
+    ati_cce_wait_for_idle(dev);
+    ASSERT_EQ(rd_bios_0_scratch(dev), 0x600dc0de);
+
+    uint64_t inst;
+    ati_stop_cce_engine(dev);
+    ASSERT_TRUE(ati_write_microcode(dev, 255, 0x0000001fdeadbeefull));
+    ASSERT_TRUE(!ucode->valid);
+    ati_read_microcode(dev, 255, &inst);
+    ASSERT_EQ(inst >> 32, 0x1f);
+    ASSERT_EQ(inst, 0xdeadbeef);
+
+    ati_init_cce_engine(dev, R100_CSQ_MODE_PIO);
+    ASSERT_EQ(ucode->loads, loads + 1);
+    ati_read_microcode(dev, 255, &inst);
+    ASSERT_EQ(inst >> 32, ati_r100_microcode_inst(255) >> 32);
+    ASSERT_EQ(inst, ati_r100_microcode_inst(255));
+    ati_stop_cce_engine(dev);
+
+    return true;
+}
+
 void
 register_r100_cce_tests(void)
 {
@@ -425,6 +604,11 @@ register_r100_cce_tests(void)
     REGISTER_TEST_FOR(test_r100_cce_mm_indirect, "cce MM_INDEX and MM_DATA", CHIP_R100);
     REGISTER_TEST_FOR(test_r100_ring_buffer_setup, "ring buffer setup", CHIP_R100);
     REGISTER_TEST_FOR(test_r100_indirect_buffer, "indirect buffer", CHIP_R100);
+#ifdef PLATFORM_BAREMETAL
+    REGISTER_TEST_FOR(test_r100_cp_ring, "cp ring", CHIP_R100);
+    REGISTER_TEST_FOR(test_r100_ib_pool, "indirect buffer pool", CHIP_R100);
+#endif
+    REGISTER_TEST_FOR(test_r100_microcode_residency, "microcode residency", CHIP_R100);
     //REGISTER_TEST_FOR(test_r100_cce_pio, "cce pio", CHIP_R100);
     //REGISTER_TEST_FOR(test_r100_cce_packet_submission, "cce packet submission", CHIP_R100);
     //REGISTER_TEST_FOR(test_r100_microcode, "microcode", CHIP_R100);
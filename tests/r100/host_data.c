@@ -91,7 +91,7 @@ draw_color_box(ati_device_t *dev, int size, int border)
 bool
 test_r100_host_data_32x32(ati_device_t *dev)
 {
-    uint32_t pitch_64 = (X_RES * BYPP) / 64;
+    uint32_t pitch_64 = ati_get_display_mode(dev)->pitch / 64;
     uint32_t red = 0x00ff0000;
     uint32_t green = 0x0000ff00;
     unsigned width = 32;
@@ -183,7 +183,7 @@ test_r100_host_data_32x32(ati_device_t *dev)
 bool
 test_r100_host_data_mono_is_bit_packed(ati_device_t *dev)
 {
-    uint32_t pitch_64 = (X_RES * BYPP) / 64;
+    uint32_t pitch_64 = ati_get_display_mode(dev)->pitch / 64;
     uint32_t red = 0x00ff0000;
     uint32_t green = 0x0000ff00;
     unsigned width = 2;
@@ -214,7 +214,7 @@ test_r100_host_data_mono_is_bit_packed(ati_device_t *dev)
 bool
 test_r100_host_data_morphos(ati_device_t *dev)
 {
-    uint32_t pitch_64 = (X_RES * BYPP) / 64;
+    uint32_t pitch_64 = ati_get_display_mode(dev)->pitch / 64;
 
     ati_screen_clear(dev, 0);
     // Adjusted from MorphOS output for 640x480 screen
@@ -320,11 +320,11 @@ do_clipping(ati_device_t *dev, int margin, int size, int border,
 void setup_draw_defaults(ati_device_t *dev) {
     static const uint32_t BORDER = 0x00cc3355;
     static const uint32_t TRIANGLE_FILL = 0x0055cc33;
-    uint32_t pitch_64 = (X_RES * BYPP) / 64;
+    uint32_t pitch_64 = ati_get_display_mode(dev)->pitch / 64;
 
     /* Common setup */
     wr_dst_offset(dev, 0x0);
-    wr_dst_pitch(dev, X_RES * BYPP);           /* 640 pixels / 8 = 80 = 0x50 */
+    wr_dst_pitch(dev, ati_get_display_mode(dev)->pitch); /* 640 pixels / 8 = 80 = 0x50 */
 
     wr_r100_dp_datatype(dev, 0x40000006);   /* 32bpp + LSB_TO_MSB byte order */
     wr_dp_mix(dev, 0xcc0300);          /* SRCCOPY + HOST_DATA source */
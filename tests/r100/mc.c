@@ -2,12 +2,15 @@
 #include "../test.h"
 #include "../../ati/r100_mc.h"
 
+// Shared by every device like gart_mem, so only written back to under the
+// GART claim
 static volatile uint32_t mem[1024] __attribute__((aligned(0x08000000)));
 
 bool
 test_r100_scratch_wb_to_pci_gart(ati_device_t *dev)
 {
     uint32_t gart_vm_start = ati_r100_init_pci_gart(dev);
+    ASSERT_NEQ(gart_vm_start, 0);
 
     // Enable scratch writeback
     wr_r100_scratch_addr(dev, gart_vm_start);
@@ -117,6 +120,7 @@ bool
 test_r100_scratch_wb_to_sys(ati_device_t *dev)
 {
     ati_r100_disable_pci_gart(dev);
+    ASSERT_TRUE(ati_r100_gart_claim(dev));
 
     // Framebuffer covers minimal memory space (4MB)
     // sys_addr is _far_ outside of this
@@ -1,6 +1,7 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 #include "../../ati/cce.h"
 #include "../../ati/r128_cce.h"
+#include "../../ati/r128_ring.h"
 #include "../test.h"
 
 bool test_cce(ati_device_t *dev) {
@@ -275,6 +276,88 @@ test_r128_pm4_microcode(ati_device_t *dev)
     return true;
 }
 
+// The ring and its writeback live in r128_gart_mem, which only has a bus
+// address under bare metal's identity mapping
+#ifdef PLATFORM_BAREMETAL
+bool
+test_r128_pm4_ring(ati_device_t *dev)
+{
+    ati_r128_ring_t ring;
+
+    wr_bios_0_scratch(dev, 0);
+    wr_bios_1_scratch(dev, 0);
+    wr_bios_2_scratch(dev, 0);
+
+    // 2^2 qwords, so a few packets are enough to wrap
+    ASSERT_TRUE(ati_r128_ring_init(dev, &ring, 2));
+    ASSERT_EQ(ring.size, 8);
+
+    // Three dwords each, so packets straddle the end and every commit needs
+    // a pad
+    for (uint32_t i = 0; i < 8; i++) {
+        uint32_t packets[] = {CCE_PKT0(BIOS_0_SCRATCH, 2), 0xcafe0000 | i,
+                              0xbeef0000 | i};
+        ASSERT_TRUE(ati_r128_ring_submit(&ring, packets, 3));
+    }
+    ASSERT_TRUE(ati_r128_ring_wait_idle(&ring));
+    ASSERT_EQ(rd_bios_0_scratch(dev), 0xcafe0007);
+    ASSERT_EQ(rd_bios_1_scratch(dev), 0xbeef0007);
+    ASSERT_EQ(ring.dwords, 32);
+    ASSERT_EQ(ring.wraps, 4);
+    ASSERT_EQ(ati_r128_ring_rptr(&ring), ring.wptr);
+
+    // One submission bigger than the ring is fed in as it drains
+    uint32_t stream[24];
+    for (uint32_t i = 0; i < 24; i += 2) {
+        stream[i] = CCE_PKT0(BIOS_2_SCRATCH, 1);
+        stream[i + 1] = 0x13370000 | i;
+    }
+    ASSERT_TRUE(ati_r128_ring_submit(&ring, stream, 24));
+    ASSERT_TRUE(ati_r128_ring_wait_idle(&ring));
+    ASSERT_EQ(rd_bios_2_scratch(dev), 0x13370016);
+    // At most 6 dwords fit at once
+    ASSERT_TRUE(ring.commits >= 8 + 4);
+
+    ati_r128_ring_fini(&ring);
+    return true;
+}
+#endif
+
+// A second init finds the microcode resident and skips the upload. The
+// engine reset, which stopping the CCE also does, forces a reload.
+bool
+test_r128_microcode_residency(ati_device_t *dev)
+{
+    ati_microcode_state_t *ucode = ati_device_microcode(dev);
+
+    ati_init_cce_engine(dev, R128_PM4_BUFFER_MODE_192PIO);
+    ASSERT_TRUE(ucode->valid);
+    uint32_t loads = ucode->loads;
+    uint32_t skips = ucode->skips;
+
+    ati_init_cce_engine(dev, R128_PM4_BUFFER_MODE_192PIO);
+    ASSERT_EQ(ucode->loads, loads);
+    ASSERT_EQ(ucode->skips, skips + 1);
+
+    // Still runs packets
+    uint32_t packet[] = {CCE_PKT0(BIOS_0_SCRATCH, 1), 0x600dc0de};
+    ati_send_packet(dev, packet, 2);
+    ati_cce_wait_for_idle(dev);
+    ASSERT_EQ(rd_bios_0_scratch(dev), 0x600dc0de);
+
+    ati_engine_reset(dev);
+    ASSERT_TRUE(!ucode->valid);
+    ati_init_cce_engine(dev, R128_PM4_BUFFER_MODE_192PIO);
+    ASSERT_EQ(ucode->loads, loads + 1);
+    ASSERT_EQ(ucode->skips, skips + 1);
+
+    // So the next test's init can't skip it either
+    ati_stop_cce_engine(dev);
+    ASSERT_TRUE(!ucode->valid);
+
+    return true;
+}
+
 void
 register_r128_cce_tests(void)
 {
@@ -283,4 +366,8 @@ register_r128_cce_tests(void)
     //REGISTER_TEST_FOR(test_cce_packet_submission, "cce packet submission", CHIP_R128);
     REGISTER_TEST_FOR(test_r128_pm4_microcode, "pm4 microcode", CHIP_R128);
     REGISTER_TEST_FOR(test_cce_mm_indirect, "cce MM_INDEX and MM_DATA", CHIP_R128);
+#ifdef PLATFORM_BAREMETAL
+    REGISTER_TEST_FOR(test_r128_pm4_ring, "pm4 ring buffer", CHIP_R128);
+#endif
+    REGISTER_TEST_FOR(test_r128_microcode_residency, "microcode residency", CHIP_R128);
 }
@@ -1,5 +1,6 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 #include "../../ati/ati.h"
+#include "../../ati/surface.h"
 #include "../test.h"
 
 // clang-format off
@@ -13,20 +14,36 @@
 #define GMC_BYTE_LSB_TO_MSB             0x00004000
 // clang-format on
 
-static void
+// Widest box draw_box can build
+#define DRAW_BOX_MAX 64
+
+// The box is built in an offscreen surface and blitted into place on the
+// screen, so every test drawing one also goes through the heap and the blit.
+// Fails on boxes wider than DRAW_BOX_MAX rather than drawing a smaller one.
+static bool
 draw_box(ati_device_t *dev, int size, int border, int x0, int y0)
 {
     static const uint32_t BORDER = 0x00cc3355;
     static const uint32_t TRIANGLE_FILL = 0x0055cc33;
     static const uint32_t BACKGROUND_FILL = 0x003355cc;
 
-    int bypp = 4;
-    int pitch = (rd_dst_pitch(dev) & 0x1ff) * 8 * bypp ;
     int marker_size = border;
     int marker_gap = border;
+    ati_surface_t screen = ati_screen_surface(dev);
+    ati_surface_t box;
+    // Each row is built in system RAM and uploaded as one transfer
+    uint32_t row[DRAW_BOX_MAX];
+    if (size > DRAW_BOX_MAX) {
+        printf("draw_box can't build a %dx%d box, only up to %dx%d\n", size,
+               size, DRAW_BOX_MAX, DRAW_BOX_MAX);
+        return false;
+    }
+    if (!ati_surface_alloc(dev, &box, size, size, 32)) {
+        printf("No VRAM left for a %dx%d box\n", size, size);
+        return false;
+    }
     for (int y = 0; y < size; y++) {
         for (int x = 0; x < size; x++) {
-            int offset = ((y0 + y) * pitch) + ((x0 + x) * sizeof(uint32_t));
             bool is_border = (y < border || y >= size - border ||
                               x < border || x >= size - border);
             bool is_triangle = x <= y;
@@ -35,12 +52,17 @@ draw_box(ati_device_t *dev, int size, int border, int x0, int y0)
                               x < size - border - marker_gap &&
                               y >= border + marker_gap &&
                               y < border + marker_size + marker_gap);
-            uint32_t pixel =  is_border                ? BORDER :
-                              is_triangle || is_marker ? TRIANGLE_FILL :
-                                                         BACKGROUND_FILL;
-            ati_vram_write(dev, offset, pixel);
+            row[x] =  is_border                ? BORDER :
+                      is_triangle || is_marker ? TRIANGLE_FILL :
+                                                 BACKGROUND_FILL;
         }
+        ati_vram_upload(dev, box.offset + y * box.pitch, row,
+                        size * sizeof(uint32_t));
     }
+
+    bool ok = ati_surface_blit(dev, &screen, x0, y0, &box, 0, 0, size, size);
+    ati_surface_free(dev, &box);
+    return ok;
 }
 
 bool
@@ -56,7 +78,7 @@ test_r128_rop3_16x16(ati_device_t *dev)
     wr_r128_default_offset(dev, 0x0);
     wr_r128_default_pitch(dev, 0x50);
 
-    draw_box(dev, size, border, 0, 0);
+    ASSERT_TRUE(draw_box(dev, size, border, 0, 0));
 
     wr_default_sc_bottom_right(dev, 0x1fff1fff);
     wr_dp_write_msk(dev, 0xffffffff);
@@ -91,7 +113,7 @@ test_r128_rop3_16x16_with_offset(ati_device_t *dev)
     wr_r128_src_pitch_offset(dev, 0x50 << 21);
     wr_r128_default_pitch(dev, 0x50);
 
-    draw_box(dev, size, border, 0, 0);
+    ASSERT_TRUE(draw_box(dev, size, border, 0, 0));
 
     wr_default_sc_bottom_right(dev, 0x1fff1fff);
     wr_dp_write_msk(dev, 0xffffffff);
@@ -130,7 +152,7 @@ test_r128_overlapping_mem_blit(ati_device_t *dev)
 
     // Left to right, top to bottom
     ati_screen_clear(dev, 0);
-    draw_box(dev, size, border, 0, 0);
+    ASSERT_TRUE(draw_box(dev, size, border, 0, 0));
     wr_dp_cntl(dev, 0x3);
     wr_src_x_y(dev, 0x0);
     wr_dst_x(dev, size / 2);
@@ -140,7 +162,7 @@ test_r128_overlapping_mem_blit(ati_device_t *dev)
 
     // Left to right, bottom to top
     ati_screen_clear(dev, 0);
-    draw_box(dev, size, border, 0, 0);
+    ASSERT_TRUE(draw_box(dev, size, border, 0, 0));
     wr_dp_cntl(dev, 0x1);
     wr_src_x_y(dev, size - 1);
     wr_dst_x(dev, size / 2);
@@ -150,7 +172,7 @@ test_r128_overlapping_mem_blit(ati_device_t *dev)
 
     // Right to left, bottom to top
     ati_screen_clear(dev, 0);
-    draw_box(dev, size, border, 0, 0);
+    ASSERT_TRUE(draw_box(dev, size, border, 0, 0));
     wr_dp_cntl(dev, 0x0);
     wr_src_x_y(dev, ((size - 1) << 16)| (size - 1));
     wr_dst_x(dev, (size / 2) + size);
@@ -160,7 +182,7 @@ test_r128_overlapping_mem_blit(ati_device_t *dev)
 
     // Right to left, top to bottom
     ati_screen_clear(dev, 0);
-    draw_box(dev, size, border, 0, 0);
+    ASSERT_TRUE(draw_box(dev, size, border, 0, 0));
     wr_dp_cntl(dev, 0x2);
     wr_src_x_y(dev, ((size - 1) << 16) | 0);
     wr_dst_x(dev, (size / 2) + size);
@@ -218,7 +240,7 @@ do_mem_clipping(ati_device_t *dev, int size, int border,
 
     /* Completely clipped — scissor far from destination */
     ati_screen_clear(dev, 0);
-    draw_box(dev, size, border, src_x, src_y);
+    ASSERT_TRUE(draw_box(dev, size, border, src_x, src_y));
     wr_sc_top_left(dev, ((bottom + 100) << 16) | (right + 100));
     wr_sc_bottom_right(dev, ((bottom + 200) << 16) | (right + 200));
     wr_src_x_y(dev, (sx << 16) | sy);
@@ -232,7 +254,7 @@ do_mem_clipping(ati_device_t *dev, int size, int border,
 
     for (int i = 0; i < (int)(sizeof(cases) / sizeof(cases[0])); i++) {
         ati_screen_clear(dev, 0);
-        draw_box(dev, size, border, src_x, src_y);
+        ASSERT_TRUE(draw_box(dev, size, border, src_x, src_y));
         wr_sc_top_left(dev, (cases[i].top << 16) | cases[i].left);
         wr_sc_bottom_right(dev, (cases[i].bottom << 16) | cases[i].right);
         wr_src_x_y(dev, (sx << 16) | sy);